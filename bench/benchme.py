@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""
+Standard performance benchmark suite.
+
+Each benchmark is a problem of the test suite, built in its own work directory and run at
+several grid sizes for a fixed number of cycles. The JSON performance reports of the runs
+(see the -perfreport command line option) are gathered in a single JSON file, which can be
+compared to a baseline produced in the same way to flag the performance regressions.
+
+Usage (from any directory, with IDEFIX_DIR set):
+  python3 $IDEFIX_DIR/bench/benchme.py [-only name ...] [-sizes 1 2] [-cycles n]
+                                       [-output file.json] [-baseline file.json]
+                                       [-haloexchange packed|datatype|shared]
+                                       [-tolerance 0.05] [configuration options of testme.py]
+"""
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+IDEFIX_DIR = os.getenv("IDEFIX_DIR", os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+os.environ["IDEFIX_DIR"] = IDEFIX_DIR
+sys.path.append(IDEFIX_DIR)
+
+import pytools.idfx_test as tst
+
+# name: (problem directory in test/, input file, grid scaling factors)
+BENCHMARKS = {
+  "HD_sod":                 ("HD/sod",                      "idefix.ini", [4, 16]),
+  "HD_KHI":                 ("HD/KHI",                      "idefix.ini", [0.5, 1, 2]),
+  "MHD_OrszagTang3D":       ("MHD/OrszagTang3D",            "idefix.ini", [1, 2, 4]),
+  "MHD_FargoSpherical":     ("MHD/FargoMHDSpherical",       "idefix.ini", [1, 2]),
+  "SG_UniformCollapse":     ("SelfGravity/UniformCollapse", "idefix.ini", [1, 4]),
+  "Dust_StreamingInstability": ("Dust/StreamingInstability", "idefix.ini", [1, 2, 4]),
+}
+
+def scaleGrid(inputFile, outputFile, factor, gridEntries={}):
+  """Copy an input file, multiplying the number of points of each non-degenerate grid patch,
+  and setting the given entries of the [Grid] section"""
+  with open(inputFile, "r") as f:
+    lines = f.readlines()
+  inGrid = False
+  with open(outputFile, "w") as f:
+    for line in lines:
+      words = line.split()
+      if line.strip().startswith("["):
+        inGrid = (line.strip() == "[Grid]")
+        if inGrid:
+          line = line+"".join("%s    %s\n"%(key, value) for key, value in gridEntries.items())
+      elif inGrid and len(words) > 0 and words[0] in gridEntries:
+        continue
+      elif inGrid and len(words) > 0 and words[0].endswith("-grid"):
+        # Xn-grid  nPatches  x0  (n  type  x1) for each patch
+        nPatches = int(words[1])
+        for p in range(nPatches):
+          n = int(words[3+3*p])
+          if n > 1:
+            words[3+3*p] = str(max(2, int(round(n*factor))))
+        line = "    ".join(words)+"\n"
+      f.write(line)
+
+def runBenchmark(test, name, cycles, sizes, workRoot, gridEntries):
+  problemDir, inputFile, defaultSizes = BENCHMARKS[name]
+  workDir = os.path.join(workRoot, name)
+  # Build out of the test directory, so that the test suite is left untouched
+  shutil.copytree(os.path.join(IDEFIX_DIR, "test", problemDir), workDir, dirs_exist_ok=True,
+                  ignore=shutil.ignore_patterns("*.vtk", "*.dmp", "*.log", "build", "python"))
+  os.chdir(workDir)
+  test.configure()
+  test.compile()
+
+  results = {}
+  for factor in (sizes if sizes else defaultSizes):
+    scaledInput = "bench-x%g.ini"%factor
+    report = "report-x%g.json"%factor
+    scaleGrid(inputFile, scaledInput, factor, gridEntries)
+    comm = ["./idefix", "-i", scaledInput, "-maxcycles", str(cycles), "-nowrite",
+            "-perfreport", report]
+    if test.mpi:
+      np = 1
+      for n in test.dec:
+        np = np*int(n)
+      comm = ["mpirun", "-np", str(max(np, 2))] + comm
+      if test.dec:
+        comm = comm + ["-dec"] + [str(n) for n in test.dec]
+    try:
+      subprocess.run(comm).check_returncode()
+    except subprocess.CalledProcessError as e:
+      print(tst.bcolors.FAIL+"Benchmark "+name+" failed at size x%g"%factor+tst.bcolors.ENDC)
+      raise e
+    with open(report, "r") as f:
+      results[name+"-x%g"%factor] = json.load(f)
+    print(tst.bcolors.OKCYAN+"%s x%g: %e cell updates/s"%(name, factor,
+          results[name+"-x%g"%factor]["metrics"]["cellUpdatesPerSecond"])+tst.bcolors.ENDC)
+  return(results)
+
+def compare(results, baseline, tolerance):
+  """Compare the cell updates/s to a baseline, return the number of regressions"""
+  regressions = 0
+  print("**************************************************************")
+  print("Comparison to the baseline (tolerance %g%%)"%(100*tolerance))
+  for key in sorted(results.keys()):
+    if key not in baseline:
+      print("%-40s no baseline"%key)
+      continue
+    new = results[key]["metrics"]["cellUpdatesPerSecond"]
+    ref = baseline[key]["metrics"]["cellUpdatesPerSecond"]
+    ratio = new/ref
+    status = tst.bcolors.OKGREEN+"ok"
+    if ratio < 1-tolerance:
+      status = tst.bcolors.FAIL+"REGRESSION"
+      regressions += 1
+      # Show the regions which slowed down the most
+      regions = results[key]["regions"]
+      refRegions = baseline[key]["regions"]
+      slower = [(regions[r]["avg"]/refRegions[r]["avg"], r) for r in regions
+                if r in refRegions and refRegions[r]["avg"] > 0]
+      for slowdown, r in sorted(slower, reverse=True)[:5]:
+        status += "\n    %.2fx slower: %s"%(slowdown, r)
+    elif ratio > 1+tolerance:
+      status = tst.bcolors.OKCYAN+"faster"
+    print("%-40s %.3e / %.3e cell updates/s (%+.1f%%) %s"%(key, new, ref, 100*(ratio-1), status)
+          +tst.bcolors.ENDC)
+  print("**************************************************************")
+  return(regressions)
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-only", nargs='+', default=[], help="Only run these benchmarks")
+parser.add_argument("-sizes", nargs='+', type=float, default=[],
+                    help="Grid scaling factors (default: those of each benchmark)")
+parser.add_argument("-cycles", type=int, default=100, help="Number of cycles of each run")
+parser.add_argument("-output", default="bench-results.json", help="JSON results file")
+parser.add_argument("-baseline", default="", help="JSON results file to compare to")
+parser.add_argument("-tolerance", type=float, default=0.05,
+                    help="Relative slowdown above which a benchmark is a regression")
+parser.add_argument("-haloexchange", default="", choices=["packed", "datatype", "shared"],
+                    help="MPI halo exchange ([Grid] haloExchange, default: that of each problem)")
+parser.add_argument("-workdir", default="", help="Work directory (default bench/work)")
+parser.add_argument("-list", action="store_true", help="List the benchmarks")
+args, unknown = parser.parse_known_args()
+
+if args.list:
+  for name, (problemDir, inputFile, sizes) in BENCHMARKS.items():
+    print("%-30s test/%s/%s, sizes x%s"%(name, problemDir, inputFile,
+                                        ", x".join("%g"%s for s in sizes)))
+  sys.exit(0)
+
+outputFile = os.path.abspath(args.output)
+baselineFile = os.path.abspath(args.baseline) if args.baseline else ""
+workRoot = os.path.abspath(args.workdir) if args.workdir else os.path.join(IDEFIX_DIR, "bench",
+                                                                           "work")
+test = tst.idfxTest()
+gridEntries = {"haloExchange": args.haloexchange} if args.haloexchange else {}
+
+results = {}
+for name in (args.only if args.only else BENCHMARKS.keys()):
+  if name not in BENCHMARKS:
+    raise Exception("Unknown benchmark "+name)
+  results.update(runBenchmark(test, name, args.cycles, args.sizes, workRoot, gridEntries))
+
+with open(outputFile, "w") as f:
+  json.dump(results, f, indent=2)
+print(tst.bcolors.OKGREEN+"Results written in "+outputFile+tst.bcolors.ENDC)
+
+if baselineFile:
+  with open(baselineFile, "r") as f:
+    baseline = json.load(f)
+  if compare(results, baseline, args.tolerance) > 0:
+    sys.exit(1)
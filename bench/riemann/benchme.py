@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""
+Micro-benchmark of the Riemann solvers and reconstruction schemes.
+
+Since the physics, the reconstruction, the loop pattern, the flux selection (with or without
+branches) and the layout of the arrays are chosen at compilation, the micro-benchmark (main.cpp)
+is built and run once for each of their combinations, each in its own work directory. The time
+per face and the achieved bandwidth of each solver are gathered in a single JSON file.
+
+Usage (with IDEFIX_DIR set):
+  python3 $IDEFIX_DIR/bench/riemann/benchme.py [-physics HD MHD]
+                     [-orders Constant Linear LimO3 Parabolic] [-patterns Default Range ...]
+                     [-variants Branching Branchless] [-layouts Default VariablesInner]
+                     [-output file.json] [configuration options of testme.py]
+"""
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+IDEFIX_DIR = os.getenv("IDEFIX_DIR", os.path.dirname(os.path.dirname(BENCH_DIR)))
+os.environ["IDEFIX_DIR"] = IDEFIX_DIR
+sys.path.append(IDEFIX_DIR)
+
+import pytools.idfx_test as tst
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-physics", nargs='+', default=["HD", "MHD"], choices=["HD", "MHD"])
+parser.add_argument("-orders", nargs='+', default=["Constant", "Linear", "LimO3", "Parabolic"],
+                    choices=["Constant", "Linear", "LimO3", "Parabolic"])
+parser.add_argument("-patterns", nargs='+', default=["Default"],
+                    choices=["Default", "SIMD", "Range", "MDRange", "TeamPolicy",
+                             "TeamPolicyInnerVector"])
+parser.add_argument("-variants", nargs='+', default=["Branching"],
+                    choices=["Branching", "Branchless"],
+                    help="Flux selection of the HLL-type solvers (Idefix_RIEMANN_BRANCHLESS)")
+parser.add_argument("-layouts", nargs='+', default=["Default"],
+                    choices=["Default", "VariablesInner"],
+                    help="Layout of the 4D arrays (Idefix_VARIABLES_INNERMOST)")
+parser.add_argument("-output", default="riemann-bench-results.json", help="JSON results file")
+parser.add_argument("-workdir", default="", help="Work directory (default bench/work/riemann)")
+args, unknown = parser.parse_known_args()
+
+outputFile = os.path.abspath(args.output)
+workRoot = os.path.abspath(args.workdir) if args.workdir else os.path.join(IDEFIX_DIR, "bench",
+                                                                           "work", "riemann")
+test = tst.idfxTest()
+# The reconstruction is set below, through the cmake options
+test.reconstruction = 0
+cmakeOptions = list(test.cmake)
+
+results = []
+for physics in args.physics:
+  for order in args.orders:
+    for pattern in args.patterns:
+      for variant in args.variants:
+        for layout in args.layouts:
+          name = physics+"-"+order+"-"+pattern+"-"+variant+"-"+layout
+          workDir = os.path.join(workRoot, name)
+          os.makedirs(workDir, exist_ok=True)
+          for f in ["CMakeLists.txt", "definitions.hpp", "idefix.ini", "main.cpp"]:
+            shutil.copy(os.path.join(BENCH_DIR, f), workDir)
+          os.chdir(workDir)
+          test.cmake = cmakeOptions + ["Idefix_MHD="+("ON" if physics == "MHD" else "OFF"),
+                                       "Idefix_RECONSTRUCTION="+order,
+                                       "Idefix_LOOP_PATTERN="+pattern,
+                                       "Idefix_RIEMANN_BRANCHLESS="
+                                       +("ON" if variant == "Branchless" else "OFF"),
+                                       "Idefix_VARIABLES_INNERMOST="
+                                       +("ON" if layout == "VariablesInner" else "OFF")]
+          test.configure()
+          test.compile()
+          comm = ["./idefix", "-nolog"]
+          if test.mpi:
+            comm = ["mpirun", "-np", "1"] + comm
+          try:
+            subprocess.run(comm).check_returncode()
+          except subprocess.CalledProcessError as e:
+            print(tst.bcolors.FAIL+"Micro-benchmark "+name+" failed"+tst.bcolors.ENDC)
+            raise e
+          with open("riemann-bench.json", "r") as f:
+            run = json.load(f)
+          for r in run["results"]:
+            r.update({"physics": physics, "reconstruction": order,
+                      "loopPattern": run["loopPattern"], "variant": variant, "layout": layout})
+            results.append(r)
+
+with open(outputFile, "w") as f:
+  json.dump(results, f, indent=2)
+
+# Summary: average time per face of each solver over the directions
+print("**************************************************************")
+print("%-10s %-10s %-22s %-10s %-14s %-10s %12s %10s"%("physics", "order", "loop pattern",
+                                                       "variant", "layout", "solver", "ns/face",
+                                                       "GB/s"))
+summary = {}
+for r in results:
+  key = (r["physics"], r["reconstruction"], r["loopPattern"], r["variant"], r["layout"],
+         r["fluid"]+":"+r["solver"])
+  summary.setdefault(key, []).append(r)
+for key, runs in summary.items():
+  ns = sum(r["nsPerFace"] for r in runs)/len(runs)
+  bw = sum(r["bandwidth"] for r in runs)/len(runs)
+  print("%-10s %-10s %-22s %-10s %-14s %-10s %12.3f %10.2f"%(key[0], key[1], key[2], key[3],
+                                                             key[4], key[5].split(":")[1], ns,
+                                                             bw))
+print("**************************************************************")
+print(tst.bcolors.OKGREEN+"Results written in "+outputFile+tst.bcolors.ENDC)
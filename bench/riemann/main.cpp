@@ -0,0 +1,219 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+// Micro-benchmark of the Riemann solvers (and of the reconstruction they include) on random
+// but physical states. The reconstruction order, the loop pattern, the branch-free flux
+// selection and the layout of the arrays are those of the build (see bench/riemann/benchme.py to
+// go through them).
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <Kokkos_Core.hpp>
+
+#include "idefix.hpp"
+#include "input.hpp"
+#include "grid.hpp"
+#include "gridHost.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+
+// Timing of a solver in one direction
+struct BenchResult {
+  std::string fluid;
+  std::string solver;
+  int dir;
+  double nsPerFace;
+  double bandwidth;               // GB/s, from the minimal traffic of the kernel
+};
+
+// Deterministic noise in [0,1[, which does not need a random number generator on the device
+KOKKOS_INLINE_FUNCTION real Noise(uint32_t seed, int n, int k, int j, int i) {
+  uint32_t h = seed ^ (n*0x9E3779B1u) ^ (k*0x85EBCA77u) ^ (j*0xC2B2AE3Du) ^ (i*0x27D4EB2Fu);
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 12;
+  h *= 0x297A2D39u;
+  h ^= h >> 15;
+  return(static_cast<real>(h / 4294967296.0));
+}
+
+// Random states: positive densities and pressures, velocities and fields in [-1,1]
+template<typename Phys>
+void FillStates(Fluid<Phys> *fluid, uint32_t seed) {
+  DataBlock *data = fluid->data;
+  IdefixArray4D<real> Vc = fluid->Vc;
+  idefix_for("Bench_FillVc",
+             0, Phys::nvar,
+             0, data->np_tot[KDIR],
+             0, data->np_tot[JDIR],
+             0, data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int n, int k, int j, int i) {
+      const real x = Noise(seed, n, k, j, i);
+      if(n == RHO || (Phys::pressure && n == PRS)) {
+        Vc(n,k,j,i) = 0.5 + 1.5*x;
+      } else {
+        Vc(n,k,j,i) = -1.0 + 2.0*x;
+      }
+    });
+  if constexpr(Phys::mhd) {
+    IdefixArray4D<real> Vs = fluid->Vs;
+    idefix_for("Bench_FillVs",
+               0, static_cast<int>(Vs.extent(0)),
+               0, static_cast<int>(Vs.extent(1)),
+               0, static_cast<int>(Vs.extent(2)),
+               0, static_cast<int>(Vs.extent(3)),
+      KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        Vs(n,k,j,i) = -1.0 + 2.0*Noise(seed+1, n, k, j, i);
+      });
+  }
+}
+
+template<typename Phys, int dir>
+void BenchDir(Fluid<Phys> *fluid, const std::string &fluidName, const int repeat,
+              std::vector<BenchResult> &results) {
+  DataBlock *data = fluid->data;
+  RiemannSolver<Phys> *rs = fluid->rSolver.get();
+  IdefixArray4D<real> flux = fluid->FluxRiemann;
+
+  double faces = 1;
+  for(int d = 0 ; d < 3 ; d++) {
+    faces *= data->end[d] - data->beg[d] + ((d == dir) ? 1 : 0);
+  }
+  // Each state is read and each flux is written once (the stencil is assumed to be in cache)
+  double bytes = idfx::BytesPerCell(fluid->Vc) + idfx::BytesPerCell(flux)
+                 + idfx::BytesPerCell(fluid->cMax);
+  if constexpr(Phys::mhd) bytes += idfx::BytesPerCell(fluid->Vs);
+
+  auto run = [&](const std::string &name, auto solve) {
+    solve();                      // warm up
+    Kokkos::fence();
+    Kokkos::Timer timer;
+    for(int n = 0 ; n < repeat ; n++) solve();
+    Kokkos::fence();
+    const double time = timer.seconds() / repeat;
+    results.push_back({fluidName, name, dir, 1e9*time/faces, bytes*faces/time/1e9});
+  };
+
+  if constexpr(Phys::dust) {
+    run("HllDust", [&]() { rs->template HllDust<dir>(flux); });
+  } else if constexpr(Phys::mhd) {
+    run("TvdlfMHD", [&]() { rs->template TvdlfMHD<dir>(flux); });
+    run("HllMHD", [&]() { rs->template HllMHD<dir>(flux); });
+    run("HlldMHD", [&]() { rs->template HlldMHD<dir>(flux); });
+    run("RoeMHD", [&]() { rs->template RoeMHD<dir>(flux); });
+  } else {
+    run("TvdlfHD", [&]() { rs->template TvdlfHD<dir>(flux); });
+    run("HllHD", [&]() { rs->template HllHD<dir>(flux); });
+    run("HllcHD", [&]() { rs->template HllcHD<dir>(flux); });
+    run("RoeHD", [&]() { rs->template RoeHD<dir>(flux); });
+  }
+}
+
+template<typename Phys>
+void BenchFluid(Fluid<Phys> *fluid, const std::string &fluidName, const int repeat,
+                std::vector<BenchResult> &results) {
+  FillStates(fluid, 12345);
+  BenchDir<Phys,IDIR>(fluid, fluidName, repeat, results);
+  #if DIMENSIONS >= 2
+    BenchDir<Phys,JDIR>(fluid, fluidName, repeat, results);
+  #endif
+  #if DIMENSIONS == 3
+    BenchDir<Phys,KDIR>(fluid, fluidName, repeat, results);
+  #endif
+}
+
+std::string LoopPatternName() {
+  #ifdef LOOP_PATTERN_AUTO
+    // The pattern is chosen at runtime for each kernel
+    if(idfx::loopTuner.enabled) return("Auto (tuned)");
+    return("Auto (" + idfx::LoopTuner::PatternName(idfx::defaultLoopPattern) + ")");
+  #else
+    return(idfx::LoopTuner::PatternName(defaultLoop));
+  #endif
+}
+
+int main( int argc, char* argv[] ) {
+  bool initKokkosBeforeMPI = false;
+
+  // When running on GPUS with Omnipath network,
+  // Kokkos needs to be initialised *before* the MPI layer
+#ifdef KOKKOS_ENABLE_CUDA
+  if(std::getenv("PSM2_CUDA") != NULL) {
+    initKokkosBeforeMPI = true;
+  }
+#endif
+
+  if(initKokkosBeforeMPI)  Kokkos::initialize( argc, argv );
+
+#ifdef WITH_MPI
+  MPI_Init(&argc,&argv);
+#endif
+
+  if(!initKokkosBeforeMPI) Kokkos::initialize( argc, argv );
+
+  {
+    idfx::initialize();
+    Input input(argc, argv);
+
+    Grid grid(input);
+    GridHost gridHost(grid);
+    gridHost.MakeGrid(input);
+    gridHost.SyncToDevice();
+    DataBlock data(grid, input);
+
+    const int repeat = input.GetOrSet<int>("Benchmark", "repeat", 0, 20);
+    const std::string loopPattern = LoopPatternName();
+    #ifdef VARIABLES_INNERMOST
+      const bool variablesInner = true;
+    #else
+      const bool variablesInner = false;
+    #endif
+
+    std::vector<BenchResult> results;
+    BenchFluid(data.hydro.get(), "Hydro", repeat, results);
+    if(data.haveDust) {
+      BenchFluid(data.dust[0].get(), "Dust", repeat, results);
+    }
+
+    idfx::cout << "Bench: reconstruction order " << ORDER << ", loop pattern " << loopPattern
+               << (riemannBranchless ? " (branch-free)" : "")
+               << (variablesInner ? ", variables innermost" : "") << ", " << data.np_int[IDIR]
+               << "x" << data.np_int[JDIR] << "x" << data.np_int[KDIR] << " cells per process."
+               << std::endl;
+    idfx::cout << "Bench: <fluid>  <solver>  <direction>  <ns/face>  <GB/s>" << std::endl;
+    for(auto &r : results) {
+      idfx::cout << "Bench: " << r.fluid << "  " << r.solver << "  " << r.dir << "  "
+                 << r.nsPerFace << "  " << r.bandwidth << std::endl;
+    }
+
+    // Machine-readable results, gathered by benchme.py
+    if(idfx::prank == 0) {
+      FILE *fp = std::fopen("riemann-bench.json", "w");
+      std::fprintf(fp, "{\n  \"order\": %d,\n  \"loopPattern\": \"%s\",\n  \"branchless\": %s,\n"
+                       "  \"variablesInnermost\": %s,\n  \"results\": [", ORDER,
+                   loopPattern.c_str(),
+                   riemannBranchless ? "true" : "false", variablesInner ? "true" : "false");
+      for(size_t n = 0 ; n < results.size() ; n++) {
+        std::fprintf(fp, "%s\n    {\"fluid\": \"%s\", \"solver\": \"%s\", \"dir\": %d, "
+                         "\"nsPerFace\": %g, \"bandwidth\": %g}", (n > 0) ? "," : "",
+                     results[n].fluid.c_str(), results[n].solver.c_str(), results[n].dir,
+                     results[n].nsPerFace, results[n].bandwidth);
+      }
+      std::fprintf(fp, "\n  ]\n}\n");
+      std::fclose(fp);
+    }
+  }
+  Kokkos::finalize();
+
+#ifdef WITH_MPI
+  MPI_Finalize();
+#endif
+
+  return(0);
+}
@@ -70,10 +70,26 @@ class idfxTest:
                         help="Enable single precision",
                         action="store_true")
 
+    parser.add_argument("-mixed",
+                        help="Enable mixed precision (single precision storage, double precision arithmetic)",
+                        action="store_true")
+
     parser.add_argument("-vectPot",
                         help="Enable vector potential formulation",
                         action="store_true")
 
+    parser.add_argument("-variablesInnermost",
+                        help="Store the variables innermost in the 4D device arrays",
+                        action="store_true")
+
+    parser.add_argument("-autotune",
+                        help="Choose the loop patterns at runtime, tuned on the first launches",
+                        action="store_true")
+
+    parser.add_argument("-branchless",
+                        help="Branch-free flux selection in the HLL-type Riemann solvers",
+                        action="store_true")
+
     parser.add_argument("-reconstruction",
                         type=int,
                         default=2,
@@ -135,7 +151,9 @@ class idfxTest:
       comm.append("-DIdefix_CXX_FLAGS=-ffp-contract=off")
 
     #if we use single precision
-    if(self.single):
+    if(self.mixed):
+      comm.append("-DIdefix_PRECISION=Mixed")
+    elif(self.single):
       comm.append("-DIdefix_PRECISION=Single")
     else:
       comm.append("-DIdefix_PRECISION=Double")
@@ -146,9 +164,25 @@ class idfxTest:
     else:
       comm.append("-DIdefix_EVOLVE_VECTOR_POTENTIAL=OFF")
 
+    if(self.variablesInnermost):
+      comm.append("-DIdefix_VARIABLES_INNERMOST=ON")
+    else:
+      comm.append("-DIdefix_VARIABLES_INNERMOST=OFF")
+
     if(self.Werror):
       comm.append("-DIdefix_WERROR=ON")
 
+    if(self.autotune):
+      comm.append("-DIdefix_LOOP_PATTERN=Auto")
+    elif not any(opt.startswith("Idefix_LOOP_PATTERN") for opt in self.cmake):
+      # reset the pattern cached by a previous configuration
+      comm.append("-DIdefix_LOOP_PATTERN=Default")
+
+    if(self.branchless):
+      comm.append("-DIdefix_RIEMANN_BRANCHLESS=ON")
+    else:
+      comm.append("-DIdefix_RIEMANN_BRANCHLESS=OFF")
+
     # add a definition file if provided
     if(definitionFile):
       self.definitions=definitionFile
@@ -189,7 +223,7 @@ class idfxTest:
         print("***************************************************"+bcolors.ENDC)
         raise e
 
-  def run(self, inputFile="", np=2, nowrite=False, restart=-1):
+  def run(self, inputFile="", np=2, nowrite=False, restart=-1, env=None):
       comm=["./idefix"]
       if inputFile:
           comm.append("-i")
@@ -214,12 +248,20 @@ class idfxTest:
       if self.Werror:
         comm.append("-Werror")
 
+      if self.autotune:
+        comm.append("-autotune")
+
       if restart>=0:
         comm.append("-restart")
         comm.append(str(restart))
 
+      runEnv=None
+      if env:
+        # extra environment variables for this run only
+        runEnv=dict(os.environ, **env)
+
       try:
-          make=subprocess.run(comm)
+          make=subprocess.run(comm, env=runEnv)
           make.check_returncode()
       except subprocess.CalledProcessError as e:
           print(bcolors.FAIL+"***************************************************")
@@ -237,9 +279,14 @@ class idfxTest:
     with open('./idefix.0.log','r') as file:
       log = file.read()
 
-    if "SINGLE PRECISION" in log:
+    if "MIXED PRECISION" in log:
+      self.mixed = True
+      self.single = False
+    elif "SINGLE PRECISION" in log:
+      self.mixed = False
       self.single = True
     else:
+      self.mixed = False
       self.single = False
 
     if "Kokkos CUDA target ENABLED" in log:
@@ -273,6 +320,49 @@ class idfxTest:
     line = re.search('Main: Perfs are (.*) cell', log)
     self.perf=float(line.group(1))
 
+  def checkDecomposition(self, expected):
+    # Check the MPI domain decomposition reported in the log of the last run
+    with open('./idefix.0.log','r') as file:
+      log = file.read()
+    line = re.search(r'Grid: MPI domain decomposition is \((.*)\)', log)
+    if line is None:
+      raise Exception("No MPI domain decomposition found in idefix.0.log")
+    decomp = [int(n) for n in line.group(1).split()]
+    assert decomp == expected, bcolors.FAIL+"Domain decomposition "+str(decomp)+ \
+                               " differs from the expected "+str(expected)+bcolors.ENDC
+    print(bcolors.OKGREEN+"Domain decomposition "+str(decomp)+" is the expected one"+bcolors.ENDC)
+    sys.stdout.flush()
+
+  def checkWeightedDecomposition(self, unevenDirections):
+    # Check that the weighted decomposition reported in the log of the last run gives subdomains
+    # of different widths in each of the given directions (0 for X1, 1 for X2, 2 for X3)
+    with open('./idefix.0.log','r') as file:
+      log = file.read()
+    if "Grid: weighted domain decomposition, subdomain widths are" not in log:
+      raise Exception("No weighted domain decomposition found in idefix.0.log")
+    widths = []
+    for line in re.findall(r'Direction X[123]:((?: \d+)+)\n', log):
+      widths.append([int(n) for n in line.split()])
+    for dir in unevenDirections:
+      assert len(set(widths[dir])) > 1, bcolors.FAIL+"Subdomain widths "+str(widths[dir])+ \
+                                        " are even in direction X"+str(dir+1)+bcolors.ENDC
+    print(bcolors.OKGREEN+"Subdomain widths "+str(widths)+" are uneven in the expected "
+          "directions"+bcolors.ENDC)
+    sys.stdout.flush()
+
+  def checkPlacement(self, expected):
+    # Check the block of subdomains held by each node reported in the log of the last run
+    with open('./idefix.0.log','r') as file:
+      log = file.read()
+    line = re.search(r'Grid: node-aware rank placement, each node holds \((.*)\) subdomains', log)
+    if line is None:
+      raise Exception("No node-aware rank placement found in idefix.0.log")
+    block = [int(n) for n in line.group(1).split()]
+    assert block == expected, bcolors.FAIL+"Node block "+str(block)+ \
+                              " differs from the expected "+str(expected)+bcolors.ENDC
+    print(bcolors.OKGREEN+"Node block "+str(block)+" is the expected one"+bcolors.ENDC)
+    sys.stdout.flush()
+
   def checkOnly(self, filename, tolerance=0):
     # Assumes the code has been run manually using some configuration, so we simply
     # do the test suite witout configure/compile/run
@@ -348,6 +438,10 @@ class idfxTest:
 
   def makeReference(self,filename):
     self._readLog()
+    if self.mixed:
+      # Mixed precision runs are validated against the double precision references
+      print(bcolors.WARNING+"Mixed precision: reference creation skipped"+bcolors.ENDC)
+      return
     targetDir = os.path.join(self.referenceDirectory,self.testDir)
     if not os.path.exists(targetDir):
       print("Creating reference directory")
@@ -372,7 +466,9 @@ class idfxTest:
     print("CMake Opts: " +" ".join(self.cmake))
     print("Definitions file:"+self.definitions)
     print("Input File: "+self.inifile)
-    if(self.single):
+    if(self.mixed):
+      print("Precision: Mixed")
+    elif(self.single):
       print("Precision: Single")
     else:
       print("Precision: Double")
@@ -400,8 +496,9 @@ class idfxTest:
     if self.reconstruction == 4:
       strReconstruction= "ppm"
 
+    # Mixed precision is validated against the double precision references
     strPrecision="double"
-    if self.single:
+    if self.single and not self.mixed:
       strPrecision="single"
 
     fileref='dump.ref.'+strPrecision+"."+strReconstruction+"."+self.inifile
@@ -9,6 +9,15 @@
 #define ARRAYS_HPP_
 
 #include "idefix.hpp"
+
+// Layout of the 4D device arrays (n,k,j,i). With VARIABLES_INNERMOST, the variables of each cell
+// are contiguous in memory (n is the innermost index), which the (n,k,j,i) accessors hide.
+#ifdef VARIABLES_INNERMOST
+  using Layout4D = Kokkos::LayoutStride;
+#else
+  using Layout4D = Layout;
+#endif
+
 template <typename T> using IdefixArray1D =
                             Kokkos::View<T*, Layout, Device>;
 template <typename T> using IdefixArray2D =
@@ -16,7 +25,7 @@ template <typename T> using IdefixArray2D =
 template <typename T> using IdefixArray3D =
                             Kokkos::View<T***, Layout, Device>;
 template <typename T> using IdefixArray4D =
-                            Kokkos::View<T****, Layout, Device>;
+                            Kokkos::View<T****, Layout4D, Device>;
 
 template <typename T> using IdefixHostArray1D =
                             Kokkos::View<T*, Kokkos::LayoutRight, Kokkos::HostSpace>;
@@ -37,6 +46,22 @@ template <typename T> using IdefixAtomicArray2D =
 template <typename T> using IdefixAtomicArray3D =
                             Kokkos::View<T***, Layout, Device,
                                          Kokkos::MemoryTraits<Kokkos::Atomic>>;
+namespace idfx {
+// Layout of a 4D device array of nv variables on a nk*nj*ni grid. The arrays which are sliced into
+// 3D arrays along their first index, or wrap a 3D array, keep it outermost (variablesInner=false).
+inline Layout4D ArrayLayout4D(size_t nv, size_t nk, size_t nj, size_t ni,
+                              [[maybe_unused]] bool variablesInner = true) {
+  #ifdef VARIABLES_INNERMOST
+    if(variablesInner) {
+      return(Kokkos::LayoutStride(nv, 1, nk, nj*ni*nv, nj, ni*nv, ni, nv));
+    }
+    return(Kokkos::LayoutStride(nv, nk*nj*ni, nk, nj*ni, nj, ni, ni, 1));
+  #else
+    return(Layout(nv, nk, nj, ni));
+  #endif
+}
+} // namespace idfx
+
 /*
 template <typename T> using IdefixHostArray1D = Kokkos::View<T*, Layout, Host>;
 template <typename T> using IdefixHostArray2D = Kokkos::View<T**, Layout, Host>;
@@ -6,6 +6,8 @@
 // ***********************************************************************************
 
 
+#include <array>
+
 #include "../idefix.hpp"
 #include "dataBlock.hpp"
 #include "dataBlockHost.hpp"
@@ -23,11 +25,142 @@ void DataBlock::Coarsen() {
   #endif
 }
 
+// Cell size along each direction, using the same metric terms as the CFL condition
+struct CoarseningCellSize {
+  explicit CoarseningCellSize(DataBlock *data) : dx1{data->dx[IDIR]},
+                                                 dx2{data->dx[JDIR]},
+                                                 dx3{data->dx[KDIR]},
+                                                 x1{data->x[IDIR]},
+                                                 rt{data->rt},
+                                                 dmu{data->dmu} {}
+
+  // Ratio between the cell size along dir and the coordinate width dx[dir]
+  KOKKOS_INLINE_FUNCTION real Metric(const int dir, const int j, const int i) const {
+    real metric = ONE_F;
+    #if GEOMETRY == POLAR
+      if(dir == JDIR) metric = x1(i);
+    #elif GEOMETRY == SPHERICAL
+      if(dir == JDIR) metric = rt(i);
+      if(dir == KDIR) metric = rt(i)*dmu(j)/dx2(j);
+    #endif
+    return(metric);
+  }
+
+  KOKKOS_INLINE_FUNCTION real operator()(const int dir, const int k,
+                                         const int j, const int i) const {
+    real dl = (dir == IDIR) ? dx1(i) : ( (dir == JDIR) ? dx2(j) : dx3(k) );
+    return(dl*Metric(dir, j, i));
+  }
+
+  IdefixArray1D<real> dx1, dx2, dx3;
+  IdefixArray1D<real> x1;
+  IdefixArray1D<real> rt;
+  IdefixArray1D<real> dmu;
+};
+
+// Smallest effective cell size of the active domain (all processes), taking the coarsening
+// levels into account when required
+static real MinCellSize(DataBlock *data, const CoarseningCellSize &cellSize, bool coarsened) {
+  std::array<bool,3> isCoarsened = {false, false, false};
+  if(coarsened) isCoarsened = data->coarseningDirection;
+  IdefixArray2D<int> level1 = data->coarseningLevel[IDIR];
+  [[maybe_unused]] IdefixArray2D<int> level2 = data->coarseningLevel[JDIR];
+  [[maybe_unused]] IdefixArray2D<int> level3 = data->coarseningLevel[KDIR];
+  const bool coarsen1 = isCoarsened[IDIR];
+  [[maybe_unused]] const bool coarsen2 = isCoarsened[JDIR];
+  [[maybe_unused]] const bool coarsen3 = isCoarsened[KDIR];
+
+  real dlmin;
+  idefix_reduce("MinCellSize",
+    data->beg[KDIR], data->end[KDIR],
+    data->beg[JDIR], data->end[JDIR],
+    data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i, real &dlLocal) {
+      real dl1 = cellSize(IDIR, k, j, i);
+      if(coarsen1) dl1 *= 1 << (level1(k,j) - 1);
+      dlLocal = FMIN(dl1, dlLocal);
+      #if DIMENSIONS >= 2
+        real dl2 = cellSize(JDIR, k, j, i);
+        if(coarsen2) dl2 *= 1 << (level2(k,i) - 1);
+        dlLocal = FMIN(dl2, dlLocal);
+      #endif
+      #if DIMENSIONS == 3
+        real dl3 = cellSize(KDIR, k, j, i);
+        if(coarsen3) dl3 *= 1 << (level3(j,i) - 1);
+        dlLocal = FMIN(dl3, dlLocal);
+      #endif
+    },
+    Kokkos::Min<real>(dlmin));
+
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &dlmin, 1, realMPI, MPI_MIN, MPI_COMM_WORLD));
+  #endif
+  return(dlmin);
+}
+
+// Derive static coarsening levels from the grid metrics, so that the effective cell size in each
+// coarsened direction reaches a target size (or a fraction of it given by a target dt gain)
+void DataBlock::ComputeAutoCoarseningLevels() {
+  idfx::pushRegion("DataBlock::ComputeAutoCoarseningLevels");
+  CoarseningCellSize cellSize(this);
+
+  const real dlmin0 = MinCellSize(this, cellSize, false);
+  real target = mygrid->coarseningTargetSize;
+  if(mygrid->coarseningTargetGain > ZERO_F) target = mygrid->coarseningTargetGain*dlmin0;
+
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(!coarseningDirection[dir]) continue;
+
+    // Groups should divide the subdomains of every process
+    int maxLevel = 1;
+    while(np_int[dir] % (1 << maxLevel) == 0) maxLevel++;
+    #ifdef WITH_MPI
+      MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &maxLevel, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD));
+    #endif
+    autoCoarseningMaxLevel[dir] = maxLevel;
+
+    // Since the level may not change along dir, it follows the smallest width along dir
+    IdefixArray1D<real> dxDir = this->dx[dir];
+    real dxmin;
+    idefix_reduce("MinWidth", beg[dir], end[dir],
+      KOKKOS_LAMBDA (int n, real &dxLocal) {
+        dxLocal = FMIN(dxDir(n), dxLocal);
+      },
+      Kokkos::Min<real>(dxmin));
+    #ifdef WITH_MPI
+      MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &dxmin, 1, realMPI, MPI_MIN, MPI_COMM_WORLD));
+    #endif
+
+    IdefixArray2D<int> level = coarseningLevel[dir];
+    const int Xt = (dir == IDIR ? JDIR : IDIR);
+    const int Xb = (dir == KDIR ? JDIR : KDIR);
+    idefix_for("AutoCoarseningLevels", 0, np_tot[Xb], 0, np_tot[Xt],
+      KOKKOS_LAMBDA (int b, int t) {
+        // Transverse indices
+        const int j = (dir == JDIR) ? 0 : ( (dir == IDIR) ? t : b);
+        const int i = (dir == IDIR) ? 0 : t;
+        const real dl = dxmin*cellSize.Metric(dir, j, i);
+        int lev = 1;
+        while((1 << (lev-1))*dl < target && lev < maxLevel) lev++;
+        level(b,t) = lev;
+      });
+  }
+
+  CheckCoarseningLevels();
+  autoCoarseningGain = MinCellSize(this, cellSize, true)/dlmin0;
+
+  idfx::popRegion();
+}
+
 void DataBlock::EnrollGridCoarseningLevels(GridCoarseningFunc func) {
   if(!haveGridCoarsening) {
     IDEFIX_WARNING("DataBlock:EnrollCoarseningLevels was called but grid "
                     "coarsening is not enabled.");
   }
+  if(haveGridCoarsening == GridCoarsening::automatic) {
+    IDEFIX_WARNING("DataBlock:EnrollCoarseningLevels was called but automatic grid "
+                    "coarsening is enabled. The enrolled function will be ignored.");
+  }
   this->gridCoarseningFunc = func;
 }
 
@@ -38,6 +171,11 @@ void DataBlock::ComputeGridCoarseningLevels() {
     IDEFIX_ERROR("Dynamic grid Coarsening is enabled, "
                  "but no function has been enrolled to compute coarsening levels");
   }
+  // Automatic levels are computed once from the grid metrics
+  if(haveGridCoarsening == GridCoarsening::automatic) {
+    idfx::popRegion();
+    return;
+  }
   // if grid coarsening is enabled(=static), we compute the levels once
   // levels can be either initialised with the initial conditions, or with a dedicated
   // Coarsening function (if Enrollment has been called)
@@ -32,9 +32,8 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   // Get the number of points from the parent grid object
   for(int dir = 0 ; dir < 3 ; dir++) {
     nghost[dir] = grid.nghost[dir];
-    // Domain decomposition: decompose the full domain size in grid by the number of processes
-    // in that direction
-    np_int[dir] = grid.np_int[dir]/grid.nproc[dir];
+    // Domain decomposition: extent of the subdomain of the current process in that direction
+    np_int[dir] = grid.procBeg[dir][grid.xproc[dir]+1] - grid.procBeg[dir][grid.xproc[dir]];
     np_tot[dir] = np_int[dir]+2*nghost[dir];
 
     // Boundary conditions
@@ -56,9 +55,8 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
     end[dir] = grid.nghost[dir]+np_int[dir];
 
     // Where does this datablock starts and end in the grid?
-    // This assumes even distribution of points between procs
-    gbeg[dir] = grid.nghost[dir] + grid.xproc[dir]*np_int[dir];
-    gend[dir] = grid.nghost[dir] + (grid.xproc[dir]+1)*np_int[dir];
+    gbeg[dir] = grid.nghost[dir] + grid.procBeg[dir][grid.xproc[dir]];
+    gend[dir] = gbeg[dir] + np_int[dir];
 
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
@@ -148,6 +146,14 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   if(input.CheckBlock("Dust")) {
     haveDust = true;
     int nSpecies = input.Get<int>("Dust","nSpecies",0);
+    // The batch is created first since the species are views of its arrays
+    if(input.GetOrSet<bool>("Dust","batched",0,false)) {
+      dustBatch = std::make_unique<DustBatch>(input, this, nSpecies);
+    }
+    // The species keep a copy of the mask, which should hence be created before them
+    if(input.CheckEntry("Dust","mask_threshold")>=0) {
+      dustMask = std::make_unique<DustMask>(input, this, nSpecies);
+    }
     for(int i = 0 ; i < nSpecies ; i++) {
       dust.emplace_back(std::make_unique<Fluid<DustPhysics>>(grid, input, this, i));
     }
@@ -177,9 +183,8 @@ DataBlock::DataBlock(SubGrid *subgrid) {
   // Get the number of points from the parent grid object
   for(int dir = 0 ; dir < 3 ; dir++) {
     nghost[dir] = grid->nghost[dir];
-    // Domain decomposition: decompose the full domain size in grid by the number of processes
-    // in that direction
-    np_int[dir] = grid->np_int[dir]/grid->nproc[dir];
+    // Domain decomposition: extent of the subdomain of the current process in that direction
+    np_int[dir] = grid->procBeg[dir][grid->xproc[dir]+1] - grid->procBeg[dir][grid->xproc[dir]];
     np_tot[dir] = np_int[dir]+2*nghost[dir];
 
     // Boundary conditions
@@ -201,9 +206,8 @@ DataBlock::DataBlock(SubGrid *subgrid) {
     end[dir] = grid->nghost[dir]+np_int[dir];
 
     // Where does this datablock starts and end in the grid?
-    // This assumes even distribution of points between procs
-    gbeg[dir] = grid->nghost[dir] + grid->xproc[dir]*np_int[dir];
-    gend[dir] = grid->nghost[dir] + (grid->xproc[dir]+1)*np_int[dir];
+    gbeg[dir] = grid->nghost[dir] + grid->procBeg[dir][grid->xproc[dir]];
+    gend[dir] = gbeg[dir] + np_int[dir];
 
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
@@ -252,7 +256,9 @@ DataBlock::DataBlock(SubGrid *subgrid) {
 
 void DataBlock::ResetStage() {
   this->hydro->ResetStage();
-  if(haveDust) {
+  if(dustBatch) {
+    dustBatch->ResetStage();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ResetStage();
     }
@@ -261,7 +267,9 @@ void DataBlock::ResetStage() {
 
 void DataBlock::ConsToPrim() {
   this->hydro->ConvertConsToPrim();
-  if(haveDust) {
+  if(dustBatch) {
+    dustBatch->ConvertConsToPrim();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ConvertConsToPrim();
     }
@@ -270,13 +278,37 @@ void DataBlock::ConsToPrim() {
 
 void DataBlock::PrimToCons() {
   this->hydro->ConvertPrimToCons();
-  if(haveDust) {
+  if(dustBatch) {
+    dustBatch->ConvertPrimToCons();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ConvertPrimToCons();
     }
   }
 }
 
+void DataBlock::ConsToPrim(const real wc, const real w0, StateContainer &stored) {
+  this->hydro->ConvertConsToPrim(wc, w0, stored);
+  if(dustBatch) {
+    dustBatch->ConvertConsToPrim(wc, w0, stored);
+  } else if(haveDust) {
+    for(int i = 0 ; i < dust.size() ; i++) {
+      dust[i]->ConvertConsToPrim(wc, w0, stored);
+    }
+  }
+}
+
+void DataBlock::PrimToCons(StateContainer &stored) {
+  this->hydro->ConvertPrimToCons(stored);
+  if(dustBatch) {
+    dustBatch->ConvertPrimToCons(stored);
+  } else if(haveDust) {
+    for(int i = 0 ; i < dust.size() ; i++) {
+      dust[i]->ConvertPrimToCons(stored);
+    }
+  }
+}
+
 // Set the boundaries of the data structures in this datablock
 void DataBlock::SetBoundaries() {
   if(haveGridCoarsening) {
@@ -310,6 +342,22 @@ void DataBlock::ShowConfig() {
         << "...." << xend[dir] << std::endl;
     }
   }
+  if(haveGridCoarsening == GridCoarsening::automatic) {
+    idfx::cout << "DataBlock: automatic grid coarsening with maximum level";
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      if(coarseningDirection[dir]) {
+        idfx::cout << " " << autoCoarseningMaxLevel[dir] << " (X" << dir+1 << ")";
+      }
+    }
+    idfx::cout << "." << std::endl;
+    idfx::cout << "DataBlock: estimated timestep gain from the smallest cell size x"
+               << autoCoarseningGain << "." << std::endl;
+    if(mygrid->coarseningTargetGain > autoCoarseningGain) {
+      IDEFIX_WARNING("The target timestep gain of automatic grid coarsening cannot be reached: "
+                     "either the subdomains are too small or the non-coarsened directions "
+                     "limit the timestep.");
+    }
+  }
   hydro->ShowConfig();
   if(haveFargo) fargo->ShowConfig();
   if(haveplanetarySystem) planetarySystem->ShowConfig();
@@ -322,6 +370,8 @@ void DataBlock::ShowConfig() {
     idfx::cout << "DataBlock: evolving " << dust.size() << " dust species." << std::endl;
     // Only show the config the first dust specie
     dust[0]->ShowConfig();
+    if(dustBatch) dustBatch->ShowConfig();
+    if(dustMask) dustMask->ShowConfig();
     /*
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ShowConfig();
@@ -344,7 +394,9 @@ real DataBlock::ComputeTimestep() {
                   dtmin=FMIN(ONE_F/InvDt(k,j,i),dtmin);
               },
           Kokkos::Min<real>(dt));
-  if(haveDust) {
+  if(dustBatch) {
+    dt = std::min(dt,dustBatch->ComputeTimestep());
+  } else if(haveDust) {
     for(int n = 0 ; n < dust.size() ; n++) {
       real dtDust;
       auto InvDt = dust[n]->InvDt;
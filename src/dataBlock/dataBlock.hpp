@@ -20,6 +20,8 @@
 #include "planetarySystem.hpp"
 #include "gravity.hpp"
 #include "stateContainer.hpp"
+#include "dustBatch.hpp"
+#include "dustMask.hpp"
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 /// The DataBlock class is designed to store the data and child class instances that belongs to the
@@ -104,7 +106,7 @@ class DataBlock {
   std::array<int,3> gend;      ///< Last global index of the active domain of this datablock
 
   real dt;                     ///< Current timestep
-  real t;                      ///< Current time
+  realc t;                     ///< Current time
 
   Grid *mygrid;                ///< Parent grid object
 
@@ -115,6 +117,8 @@ class DataBlock {
   std::unique_ptr<Fluid<DefaultPhysics>> hydro;   ///< The Hydro object attached to this datablock
   bool haveDust{false};
   std::vector<std::unique_ptr<Fluid<DustPhysics>>> dust; ///< Holder for zero pressure dust fluid
+  std::unique_ptr<DustBatch> dustBatch; ///< Species-batched dust storage (when enabled)
+  std::unique_ptr<DustMask> dustMask;   ///< Active regions of the dust species (when enabled)
 
   std::unique_ptr<Vtk> vtk;
   std::unique_ptr<Dump> dump;
@@ -138,12 +142,18 @@ class DataBlock {
 
 
   bool rklCycle{false};           ///<  // Set to true when we're inside a RKL call
+  bool hallCycle{false};          ///<  // Set to true when we're inside a Hall sub-cycle
 
-  void EvolveStage();             ///< Evolve this DataBlock by dt
+  void EvolveStage(const real);   ///< Evolve this DataBlock by one stage of given step
   void EvolveRKLStage();          ///< Evolve this DataBlock by dt for terms impacted by RKL
+  void EvolveImplicitStage();     ///< Evolve this DataBlock by dt for implicit parabolic terms
+  void EvolveHallStage();         ///< Evolve this DataBlock by dt for the sub-cycled Hall effect
   void SetBoundaries();       ///< Enforce boundary conditions to this datablock
   void ConsToPrim();       ///< Convert conservative to primitive variables
+  void ConsToPrim(const real, const real, StateContainer &); ///< Same, after combining the
+                                                             ///< current state with a stored one
   void PrimToCons();       ///< Convert primitive to conservative variables
+  void PrimToCons(StateContainer &); ///< Same, and store the result in the given state
   void DeriveVectorPotential(); ///< Compute magnetic fields from vector potential where applicable
   void Coarsen();             ///< Coarsen this datablock and its objects
   void ShowConfig();              ///< Show the datablock's configuration
@@ -173,6 +183,9 @@ class DataBlock {
  private:
   void WriteVariable(FILE* , int , int *, char *, void*);
   void ComputeGridCoarseningLevels();   ///< Call user defined function to define Coarsening levels
+  void ComputeAutoCoarseningLevels();   ///< Derive static coarsening levels from the grid metrics
+  real autoCoarseningGain{1};           ///< Estimated dt gain of the automatic coarsening levels
+  std::array<int,3> autoCoarseningMaxLevel{1, 1, 1}; ///< Largest level allowed by the subdomains
 
   // User Steps (either before or after the main integration loop)
   bool haveUserStepFirst{false};
@@ -48,18 +48,18 @@ DataBlockHost::DataBlockHost(DataBlock& datain) {
     // TO BE COMPLETED...
 
   dV = Kokkos::create_mirror_view(data->dV);
-  Vc = Kokkos::create_mirror_view(data->hydro->Vc);
-  Uc = Kokkos::create_mirror_view(data->hydro->Uc);
+  Vc = idfx::CreateHostArray(data->hydro->Vc);
+  Uc = idfx::CreateHostArray(data->hydro->Uc);
   InvDt = Kokkos::create_mirror_view(data->hydro->InvDt);
 
 #if MHD == YES
-  Vs = Kokkos::create_mirror_view(data->hydro->Vs);
+  Vs = idfx::CreateHostArray(data->hydro->Vs);
   this->haveCurrent = data->hydro->haveCurrent;
   if(data->hydro->haveCurrent) {
-    J = Kokkos::create_mirror_view(data->hydro->J);
+    J = idfx::CreateHostArray(data->hydro->J);
   }
   #ifdef EVOLVE_VECTOR_POTENTIAL
-    Ve = Kokkos::create_mirror_view(data->hydro->Ve);
+    Ve = idfx::CreateHostArray(data->hydro->Ve);
   #endif
 
   D_EXPAND( Ex3 = Kokkos::create_mirror_view(data->hydro->emf->ez);  ,
@@ -70,7 +70,7 @@ DataBlockHost::DataBlockHost(DataBlock& datain) {
   if(haveDust) {
     dustVc = std::vector<IdefixHostArray4D<real>>(data->dust.size());
     for(int i = 0 ; i < data->dust.size() ; i++) {
-      dustVc[i] = Kokkos::create_mirror_view(data->dust[i]->Vc);
+      dustVc[i] = idfx::CreateHostArray(data->dust[i]->Vc);
     }
   }
 
@@ -110,14 +110,14 @@ void DataBlockHost::SyncToDevice() {
 
   data->t = this->t;
   data->dt = this->dt;
-  Kokkos::deep_copy(data->hydro->Vc,Vc);
+  idfx::DeepCopy(data->hydro->Vc,Vc);
   Kokkos::deep_copy(data->hydro->InvDt,InvDt);
 
 #if MHD == YES
-  Kokkos::deep_copy(data->hydro->Vs,Vs);
-  if(this->haveCurrent && data->hydro->haveCurrent) Kokkos::deep_copy(data->hydro->J,J);
+  idfx::DeepCopy(data->hydro->Vs,Vs);
+  if(this->haveCurrent && data->hydro->haveCurrent) idfx::DeepCopy(data->hydro->J,J);
   #ifdef EVOLVE_VECTOR_POTENTIAL
-    Kokkos::deep_copy(data->hydro->Ve,Ve);
+    idfx::DeepCopy(data->hydro->Ve,Ve);
   #endif
 
   D_EXPAND( Kokkos::deep_copy(data->hydro->emf->ez,Ex3);  ,
@@ -127,11 +127,11 @@ void DataBlockHost::SyncToDevice() {
 #endif
   if(haveDust) {
     for(int i = 0 ; i < dustVc.size() ; i++) {
-      Kokkos::deep_copy(data->dust[i]->Vc, dustVc[i]);
+      idfx::DeepCopy(data->dust[i]->Vc, dustVc[i]);
     }
   }
 
-  Kokkos::deep_copy(data->hydro->Uc,Uc);
+  idfx::DeepCopy(data->hydro->Uc,Uc);
 
   if(haveGridCoarsening) {
     for(int dir = 0 ; dir < 3 ; dir++) {
@@ -149,14 +149,14 @@ void DataBlockHost::SyncFromDevice() {
   this->t = data->t;
   this->dt = data->dt;
 
-  Kokkos::deep_copy(Vc,data->hydro->Vc);
+  idfx::DeepCopy(Vc,data->hydro->Vc);
   Kokkos::deep_copy(InvDt,data->hydro->InvDt);
 
 #if MHD == YES
-  Kokkos::deep_copy(Vs,data->hydro->Vs);
-  if(this->haveCurrent && data->hydro->haveCurrent) Kokkos::deep_copy(J,data->hydro->J);
+  idfx::DeepCopy(Vs,data->hydro->Vs);
+  if(this->haveCurrent && data->hydro->haveCurrent) idfx::DeepCopy(J,data->hydro->J);
   #ifdef EVOLVE_VECTOR_POTENTIAL
-    Kokkos::deep_copy(Ve,data->hydro->Ve);
+    idfx::DeepCopy(Ve,data->hydro->Ve);
   #endif
   D_EXPAND( Kokkos::deep_copy(Ex3,data->hydro->emf->ez);  ,
                                                   ,
@@ -164,11 +164,11 @@ void DataBlockHost::SyncFromDevice() {
             Kokkos::deep_copy(Ex2,data->hydro->emf->ey);  )
 #endif
 
-  Kokkos::deep_copy(Uc,data->hydro->Uc);
+  idfx::DeepCopy(Uc,data->hydro->Uc);
 
   if(haveDust) {
     for(int i = 0 ; i < dustVc.size() ; i++) {
-      Kokkos::deep_copy(dustVc[i], data->dust[i]->Vc);
+      idfx::DeepCopy(dustVc[i], data->dust[i]->Vc);
     }
   }
 
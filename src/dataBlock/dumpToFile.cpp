@@ -50,10 +50,10 @@ void DataBlock::DumpToFile(std::string filebase)  {
 #if MHD == YES
 
 
-  IdefixArray4D<real>::HostMirror locJ;
+  IdefixHostArray4D<real> locJ;
   if(hydro->haveCurrent) {
-    locJ = Kokkos::create_mirror_view(this->hydro->J);
-    Kokkos::deep_copy(locJ, this->hydro->J);
+    locJ = idfx::CreateHostArray(this->hydro->J);
+    idfx::DeepCopy(locJ, this->hydro->J);
   }
 #endif
 
@@ -81,8 +81,8 @@ void DataBlock::DumpToFile(std::string filebase)  {
   fwrite (header, sizeof(char), HEADERSIZE, fileHdl);
 
   // Write Vc
-  IdefixArray4D<real>::HostMirror locVc = Kokkos::create_mirror_view(this->hydro->Vc);
-  Kokkos::deep_copy(locVc,this->hydro->Vc);
+  IdefixHostArray4D<real> locVc = idfx::CreateHostArray(this->hydro->Vc);
+  idfx::DeepCopy(locVc, this->hydro->Vc);
   dims[0] = this->np_tot[IDIR];
   dims[1] = this->np_tot[JDIR];
   dims[2] = this->np_tot[KDIR];
@@ -120,8 +120,8 @@ void DataBlock::DumpToFile(std::string filebase)  {
   // Write Vs
 #if MHD == YES
   // Write Vs
-  IdefixArray4D<real>::HostMirror locVs = Kokkos::create_mirror_view(this->hydro->Vs);
-  Kokkos::deep_copy(locVs,this->hydro->Vs);
+  IdefixHostArray4D<real> locVs = idfx::CreateHostArray(this->hydro->Vs);
+  idfx::DeepCopy(locVs, this->hydro->Vs);
   dims[0] = this->np_tot[IDIR]+IOFFSET;
   dims[1] = this->np_tot[JDIR]+JOFFSET;
   dims[2] = this->np_tot[KDIR]+KOFFSET;
@@ -152,8 +152,8 @@ void DataBlock::DumpToFile(std::string filebase)  {
 
 
   if(hydro->haveCurrent) {
-    IdefixArray4D<real>::HostMirror locJ = Kokkos::create_mirror_view(this->hydro->J);
-    Kokkos::deep_copy(locJ,this->hydro->J);
+    IdefixHostArray4D<real> locJ = idfx::CreateHostArray(this->hydro->J);
+    idfx::DeepCopy(locJ, this->hydro->J);
     dims[0] = this->np_tot[IDIR];
     dims[1] = this->np_tot[JDIR];
     dims[2] = this->np_tot[KDIR];
@@ -9,24 +9,31 @@
 #include "dataBlock.hpp"
 #include "fluid.hpp"
 
-// Evolve one step forward in time of hydro
-void DataBlock::EvolveStage() {
+// Evolve one stage forward in time of hydro, with the stage step dt
+void DataBlock::EvolveStage(const real dt) {
   idfx::pushRegion("DataBlock::EvolveStage");
 
-  hydro->EvolveStage(this->t,this->dt);
+  hydro->EvolveStage(this->t,dt);
 
   if(haveDust) {
+    // Hyperbolic fluxes of all of the species at once
+    if(dustBatch) dustBatch->EvolveStage(this->t,dt);
     for(int i = 0 ; i < dust.size() ; i++) {
-      dust[i]->EvolveStage(this->t,this->dt);
+      dust[i]->EvolveStage(this->t,dt);
     }
     // Add implicit term for dust drag
     if(dust[0]->drag->IsImplicit()) {
-      for(int i = 0 ; i < dust.size() ; i++) {
-        dust[i]->drag->AddImplicitBackReaction(this->dt,dust[0]->drag->implicitFactor);
-      }
-      dust[0]->drag->NormalizeImplicitBackReaction(this->dt);
-      for(int i = 0 ; i < dust.size() ; i++) {
-        dust[i]->drag->AddImplicitFluidMomentum(this->dt);
+      if(dustBatch) {
+        // Gas and all of the species coupled in a single pass
+        dust[0]->drag->AddImplicitDragBatch(dt);
+      } else {
+        for(int i = 0 ; i < dust.size() ; i++) {
+          dust[i]->drag->AddImplicitBackReaction(dt,dust[0]->drag->implicitFactor);
+        }
+        dust[0]->drag->NormalizeImplicitBackReaction(dt);
+        for(int i = 0 ; i < dust.size() ; i++) {
+          dust[i]->drag->AddImplicitFluidMomentum(dt);
+        }
       }
     }
   }
@@ -41,3 +48,19 @@ void DataBlock::EvolveRKLStage() {
   }
   idfx::popRegion();
 }
+
+void DataBlock::EvolveHallStage() {
+  idfx::pushRegion("DataBlock::EvolveHallStage");
+  if(hydro->hallStatus.isSubcycled) {
+    hydro->hallSubcycle->Cycle();
+  }
+  idfx::popRegion();
+}
+
+void DataBlock::EvolveImplicitStage() {
+  idfx::pushRegion("DataBlock::EvolveImplicitStage");
+  if(hydro->thermalDiffusionStatus.isImplicit) {
+    hydro->thermalDiffusion->ImplicitStep(this->t, this->dt);
+  }
+  idfx::popRegion();
+}
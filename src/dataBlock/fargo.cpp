@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "idefix.hpp"
+#include "numa.hpp"
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 #include "fargo.hpp"
@@ -113,17 +114,18 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
     }
   }
 
-  this->scrhUc = IdefixArray4D<real>("FargoVcScratchSpace",nvar
+  this->scrhUc = idfx::FirstTouchArray4D<real>("FargoVcScratchSpace",idfx::ArrayLayout4D(nvar
                                       ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]
                                       ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]
-                                      ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]);
+                                      ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]));
 
   #if MHD == YES
     if(haveDomainDecomposition) {
-      this->scrhVs = IdefixArray4D<real>("FargoVsScratchSpace",DIMENSIONS
+      this->scrhVs = idfx::FirstTouchArray4D<real>("FargoVsScratchSpace",
+                                                   idfx::ArrayLayout4D(DIMENSIONS
                                           ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]+KOFFSET
                                           ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]+JOFFSET
-                                          ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]+IOFFSET);
+                                          ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]+IOFFSET));
 
 
     } else {
@@ -101,7 +101,7 @@ KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int
   int som2 = som1-1;
   if(!haveDomainDecomposition && (som2-sbeg< 0 )) som2 = som2+ds;
 
-  real q0,qm1, qp1, qm2, qp2;
+  realc q0,qm1, qp1, qm2, qp2;
   #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
     q0 = Vin(n,k,so,i);
     qm1 = Vin(n,k,som1,i);
@@ -116,7 +116,7 @@ KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int
     qp2 = Vin(n,sop2,j,i);
   #endif
 
-  real qp, qm;
+  realc qp, qm;
   SlopeLimiter<>::getPPMStates(qm2,qm1,q0,qp1,qp2, qm, qp);
 
   real dqp = qp-q0;
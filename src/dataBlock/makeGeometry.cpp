@@ -213,6 +213,11 @@ void DataBlock::MakeGeometry() {
     }
   );
 
+  // Derive the coarsening levels from the metrics we just computed when required
+  if(haveGridCoarsening == GridCoarsening::automatic) {
+    ComputeAutoCoarseningLevels();
+  }
+
   idfx::popRegion();
 }
 
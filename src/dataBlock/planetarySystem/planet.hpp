@@ -54,12 +54,12 @@ class Planet {
     DataBlock *data;
     PointSpeed state;
 
-    real &m_xp;
-    real &m_yp;
-    real &m_zp;
-    real &m_vxp;
-    real &m_vyp;
-    real &m_vzp;
+    realc &m_xp;
+    realc &m_yp;
+    realc &m_zp;
+    realc &m_vxp;
+    realc &m_vyp;
+    realc &m_vzp;
     bool m_isActive;
     real m_qp;
     real m_qpIni;
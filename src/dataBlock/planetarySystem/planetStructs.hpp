@@ -34,13 +34,14 @@ struct Point {
     real z;
 };
 
+// Planet state, integrated with the compute precision (double in mixed precision)
 struct PointSpeed {
-  real x;
-  real y;
-  real z;
-  real vx;
-  real vy;
-  real vz;
+  realc x;
+  realc y;
+  realc z;
+  realc vx;
+  realc vy;
+  realc vz;
 };
 
 // arithmetics of pointspeed
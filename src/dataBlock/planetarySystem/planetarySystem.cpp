@@ -262,7 +262,7 @@ void PlanetarySystem::IntegrateRK5(DataBlock& data, const real& dt) {
   idfx::pushRegion("PlanetarySystem::IntegrateRK5");
   std::vector<Planet> &ki = planet;
 
-  real t1, t2, t3, t4;
+  realc t1, t2, t3, t4;
   std::vector<Planet> k0 = ki;
   std::vector<Planet> k1 = ki;
   std::vector<Planet> k2 = ki;
@@ -311,7 +311,7 @@ void PlanetarySystem::IntegrateRK4(DataBlock& data, const real& dt) {
   idfx::pushRegion("PlanetarySystem::IntegrateRK4");
   std::vector<Planet> &ki = planet;
 
-  real t1, t2, t3;
+  realc t1, t2, t3;
   std::vector<Planet> k0 = ki;
   std::vector<Planet> k1 = ki;
   std::vector<Planet> k2 = ki;
@@ -347,7 +347,7 @@ void PlanetarySystem::IntegrateRK4(DataBlock& data, const real& dt) {
   idfx::popRegion();
 }
 
-std::vector<PointSpeed> PlanetarySystem::ComputeRHS(real& t, std::vector<Planet> planet) {
+std::vector<PointSpeed> PlanetarySystem::ComputeRHS(realc& t, std::vector<Planet> planet) {
   std::vector<PointSpeed> planet_update(this->nbp);
 
   for(int ip=0; ip<this->nbp; ip++) {
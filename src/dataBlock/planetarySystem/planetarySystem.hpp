@@ -37,7 +37,7 @@ class PlanetarySystem {
     void IntegrateRK5(DataBlock&, const real&);
     void ShowConfig();
     void AddPlanetsPotential(IdefixArray3D<real> &, real);
-    std::vector<PointSpeed> ComputeRHS(real&, std::vector<Planet>);
+    std::vector<PointSpeed> ComputeRHS(realc&, std::vector<Planet>);
 
     // number of planets
     int nbp{0};
@@ -10,6 +10,7 @@
 #include <string>
 #include <algorithm>
 #include "idefix.hpp"
+#include "numa.hpp"
 
 
 StateContainer::StateContainer() {
@@ -45,10 +46,7 @@ void StateContainer::AllocateAs(StateContainer &in) {
 
     if(stateIn.type == State::idefixArray4D) {
       // But then reinit the array
-      stateOut.array = IdefixArray4D<real>(stateIn.name, stateIn.array.extent(0),
-                                                              stateIn.array.extent(1),
-                                                              stateIn.array.extent(2),
-                                                              stateIn.array.extent(3));
+      stateOut.array = idfx::FirstTouchArray4D<real>(stateIn.name, stateIn.array.layout());
     } else {
       IDEFIX_ERROR("Cannot allocate a state with type none");
     }
@@ -58,7 +56,7 @@ void StateContainer::AllocateAs(StateContainer &in) {
   idfx::popRegion();
 }
 
-void StateContainer::PushArray(IdefixArray4D<real>& in,
+int StateContainer::PushArray(IdefixArray4D<real>& in,
                                State::TypeLocation loc,
                                std::string name) {
   idfx::pushRegion("StateContainer::PushArray");
@@ -69,6 +67,17 @@ void StateContainer::PushArray(IdefixArray4D<real>& in,
   state.location = loc;
   this->stateVector.push_back(state);
   idfx::popRegion();
+  return(this->stateVector.size()-1);
+}
+
+IdefixArray4D<real> StateContainer::GetArray(int index) {
+  if(index < 0 || index >= this->stateVector.size()) {
+    IDEFIX_ERROR("StateContainer: invalid state index");
+  }
+  if(this->stateVector[index].type != State::idefixArray4D) {
+    IDEFIX_ERROR("StateContainer: state is not an IdefixArray4D");
+  }
+  return(this->stateVector[index].array);
 }
 
 
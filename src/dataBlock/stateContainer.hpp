@@ -29,8 +29,9 @@ class StateContainer {
   StateContainer();
   void CopyFrom(StateContainer &);    // Return a deepcopy of the current state container
   void AllocateAs(StateContainer &);    // Return a deepcopy of the current state container
-  void PushArray(IdefixArray4D<real> &, State::TypeLocation, std::string);
+  int PushArray(IdefixArray4D<real> &, State::TypeLocation, std::string); // return its index
   void AddAndStore(const real, const real, StateContainer&);
+  IdefixArray4D<real> GetArray(int);  // Direct access to the array with the given index
 
 
  private:
@@ -13,6 +13,70 @@
 #include "extrapolateToFaces.hpp"
 #include "flux.hpp"
 #include "convertConsToPrim.hpp"
+#include "coarseFaces.hpp"
+
+// HLL flux of a pressureless fluid from its left and right primitive states along DIR.
+// Returns the maximum wave speed.
+template <typename Phys, const int DIR>
+KOKKOS_FORCEINLINE_FUNCTION realc K_HllDust(realc vL[], realc vR[], realc flux[]) {
+  // Init the directions (should be in the kernel for proper optimisation by the compilers)
+  constexpr int Xn = DIR+MX1;
+
+  // Conservative variables
+  realc uL[Phys::nvar];
+  realc uR[Phys::nvar];
+
+  // Flux (left and right)
+  realc fluxL[Phys::nvar];
+  realc fluxR[Phys::nvar];
+
+  // 2-- Get the wave speed
+
+  realc SL = vL[Xn];
+  realc SR = vR[Xn];
+
+  realc cmax  = FMAX(FABS(SL), FABS(SR));
+
+  // 3-- Compute the conservative variables: do this by extrapolation
+  K_PrimToCons<Phys>(uL, vL, NULL); // Set gamma to 0 implicitly
+  K_PrimToCons<Phys>(uR, vR, NULL);
+
+  // 4-- Compute the left and right fluxes (wave speed is null)
+  K_Flux<Phys,DIR>(fluxL, vL, uL, 0);
+  K_Flux<Phys,DIR>(fluxR, vR, uR, 0);
+
+  // 5-- Compute the flux from the left and right states
+  if constexpr(riemannBranchless) {
+    const realc dS = (std::abs(SR-SL) < SMALL_NUMBER) ? SMALL_NUMBER : SR-SL;
+#pragma unroll
+    for(int nv = 0 ; nv < Phys::nvar; nv++) {
+      realc fluxHll = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
+      fluxHll /= dS;
+      flux[nv] = (SL > 0) ? fluxL[nv] : ((SR < 0) ? fluxR[nv] : fluxHll);
+    }
+  } else if (SL > 0) {
+#pragma unroll
+    for (int nv = 0 ; nv < Phys::nvar; nv++) {
+      flux[nv] = fluxL[nv];
+    }
+  } else if (SR < 0) {
+#pragma unroll
+    for (int nv = 0 ; nv < Phys::nvar; nv++) {
+      flux[nv] = fluxR[nv];
+    }
+  } else {
+    realc dS = SR-SL;
+    if(std::abs(dS) < SMALL_NUMBER) {
+      dS = SMALL_NUMBER;
+    }
+#pragma unroll
+    for(int nv = 0 ; nv < Phys::nvar; nv++) {
+      flux[nv] = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
+      flux[nv] /= dS;
+    }
+  }
+  return(cmax);
+}
 
 // Compute Riemann fluxes from states using HLL solver
 template <typename Phys>
@@ -32,67 +96,48 @@ void RiemannSolver<Phys>::HllDust(IdefixArray4D<real> &Flux) {
 
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+  CoarseFaces<Phys,DIR> coarseFaces(data, Vc, hydro->eos.get());
+  DustMask mask = hydro->activeMask;
+  const int species = hydro->instanceNumber;
 
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("HLL_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
              data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      // Init the directions (should be in the kernel for proper optimisation by the compilers)
-      constexpr int Xn = DIR+MX1;
-
-      // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
+      // Faces between two inactive cells carry no flux
+      if(!mask.IsFaceActive<DIR>(species,k,j,i)) {
+        for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+          Flux(nv,k,j,i) = ZERO_F;
+        }
+        cMax(k,j,i) = ZERO_F;
+        return;
+      }
 
-      // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+      // Faces inside a coarsened group only need the flux of the cell state
+      if(coarseFaces.IsInterior(k,j,i)) {
+        coarseFaces.SetFlux(k, j, i, Flux, cMax);
+        return;
+      }
 
-      // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      // Primitive variables
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
 
+      realc flux[Phys::nvar];
 
       // 1-- Store the primitive variables on the left, right, and averaged states
       extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
 
-      // 2-- Get the wave speed
-
-      real SL = vL[Xn];
-      real SR = vR[Xn];
-
-      real cmax  = FMAX(FABS(SL), FABS(SR));
+      // 2 to 5-- HLL flux
+      realc cmax = K_HllDust<Phys,DIR>(vL, vR, flux);
 
-      // 3-- Compute the conservative variables: do this by extrapolation
-      K_PrimToCons<Phys>(uL, vL, NULL); // Set gamma to 0 implicitly
-      K_PrimToCons<Phys>(uR, vR, NULL);
-
-      // 4-- Compute the left and right fluxes (wave speed is null)
-      K_Flux<Phys,DIR>(fluxL, vL, uL, 0);
-      K_Flux<Phys,DIR>(fluxR, vR, uR, 0);
-
-      // 5-- Compute the flux from the left and right states
-      if (SL > 0) {
-#pragma unroll
-        for (int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = fluxL[nv];
-        }
-      } else if (SR < 0) {
 #pragma unroll
-        for (int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = fluxR[nv];
-        }
-      } else {
-        real dS = SR-SL;
-        if(std::abs(dS) < SMALL_NUMBER) {
-          dS = SMALL_NUMBER;
-        }
-#pragma unroll
-        for(int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
-          Flux(nv,k,j,i) /= dS;
-        }
+      for(int nv = 0 ; nv < Phys::nvar; nv++) {
+        Flux(nv,k,j,i) = flux[nv];
       }
 
       //6-- Compute maximum wave speed for this sweep
@@ -13,6 +13,7 @@
 #include "extrapolateToFaces.hpp"
 #include "flux.hpp"
 #include "convertConsToPrim.hpp"
+#include "coarseFaces.hpp"
 
 // Compute Riemann fluxes from states using HLL solver
 template <typename Phys>
@@ -33,28 +34,39 @@ void RiemannSolver<Phys>::HllHD(IdefixArray4D<real> &Flux) {
   IdefixArray1D<real> dx = this->data->dx[DIR];
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+  CoarseFaces<Phys,DIR> coarseFaces(data, Vc, hydro->eos.get());
+
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("HLL_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
              data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
+      // Faces inside a coarsened group only need the flux of the cell state
+      if(coarseFaces.IsInterior(k,j,i)) {
+        coarseFaces.SetFlux(k, j, i, Flux, cMax);
+        return;
+      }
+
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       constexpr int Xn = DIR+MX1;
 
       // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
 
       // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+      realc uL[Phys::nvar];
+      realc uR[Phys::nvar];
 
       // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      realc fluxL[Phys::nvar];
+      realc fluxR[Phys::nvar];
 
       // Signal speeds
-      real cL, cR, cmax;
+      realc cL, cR, cmax;
 
       // 1-- Store the primitive variables on the left, right, and averaged states
       extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
@@ -70,14 +82,14 @@ void RiemannSolver<Phys>::HllHD(IdefixArray4D<real> &Flux) {
       #endif
 
       // 4.1
-      real cminL = vL[Xn] - cL;
-      real cmaxL = vL[Xn] + cL;
+      realc cminL = vL[Xn] - cL;
+      realc cmaxL = vL[Xn] + cL;
 
-      real cminR = vR[Xn] - cR;
-      real cmaxR = vR[Xn] + cR;
+      realc cminR = vR[Xn] - cR;
+      realc cmaxR = vR[Xn] + cR;
 
-      real SL = FMIN(cminL, cminR);
-      real SR = FMAX(cmaxL, cmaxR);
+      realc SL = FMIN(cminL, cminR);
+      realc SR = FMAX(cmaxL, cmaxR);
 
       cmax  = FMAX(FABS(SL), FABS(SR));
 
@@ -90,7 +102,14 @@ void RiemannSolver<Phys>::HllHD(IdefixArray4D<real> &Flux) {
       K_Flux<Phys,DIR>(fluxR, vR, uR, cR*cR);
 
       // 5-- Compute the flux from the left and right states
-      if (SL > 0) {
+      if constexpr(riemannBranchless) {
+#pragma unroll
+        for(int nv = 0 ; nv < Phys::nvar; nv++) {
+          realc fluxHll = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
+          fluxHll /= (SR - SL);
+          Flux(nv,k,j,i) = (SL > 0) ? fluxL[nv] : ((SR < 0) ? fluxR[nv] : fluxHll);
+        }
+      } else if (SL > 0) {
 #pragma unroll
         for (int nv = 0 ; nv < Phys::nvar; nv++) {
           Flux(nv,k,j,i) = fluxL[nv];
@@ -13,6 +13,7 @@
 #include "extrapolateToFaces.hpp"
 #include "flux.hpp"
 #include "convertConsToPrim.hpp"
+#include "coarseFaces.hpp"
 
 // Compute Riemann fluxes from states using HLLC solver
 template <typename Phys>
@@ -31,31 +32,41 @@ void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
   EquationOfState eos = *(hydro->eos.get());
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+  CoarseFaces<Phys,DIR> coarseFaces(data, Vc, hydro->eos.get());
 
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("HLLC_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
              data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
+      // Faces inside a coarsened group only need the flux of the cell state
+      if(coarseFaces.IsInterior(k,j,i)) {
+        coarseFaces.SetFlux(k, j, i, Flux, cMax);
+        return;
+      }
+
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       EXPAND( constexpr int Xn = DIR+MX1;                    ,
               constexpr int Xt = (DIR == IDIR ? MX2 : MX1);  ,
               constexpr int Xb = (DIR == KDIR ? MX2 : MX3);  )
 
       // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
 
       // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+      realc uL[Phys::nvar];
+      realc uR[Phys::nvar];
 
       // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      realc fluxL[Phys::nvar];
+      realc fluxR[Phys::nvar];
 
       // Signal speeds
-      real cL, cR, cmax;
+      realc cL, cR, cmax;
 
       // 1-- Store the primitive variables on the left, right, and averaged states
       extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
@@ -70,14 +81,14 @@ void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
         cR = cL;
       #endif
 
-      real cminL = vL[Xn] - cL;
-      real cmaxL = vL[Xn] + cL;
+      realc cminL = vL[Xn] - cL;
+      realc cmaxL = vL[Xn] + cL;
 
-      real cminR = vR[Xn] - cR;
-      real cmaxR = vR[Xn] + cR;
+      realc cminR = vR[Xn] - cR;
+      realc cmaxR = vR[Xn] + cR;
 
-      real SL = FMIN(cminL, cminR);
-      real SR = FMAX(cmaxL, cmaxR);
+      realc SL = FMIN(cminL, cminR);
+      realc SR = FMAX(cmaxL, cmaxR);
 
       cmax  = FMAX(FABS(SL), FABS(SR));
 
@@ -90,30 +101,39 @@ void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
       K_Flux<Phys,DIR>(fluxR, vR, uR, cR*cR);
 
       // 5-- Compute the flux from the left and right states
-      if (SL > 0) {
+      // (branch-free: the star states are computed on every face, and the flux is selected below.
+      // The signal speeds of the star states are then bounded by 0, so that they remain well
+      // defined on the supersonic faces, and unchanged on the others)
+      const bool supersonicL = SL > 0;
+      const bool supersonicR = SR < 0;
+      if constexpr(riemannBranchless) {
+        SL = FMIN(SL, ZERO_F);
+        SR = FMAX(SR, ZERO_F);
+      }
+      if (!riemannBranchless && supersonicL) {
 #pragma unroll
         for (int nv = 0 ; nv < Phys::nvar; nv++) {
           Flux(nv,k,j,i) = fluxL[nv];
         }
-      } else if (SR < 0) {
+      } else if (!riemannBranchless && supersonicR) {
 #pragma unroll
         for (int nv = 0 ; nv < Phys::nvar; nv++) {
           Flux(nv,k,j,i) = fluxR[nv];
         }
       } else {
-        real usL[Phys::nvar];
-        real usR[Phys::nvar];
-        real vs;
+        realc usL[Phys::nvar];
+        realc usR[Phys::nvar];
+        realc vs;
 
 #if HAVE_ENERGY
-        real qL, qR, wL, wR;
+        realc qL, qR, wL, wR;
         qL = vL[PRS] + uL[Xn]*(vL[Xn] - SL);
         qR = vR[PRS] + uR[Xn]*(vR[Xn] - SR);
 
         wL = vL[RHO]*(vL[Xn] - SL);
         wR = vR[RHO]*(vR[Xn] - SR);
 
-        vs = (qR - qL)/(wR - wL); // wR - wL > 0 since SL < 0, SR > 0
+        vs = (qR - qL)/(wR - wL); // wR - wL < 0 since SL < vL[Xn], SR > vR[Xn]
 
         usL[RHO] = uL[RHO]*(SL - vL[Xn])/(SL - vs);
         usR[RHO] = uR[RHO]*(SR - vR[Xn])/(SR - vs);
@@ -129,9 +149,9 @@ void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
         usL[ENG] *= usL[RHO];
         usR[ENG] *= usR[RHO];
 #else
-        real scrh = 1.0/(SR - SL);
-        real rho  = (SR*uR[RHO] - SL*uL[RHO] - fluxR[RHO] + fluxL[RHO])*scrh;
-        real mx   = (SR*uR[Xn] - SL*uL[Xn] - fluxR[Xn] + fluxL[Xn])*scrh;
+        realc scrh = 1.0/(SR - SL);
+        realc rho  = (SR*uR[RHO] - SL*uL[RHO] - fluxR[RHO] + fluxL[RHO])*scrh;
+        realc mx   = (SR*uR[Xn] - SL*uL[Xn] - fluxR[Xn] + fluxL[Xn])*scrh;
 
         usL[RHO] = usR[RHO] = rho;
         usL[Xn] = usR[Xn] = mx;
@@ -145,7 +165,15 @@ void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
 #endif
 
     // Compute the flux from the left and right states
-        if (vs >= 0.0) {
+        if constexpr(riemannBranchless) {
+#pragma unroll
+          for(int nv = 0 ; nv < Phys::nvar; nv++) {
+            const realc fluxStarL = fluxL[nv] + SL*(usL[nv] - uL[nv]);
+            const realc fluxStarR = fluxR[nv] + SR*(usR[nv] - uR[nv]);
+            const realc fluxStar = (vs >= 0.0) ? fluxStarL : fluxStarR;
+            Flux(nv,k,j,i) = supersonicL ? fluxL[nv] : (supersonicR ? fluxR[nv] : fluxStar);
+          }
+        } else if (vs >= 0.0) {
 #pragma unroll
           for(int nv = 0 ; nv < Phys::nvar; nv++) {
             Flux(nv,k,j,i) = fluxL[nv] + SL*(usL[nv] - uL[nv]);
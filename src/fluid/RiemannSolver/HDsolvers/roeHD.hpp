@@ -13,6 +13,7 @@
 #include "extrapolateToFaces.hpp"
 #include "flux.hpp"
 #include "convertConsToPrim.hpp"
+#include "coarseFaces.hpp"
 
 #define ROE_AVERAGE 0
 #undef NMODES
@@ -52,32 +53,42 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
   EquationOfState eos = *(hydro->eos.get());
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+  CoarseFaces<Phys,DIR> coarseFaces(data, Vc, hydro->eos.get());
 
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("ROE_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
              data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
+      // Faces inside a coarsened group only need the flux of the cell state
+      if(coarseFaces.IsInterior(k,j,i)) {
+        coarseFaces.SetFlux(k, j, i, Flux, cMax);
+        return;
+      }
+
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       EXPAND( const int Xn = DIR+MX1;                    ,
               const int Xt = (DIR == IDIR ? MX2 : MX1);  ,
               const int Xb = (DIR == KDIR ? MX2 : MX3);  )
       // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
-      real dv[Phys::nvar];
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
+      realc dv[Phys::nvar];
 
       // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+      realc uL[Phys::nvar];
+      realc uR[Phys::nvar];
 
       // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      realc fluxL[Phys::nvar];
+      realc fluxR[Phys::nvar];
 
       // Roe
-      real Rc[Phys::nvar][Phys::nvar];
-      real um[Phys::nvar];
+      realc Rc[Phys::nvar][Phys::nvar];
+      realc um[Phys::nvar];
 
       // 1-- Store the primitive variables on the left, right, and averaged states
       extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
@@ -87,11 +98,11 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
       }
 
       // --- Compute the square of the sound speed
-      real a, a2, a2L, a2R;
+      realc a, a2, a2L, a2R;
 #if HAVE_ENERGY
       a2L = std::sqrt(eos.GetGamma(vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
       a2R = std::sqrt(eos.GetGamma(vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
-      real h, vel2;
+      realc h, vel2;
 #else
       a2L = HALF_F*(eos.GetWaveSpeed(k,j,i)
                     +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
@@ -112,13 +123,13 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
       // Compute gamma of this interface
       // todo(glesur): check that it's not the internal energy that should be used there instead
       #if HAVE_ENERGY
-      real gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]), 0.5*(vL[RHO]+vR[RHO]));
-      real gamma_m1 = gamma-1;
+      realc gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]), 0.5*(vL[RHO]+vR[RHO]));
+      realc gamma_m1 = gamma-1;
       #endif
 
       //  ----  Define Wave Jumps  ----
 #if ROE_AVERAGE == YES
-      real s, c;
+      realc s, c;
       s       = std::sqrt(vR[RHO]/vL[RHO]);
       um[RHO] = vL[RHO]*s;
       s       = ONE_F/(ONE_F + s);
@@ -129,11 +140,11 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
       um[VX3] = s*vL[VX3] + c*vR[VX3];)
 
   #if HAVE_ENERGY
-      real gmm1_inv = ONE_F / gamma_m1;
+      realc gmm1_inv = ONE_F / gamma_m1;
 
       vel2 = EXPAND(um[VX1]*um[VX1], + um[VX2]*um[VX2], + um[VX3]*um[VX3]);
 
-      real hl, hr;
+      realc hl, hr;
       hl  = HALF_F*(EXPAND(vL[VX1]*vL[VX1], + vL[VX2]*vL[VX2], + vL[VX3]*vL[VX3]));
       hl += a2L*gmm1_inv;
 
@@ -184,8 +195,8 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
       eigenvalues (lambda) and wave strenght eta = L.du
       ----------------------------------------------------------------  */
 
-      real lambda[NMODES], alambda[NMODES];
-      real eta[NMODES];
+      realc lambda[NMODES], alambda[NMODES];
+      realc eta[NMODES];
 
 #pragma unroll
       for(int nv1 = 0 ; nv1 < Phys::nvar; nv1++) {
@@ -273,7 +284,7 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
 
       /*  ----  get max eigenvalue  ----  */
 
-      real cmax = FABS(um[Xn]) + a;
+      realc cmax = FABS(um[Xn]) + a;
       //g_maxMach = FMAX(FABS(um[Xn]/a), g_maxMach);
 
       /* ---------------------------------------------
@@ -283,7 +294,7 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
       in the Mach reflection test.
       --------------------------------------------- */
 
-      real scrh;
+      realc scrh;
 #if HAVE_ENERGY
       scrh  = FABS(vL[PRS] - vR[PRS]);
       scrh /= FMIN(vL[PRS],vR[PRS]);
@@ -314,8 +325,8 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
 
       if (scrh > HALF_F && (vR[Xn] < vL[Xn])) {   /* -- tunable parameter -- */
 #if DIMENSIONS > 1
-        real scrh1;
-        real bmin, bmax;
+        realc scrh1;
+        realc bmin, bmax;
         bmin = FMIN(ZERO_F, lambda[0]);
         bmax = FMAX(ZERO_F, lambda[1]);
         scrh1 = ONE_F/(bmax - bmin);
@@ -337,7 +348,7 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
         }
 
         /*  ----  entropy fix  ----  */
-        real delta = 1.e-7;
+        realc delta = 1.e-7;
         if (alambda[0] <= delta) {
           alambda[0] = HALF_F*lambda[0]*lambda[0]/delta + HALF_F*delta;
         }
@@ -13,6 +13,7 @@
 #include "extrapolateToFaces.hpp"
 #include "flux.hpp"
 #include "convertConsToPrim.hpp"
+#include "coarseFaces.hpp"
 
 // Compute Riemann fluxes from states using TVDLF solver
 template <typename Phys>
@@ -33,30 +34,40 @@ void RiemannSolver<Phys>::TvdlfHD(IdefixArray4D<real> &Flux) {
   IdefixArray1D<real> dx = this->data->dx[DIR];
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+  CoarseFaces<Phys,DIR> coarseFaces(data, Vc, hydro->eos.get());
 
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("TVDLF_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
              data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
+      // Faces inside a coarsened group only need the flux of the cell state
+      if(coarseFaces.IsInterior(k,j,i)) {
+        coarseFaces.SetFlux(k, j, i, Flux, cMax);
+        return;
+      }
+
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       constexpr int Xn = DIR+MX1;
 
       // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
-      real vRL[Phys::nvar];
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
+      realc vRL[Phys::nvar];
 
       // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+      realc uL[Phys::nvar];
+      realc uR[Phys::nvar];
 
       // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      realc fluxL[Phys::nvar];
+      realc fluxR[Phys::nvar];
 
       // Signal speeds
-      real cRL, cmax;
+      realc cRL, cmax;
 
       // 1-- Read primitive variables
       extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
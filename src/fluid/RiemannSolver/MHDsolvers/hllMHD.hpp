@@ -50,7 +50,9 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
   IdefixArray4D<real> Vs = this->Vs;
   IdefixArray3D<real> cMax = this->cMax;
 
-  HydroModuleStatus haveHall = hydro->hallStatus.status;
+  // When sub-cycled, Hall is handled outside of the Riemann solver
+  HydroModuleStatus haveHall = hydro->hallStatus.isExplicit ? hydro->hallStatus.status
+                                                            : HydroModuleStatus::Disabled;
   IdefixArray4D<real> J = hydro->J;
   IdefixArray3D<real> xHallArr = hydro->xHall;
   IdefixArray1D<real> dx = data->dx[DIR];
@@ -76,13 +78,13 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
 
   EquationOfState eos = *(hydro->eos.get());
 
-  [[maybe_unused]] real xHConstant = hydro->xH;
+  [[maybe_unused]] realc xHConstant = hydro->xH;
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
   // Define normal, tangent and bi-tanget indices
   // st and sb will be useful only when Hall is included
-  real st = ONE_F, sb = ONE_F;
+  realc st = ONE_F, sb = ONE_F;
 
   switch(DIR) {
     case(IDIR):
@@ -151,6 +153,10 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
   }
 
 
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  // (the EMF components stored for CT are not counted)
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc) + idfx::BytesPerCell(Vs),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("CalcRiemannFlux",
              data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
              data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
@@ -163,19 +169,19 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
               const int BXb = (DIR == KDIR ? BX2 : BX3);   )
 
       // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
 
       // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+      realc uL[Phys::nvar];
+      realc uR[Phys::nvar];
 
       // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      realc fluxL[Phys::nvar];
+      realc fluxR[Phys::nvar];
 
       // Signal speeds
-      real cL, cR, cmax, c2Iso;
+      realc cL, cR, cmax, c2Iso;
 
       c2Iso = ZERO_F;
 
@@ -185,10 +191,10 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
       vR[BXn] = vL[BXn];
 
       // 2-- Get the wave speed
-      real gpr, b1, b2, b3, Btmag2, Bmag2;
-      real xH;
+      realc gpr, b1, b2, b3, Btmag2, Bmag2;
+      realc xH;
 #if HAVE_ENERGY
-      real gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]),0.5*(vL[RHO]+vR[RHO]));
+      realc gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]),0.5*(vL[RHO]+vR[RHO]));
       gpr = gamma*vL[PRS];
 #else
       c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
@@ -231,18 +237,18 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
       cR = std::sqrt(HALF_F*cR/vR[RHO]);
 
       // 4.1
-      real cminL = vL[Xn] - cL;
-      real cmaxL = vL[Xn] + cL;
+      realc cminL = vL[Xn] - cL;
+      realc cmaxL = vL[Xn] + cL;
 
-      real cminR = vR[Xn] - cR;
-      real cmaxR = vR[Xn] + cR;
+      realc cminR = vR[Xn] - cR;
+      realc cmaxR = vR[Xn] + cR;
 
-      real sl = FMIN(cminL, cminR);
-      real sr = FMAX(cmaxL, cmaxR);
+      realc sl = FMIN(cminL, cminR);
+      realc sr = FMAX(cmaxL, cmaxR);
 
       // Signal speeds specific to B (different from the other ones when Hall is enabled)
-      real SLb = sl;
-      real SRb = sr;
+      realc SLb = sl;
+      realc SRb = sr;
       // if Hall is enabled, add whistler speed to the fan
       if(haveHall) {
         // Compute xHall
@@ -255,7 +261,7 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
         }
 
         const int ig = ioffset*i + joffset*j + koffset*k;
-        real dl = dx(ig);
+        realc dl = dx(ig);
         #if GEOMETRY == POLAR
             if(DIR==JDIR) dl = dl*x1(i);
         #elif GEOMETRY == SPHERICAL
@@ -263,7 +269,7 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
             if(DIR==KDIR) dl = dl*rt(i)*dmu(j)/dx2(j);
         #endif
 
-        real cw = FABS(xH) * std::sqrt(Bmag2) / dl;
+        realc cw = FABS(xH) * std::sqrt(Bmag2) / dl;
 
         cminL = cminL - cw;
         cmaxL = cmaxL + cw;
@@ -297,7 +303,7 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
       // 4-- Compute the Hall flux
       if(haveHall) {
         [[maybe_unused]] int ip1, jp1, kp1;
-        real Jx1, Jx2, Jx3;
+        realc Jx1, Jx2, Jx3;
         ip1=i+1;
         #if DIMENSIONS >=2
             jp1 = j+1;
@@ -361,8 +367,8 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
         }
 
         #if HAVE_ENERGY
-          real JB = EXPAND(uL[BX1]*Jx1,  +uL[BX2]*Jx2, +uL[BX3]*Jx3 );
-          real b2 = HALF_F*(EXPAND(uL[BX1]*uL[BX1], +uL[BX2]*uL[BX2], +uL[BX3]*uL[BX3]));
+          realc JB = EXPAND(uL[BX1]*Jx1,  +uL[BX2]*Jx2, +uL[BX3]*Jx3 );
+          realc b2 = HALF_F*(EXPAND(uL[BX1]*uL[BX1], +uL[BX2]*uL[BX2], +uL[BX3]*uL[BX3]));
           if(DIR == IDIR) fluxL[ENG] += -xH* (Jx1*b2 - JB*uL[BX1]);
           #if COMPONENTS>=2
           if(DIR == JDIR) fluxL[ENG] += -xH* (Jx2*b2 - JB*uL[BX2]);
@@ -384,52 +390,73 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
       }
 
       // 5-- Compute the flux from the left and right states
-      if (sl > 0) {
-        Flux(RHO,k,j,i) = fluxL[RHO];
-        EXPAND( Flux(MX1,k,j,i) = fluxL[MX1];  ,
-                Flux(MX2,k,j,i) = fluxL[MX2];  ,
-                Flux(MX3,k,j,i) = fluxL[MX3];  )
-      } else if (sr < 0) {
-        Flux(RHO,k,j,i) = fluxR[RHO];
-        EXPAND( Flux(MX1,k,j,i) = fluxR[MX1];  ,
-                Flux(MX2,k,j,i) = fluxR[MX2];  ,
-                Flux(MX3,k,j,i) = fluxR[MX3];  )
-      } else {
-        Flux(RHO,k,j,i) = (sl*sr*uR[RHO] - sl*sr*uL[RHO] + sr*fluxL[RHO] - sl*fluxR[RHO])
-                          / (sr - sl);
-        EXPAND( Flux(MX1,k,j,i) = (sl*sr*uR[MX1] - sl*sr*uL[MX1] + sr*fluxL[MX1] - sl*fluxR[MX1])
-                                  / (sr - sl);  ,
-                Flux(MX2,k,j,i) = (sl*sr*uR[MX2] - sl*sr*uL[MX2] + sr*fluxL[MX2] - sl*fluxR[MX2])
-                                  / (sr - sl);  ,
-                Flux(MX3,k,j,i) = (sl*sr*uR[MX3] - sl*sr*uL[MX3] + sr*fluxL[MX3] - sl*fluxR[MX3])
-                                  / (sr - sl);  )
-      }
-
-      if (SLb > 0) {
+      if constexpr(riemannBranchless) {
+        // (branch-free: the HLL fluxes are computed on every face, and selected)
 #pragma unroll
-        for (int nv = BX1 ; nv < BX1+COMPONENTS; nv++) {
-          Flux(nv,k,j,i) = fluxL[nv];
-        }
-        if constexpr(Phys::pressure) {
-          Flux(ENG,k,j,i) = fluxL[ENG];
+        for(int nv = RHO ; nv < MX1+COMPONENTS; nv++) {
+          const realc fluxHll = (sl*sr*uR[nv] - sl*sr*uL[nv] + sr*fluxL[nv] - sl*fluxR[nv])
+                                / (sr - sl);
+          Flux(nv,k,j,i) = (sl > 0) ? fluxL[nv] : ((sr < 0) ? fluxR[nv] : fluxHll);
         }
-      } else if (SRb < 0) {
 #pragma unroll
-        for (int nv = BX1 ; nv < BX1+COMPONENTS; nv++) {
-          Flux(nv,k,j,i) = fluxR[nv];
+        for(int nv = BX1 ; nv < BX1+COMPONENTS; nv++) {
+          const realc fluxHll = (SLb*SRb*uR[nv] - SLb*SRb*uL[nv] + SRb*fluxL[nv] - SLb*fluxR[nv])
+                                * (1.0 / (SRb - SLb));
+          Flux(nv,k,j,i) = (SLb > 0) ? fluxL[nv] : ((SRb < 0) ? fluxR[nv] : fluxHll);
         }
         if constexpr(Phys::pressure) {
-          Flux(ENG,k,j,i) = fluxR[ENG];
+          const realc fluxHll = (SLb*SRb*uR[ENG] - SLb*SRb*uL[ENG] + SRb*fluxL[ENG]
+                                 - SLb*fluxR[ENG]) * (1.0 / (SRb - SLb));
+          Flux(ENG,k,j,i) = (SLb > 0) ? fluxL[ENG] : ((SRb < 0) ? fluxR[ENG] : fluxHll);
         }
       } else {
-#pragma unroll
-        for(int nv = BX1 ; nv < BX1+COMPONENTS; nv++) {
-          Flux(nv,k,j,i) = SLb*SRb*uR[nv] - SLb*SRb*uL[nv] + SRb*fluxL[nv] - SLb*fluxR[nv];
-          Flux(nv,k,j,i) *= (1.0 / (SRb - SLb));
+        if (sl > 0) {
+          Flux(RHO,k,j,i) = fluxL[RHO];
+          EXPAND( Flux(MX1,k,j,i) = fluxL[MX1];  ,
+                  Flux(MX2,k,j,i) = fluxL[MX2];  ,
+                  Flux(MX3,k,j,i) = fluxL[MX3];  )
+        } else if (sr < 0) {
+          Flux(RHO,k,j,i) = fluxR[RHO];
+          EXPAND( Flux(MX1,k,j,i) = fluxR[MX1];  ,
+                  Flux(MX2,k,j,i) = fluxR[MX2];  ,
+                  Flux(MX3,k,j,i) = fluxR[MX3];  )
+        } else {
+          Flux(RHO,k,j,i) = (sl*sr*uR[RHO] - sl*sr*uL[RHO] + sr*fluxL[RHO] - sl*fluxR[RHO])
+                            / (sr - sl);
+          EXPAND( Flux(MX1,k,j,i) = (sl*sr*uR[MX1] - sl*sr*uL[MX1]
+                                     + sr*fluxL[MX1] - sl*fluxR[MX1]) / (sr - sl);  ,
+                  Flux(MX2,k,j,i) = (sl*sr*uR[MX2] - sl*sr*uL[MX2]
+                                     + sr*fluxL[MX2] - sl*fluxR[MX2]) / (sr - sl);  ,
+                  Flux(MX3,k,j,i) = (sl*sr*uR[MX3] - sl*sr*uL[MX3]
+                                     + sr*fluxL[MX3] - sl*fluxR[MX3]) / (sr - sl);  )
         }
-        if constexpr(Phys::pressure) {
-          Flux(ENG,k,j,i) = SLb*SRb*uR[ENG] - SLb*SRb*uL[ENG] + SRb*fluxL[ENG] - SLb*fluxR[ENG];
-          Flux(ENG,k,j,i) *= (1.0 / (SRb - SLb));
+
+        if (SLb > 0) {
+#pragma unroll
+          for (int nv = BX1 ; nv < BX1+COMPONENTS; nv++) {
+            Flux(nv,k,j,i) = fluxL[nv];
+          }
+          if constexpr(Phys::pressure) {
+            Flux(ENG,k,j,i) = fluxL[ENG];
+          }
+        } else if (SRb < 0) {
+#pragma unroll
+          for (int nv = BX1 ; nv < BX1+COMPONENTS; nv++) {
+            Flux(nv,k,j,i) = fluxR[nv];
+          }
+          if constexpr(Phys::pressure) {
+            Flux(ENG,k,j,i) = fluxR[ENG];
+          }
+        } else {
+#pragma unroll
+          for(int nv = BX1 ; nv < BX1+COMPONENTS; nv++) {
+            Flux(nv,k,j,i) = SLb*SRb*uR[nv] - SLb*SRb*uL[nv] + SRb*fluxL[nv] - SLb*fluxR[nv];
+            Flux(nv,k,j,i) *= (1.0 / (SRb - SLb));
+          }
+          if constexpr(Phys::pressure) {
+            Flux(ENG,k,j,i) = SLb*SRb*uR[ENG] - SLb*SRb*uL[ENG] + SRb*fluxL[ENG] - SLb*fluxR[ENG];
+            Flux(ENG,k,j,i) *= (1.0 / (SRb - SLb));
+          }
         }
       }
 
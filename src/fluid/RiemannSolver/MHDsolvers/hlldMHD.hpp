@@ -76,7 +76,7 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
   // st and sb will be useful only when Hall is included
-  real st = ONE_F, sb = ONE_F;
+  realc st = ONE_F, sb = ONE_F;
 
   switch(DIR) {
     case(IDIR):
@@ -144,6 +144,10 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
       IDEFIX_ERROR("Wrong direction");
   }
 
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  // (the EMF components stored for CT are not counted)
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc) + idfx::BytesPerCell(Vs),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("CalcRiemannFlux",
              data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
              data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
@@ -158,32 +162,35 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
               constexpr int BXt = (DIR == IDIR ? BX2 : BX1);  ,
               constexpr int BXb = (DIR == KDIR ? BX2 : BX3);   )
 
+      // Branch-free selection of the regions (the isothermal solver keeps its branches)
+      constexpr bool branchless = riemannBranchless && HAVE_ENERGY;
+
       // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
 
       extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
       vL[BXn] = Vs(DIR,k,j,i);
       vR[BXn] = vL[BXn];
 
       // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+      realc uL[Phys::nvar];
+      realc uR[Phys::nvar];
 
       // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      realc fluxL[Phys::nvar];
+      realc fluxR[Phys::nvar];
 
       // Signal speeds
-      real cL, cR, cmax, c2Iso;
+      realc cL, cR, cmax, c2Iso;
 
       // Init c2Isothermal (used only when isothermal approx is set)
       c2Iso = ZERO_F;
 
       // 2-- Get the wave speed
-      real gpr, b1, b2, b3, Btmag2, Bmag2;
+      realc gpr, b1, b2, b3, Btmag2, Bmag2;
 #if HAVE_ENERGY
-      real gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]),0.5*(vL[RHO]+vR[RHO]));
+      realc gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]),0.5*(vL[RHO]+vR[RHO]));
       gpr = gamma*vL[PRS];
 #else
       c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
@@ -226,14 +233,14 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
       cR = std::sqrt(HALF_F*cR/vR[RHO]);
 
       // 4.1
-      real cminL = vL[Xn] - cL;
-      real cmaxL = vL[Xn] + cL;
+      realc cminL = vL[Xn] - cL;
+      realc cmaxL = vL[Xn] + cL;
 
-      real cminR = vR[Xn] - cR;
-      real cmaxR = vR[Xn] + cR;
+      realc cminR = vR[Xn] - cR;
+      realc cmaxR = vR[Xn] + cR;
 
-      real sl = FMIN(cminL, cminR);
-      real sr = FMAX(cmaxL, cmaxR);
+      realc sl = FMIN(cminL, cminR);
+      realc sr = FMAX(cmaxL, cmaxR);
 
       cmax  = std::fmax(FABS(sl), FABS(sr));
 
@@ -254,35 +261,35 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
       [[maybe_unused]] int revert_to_hll = 0, revert_to_hllc = 0;
 
 #if HAVE_ENERGY
-      real ptL  = vL[PRS] + HALF_F* ( EXPAND(vL[BX1]*vL[BX1]     ,
+      realc ptL  = vL[PRS] + HALF_F* ( EXPAND(vL[BX1]*vL[BX1]     ,
                                         + vL[BX2]*vL[BX2]   ,
                                         + vL[BX3]*vL[BX3])  );
-      real ptR  = vR[PRS] + HALF_F* ( EXPAND(vR[BX1]*vR[BX1]     ,
+      realc ptR  = vR[PRS] + HALF_F* ( EXPAND(vR[BX1]*vR[BX1]     ,
                                         + vR[BX2]*vR[BX2]   ,
                                         + vR[BX3]*vR[BX3])  );
 #endif
 
       // 5-- Compute the flux from the left and right states
-      if (sl > 0) {
+      if (!branchless && sl > 0) {
 #pragma unroll
         for (int nv = 0 ; nv < Phys::nvar; nv++) {
           Flux(nv,k,j,i) = fluxL[nv];
         }
-      } else if (sr < 0) {
+      } else if (!branchless && sr < 0) {
 #pragma unroll
         for (int nv = 0 ; nv < Phys::nvar; nv++) {
           Flux(nv,k,j,i) = fluxR[nv];
         }
       } else {
-        real usL[Phys::nvar];
-        real usR[Phys::nvar];
+        realc usL[Phys::nvar];
+        realc usR[Phys::nvar];
 
-        real scrh, scrhL, scrhR, duL, duR, sBx, Bx, SM, S1L, S1R;
+        realc scrh, scrhL, scrhR, duL, duR, sBx, Bx, SM, S1L, S1R;
 
 #if HAVE_ENERGY
-        real Uhll[Phys::nvar];
-        real pts, sqrL, sqrR;
-        [[maybe_unused]] real vsL, vsR, wsL, wsR;
+        realc Uhll[Phys::nvar];
+        realc pts, sqrL, sqrR;
+        [[maybe_unused]] realc vsL, vsR, wsL, wsR;
 
         // 3c. Compute U*(L), U^*(R)
         scrh = ONE_F/(sr - sl);
@@ -323,7 +330,25 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
         if ( (S1L - sl) <  1.e-4*(SM - sl) ) revert_to_hllc = 1;
         if ( (S1R - sr) > -1.e-4*(sr - SM) ) revert_to_hllc = 1;
 
-        if (revert_to_hllc) {
+        if constexpr(branchless) {
+          // Both fields are computed, and the HLL one is kept on the degenerate faces
+          scrh = ONE_F/(sr - sl);
+          EXPAND( Uhll[BXn] = (sr*uR[BXn] - sl*uL[BXn] + fluxL[BXn] - fluxR[BXn])*scrh;  ,
+                  Uhll[BXt] = (sr*uR[BXt] - sl*uL[BXt] + fluxL[BXt] - fluxR[BXt])*scrh;  ,
+                  Uhll[BXb] = (sr*uR[BXb] - sl*uL[BXb] + fluxL[BXb] - fluxR[BXb])*scrh;  )
+
+          scrhL = (uL[RHO]*duL*duL - Bx*Bx)/(uL[RHO]*duL*(sl - SM) - Bx*Bx);
+          scrhR = (uR[RHO]*duR*duR - Bx*Bx)/(uR[RHO]*duR*(sr - SM) - Bx*Bx);
+
+          EXPAND( usL[BXn] = usR[BXn] = revert_to_hllc ? Uhll[BXn] : Bx;  ,
+                  usL[BXt] = revert_to_hllc ? Uhll[BXt] : uL[BXt]*scrhL;
+                  usR[BXt] = revert_to_hllc ? Uhll[BXt] : uR[BXt]*scrhR;  ,
+                  usL[BXb] = revert_to_hllc ? Uhll[BXb] : uL[BXb]*scrhL;
+                  usR[BXb] = revert_to_hllc ? Uhll[BXb] : uR[BXb]*scrhR;  )
+
+          S1L = revert_to_hllc ? SM : S1L;
+          S1R = revert_to_hllc ? SM : S1R;
+        } else if (revert_to_hllc) {
           scrh = ONE_F/(sr - sl);
 #pragma unroll
           for(int nv = 0 ; nv < Phys::nvar; nv++) {
@@ -385,21 +410,21 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
 
     // 3c. Compute flux when S1L > 0 or S1R < 0
 
-        if (S1L >= 0.0) {       //  ----  Region L*
+        if (!branchless && S1L >= 0.0) {       //  ----  Region L*
 #pragma unroll
           for(int nv = 0 ; nv < Phys::nvar; nv++) {
             Flux(nv,k,j,i) = fluxL[nv] + sl*(usL[nv] - uL[nv]);
           }
-        } else if (S1R <= 0.0) {    //  ----  Region R*
+        } else if (!branchless && S1R <= 0.0) {    //  ----  Region R*
 #pragma unroll
           for(int nv = 0 ; nv < Phys::nvar; nv++) {
             Flux(nv,k,j,i) = fluxR[nv] + sr*(usR[nv] - uR[nv]);
           }
         } else {   // -- This state exists only if B_x != 0
           // Compute U**
-          [[maybe_unused]]real vss, wss;
-          real ussl[Phys::nvar];
-          real ussr[Phys::nvar];
+          [[maybe_unused]]realc vss, wss;
+          realc ussl[Phys::nvar];
+          realc ussr[Phys::nvar];
 
           ussl[RHO] = usL[RHO];
           ussr[RHO] = usR[RHO];
@@ -442,7 +467,21 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
           ussr[ENG] = usR[ENG] + sqrR*scrhR*sBx;
 
 
-          if (SM >= 0.0) { //  ----  Region L**
+          if constexpr(branchless) {
+#pragma unroll
+            for(int nv = 0 ; nv < Phys::nvar; nv++) {
+              const realc fluxStarL = fluxL[nv] + sl*(usL[nv] - uL[nv]);
+              const realc fluxStarR = fluxR[nv] + sr*(usR[nv] - uR[nv]);
+              const realc fluxStar2 = (SM >= 0.0)
+                                      ? fluxL[nv] + S1L*(ussl[nv]  - usL[nv])
+                                        + sl*(usL[nv] - uL[nv])
+                                      : fluxR[nv] + S1R*(ussr[nv]  - usR[nv])
+                                        + sr*(usR[nv] - uR[nv]);
+              const realc fluxStar = (S1L >= 0.0) ? fluxStarL
+                                                  : ((S1R <= 0.0) ? fluxStarR : fluxStar2);
+              Flux(nv,k,j,i) = (sl > 0) ? fluxL[nv] : ((sr < 0) ? fluxR[nv] : fluxStar);
+            }
+          } else if (SM >= 0.0) { //  ----  Region L**
 #pragma unroll
             for(int nv = 0 ; nv < Phys::nvar; nv++) {
               Flux(nv,k,j,i) = fluxL[nv] + S1L*(ussl[nv]  - usL[nv])
@@ -457,8 +496,8 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
           }
         }  // end if (S1L < 0 S1R > 0)
 #else // No ENERGY
-        real usc[Phys::nvar];
-        real rho, sqrho;
+        realc usc[Phys::nvar];
+        realc rho, sqrho;
 
         scrh = ONE_F/(sr - sl);
         duL = sl - vL[Xn];
@@ -98,11 +98,11 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
   EquationOfState eos = *(hydro->eos.get());
 
   // TODO(baghdads) what is this delta?
-  real delta    = 1.e-6;
+  realc delta    = 1.e-6;
 
   // Define normal, tangent and bi-tanget indices
   // st and sb will be useful only when Hall is included
-  real st = ONE_F, sb = ONE_F;
+  realc st = ONE_F, sb = ONE_F;
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
@@ -172,6 +172,10 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
       IDEFIX_ERROR("Wrong direction");
   }
 
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  // (the EMF components stored for CT are not counted)
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc) + idfx::BytesPerCell(Vs),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("CalcRiemannFlux",
              data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
              data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
@@ -187,21 +191,21 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
               const int BXb = (DIR == KDIR ? BX2 : BX3);   )
 
       // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
-      real dV[Phys::nvar];
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
+      realc dV[Phys::nvar];
 
       // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
-      [[maybe_unused]] real dU[Phys::nvar];
+      realc uL[Phys::nvar];
+      realc uR[Phys::nvar];
+      [[maybe_unused]] realc dU[Phys::nvar];
 
       // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      realc fluxL[Phys::nvar];
+      realc fluxR[Phys::nvar];
 
       // Roe
-      real Rc[Phys::nvar][Phys::nvar];
+      realc Rc[Phys::nvar][Phys::nvar];
 
 
       // 1-- Store the primitive variables on the left, right, and averaged states
@@ -219,12 +223,12 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
       K_PrimToCons<Phys>(uR, vR, &eos);
 
       // --- Compute the square of the sound speed
-      real a, a2, a2L, a2R;
+      realc a, a2, a2L, a2R;
       #if HAVE_ENERGY
         // These are actually not used, but are initialised to avoid warnings
         a2L = ONE_F;
         a2R = ONE_F;
-        real gamma = eos.GetGamma(0.5*(vL[RHO]+vR[RHO]),0.5*(vL[PRS]+vR[PRS]));
+        realc gamma = eos.GetGamma(0.5*(vL[RHO]+vR[RHO]),0.5*(vL[PRS]+vR[PRS]));
       #else
         a2L = HALF_F*(eos.GetWaveSpeed(k,j,i)
                     +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
@@ -251,7 +255,7 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
         }
       }
 
-      real sqr_rho_L, sqr_rho_R, sl, sr, rho, sqrt_rho;
+      realc sqr_rho_L, sqr_rho_R, sl, sr, rho, sqrt_rho;
 
       // 6c. Compute Roe averages
       sqr_rho_L = std::sqrt(vL[RHO]);
@@ -266,7 +270,7 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
 
       sqrt_rho = std::sqrt(rho);
 
-      [[maybe_unused]] real u, v, w, Bx, By, Bz, sBx, bx, by, bz, bt2, b2, Btmag;
+      [[maybe_unused]] realc u, v, w, Bx, By, Bz, sBx, bx, by, bz, bt2, b2, Btmag;
 
       EXPAND ( u = sl*vL[Xn] + sr*vR[Xn];  ,
                v = sl*vL[Xt] + sr*vR[Xt];  ,
@@ -286,11 +290,11 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
       b2    = bx*bx + bt2;
       Btmag = std::sqrt(bt2*rho);
 
-      real X  = EXPAND(dV[BXn]*dV[BXn], + dV[BXt]*dV[BXt], + dV[BXb]*dV[BXb]);
+      realc X  = EXPAND(dV[BXn]*dV[BXn], + dV[BXt]*dV[BXt], + dV[BXb]*dV[BXb]);
       X /= (sqr_rho_L + sqr_rho_R)*(sqr_rho_L + sqr_rho_R)*2.0;
 
 
-      [[maybe_unused]] real Bmag2L, Bmag2R, pL, pR;
+      [[maybe_unused]] realc Bmag2L, Bmag2R, pL, pR;
       Bmag2L = EXPAND(vL[BX1]*vL[BX1] , + vL[BX2]*vL[BX2], + vL[BX3]*vL[BX3]);
       Bmag2R = EXPAND(vR[BX1]*vR[BX1] , + vR[BX2]*vR[BX2], + vR[BX3]*vR[BX3]);
 #if HAVE_ENERGY
@@ -303,8 +307,8 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
 
       // 6d. Compute enthalpy and sound speed.
 #if HAVE_ENERGY
-      real vel2, HL, HR, H, Hgas;
-      real vdm, BdB;
+      realc vel2, HL, HR, H, Hgas;
+      realc vdm, BdB;
 
       vdm = EXPAND(u*dU[Xn],  + v*dU[Xt],  + w*dU[Xb]);
       BdB = EXPAND(Bx*dU[BXn], + By*dU[BXt], + Bz*dU[BXb]);
@@ -341,7 +345,7 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
       characteristic speeds.
       ------------------------------------------------------------ */
 
-      [[maybe_unused]] real scrh, ca, cf, cs, ca2, cf2, cs2, alpha_f, alpha_s, beta_y, beta_z;
+      [[maybe_unused]] realc scrh, ca, cf, cs, ca2, cf2, cs2, alpha_f, alpha_s, beta_y, beta_z;
       scrh = a2 - b2;
       ca2  = bx*bx;
       scrh = scrh*scrh + 4.0*bt2*a2;
@@ -405,8 +409,8 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
       ------------------------------------------------------------------- */
 
       // Fast wave:  u - c_f
-      real lambda[NMODES], alambda[NMODES], eta[NMODES];
-      [[maybe_unused]] real beta_dv, beta_dB, beta_v;
+      realc lambda[NMODES], alambda[NMODES], eta[NMODES];
+      [[maybe_unused]] realc beta_dv, beta_dB, beta_v;
 
       int kk = KFASTM;
       lambda[kk] = u - cf;
@@ -594,7 +598,7 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
 
       // 6g. Compute maximum signal velocity
 
-      real cmax = std::fabs(u) + cf;
+      realc cmax = std::fabs(u) + cf;
 
       // 6h. Save max and min Riemann fan speeds for EMF computation.
       sl = lambda[KFASTM];
@@ -13,7 +13,7 @@
 
 template <const int DIR>
 KOKKOS_FORCEINLINE_FUNCTION void K_StoreEMF( const int i, const int j, const int k,
-                                        const real st, const real sb,
+                                        const realc st, const realc sb,
                                         const IdefixArray4D<real> &Flux,
                                         const IdefixArray3D<real> &Et,
                                         const IdefixArray3D<real> &Eb ) {
@@ -30,13 +30,13 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreEMF( const int i, const int j, const int
 
 template <const int DIR>
 KOKKOS_FORCEINLINE_FUNCTION void K_StoreContact( const int i, const int j, const int k,
-                                        const real st, const real sb,
+                                        const realc st, const realc sb,
                                         const IdefixArray4D<real> &Flux,
                                         const IdefixArray3D<real> &Et,
                                         const IdefixArray3D<real> &Eb,
                                         const IdefixArray3D<real> &SV) {
   K_StoreEMF<DIR>(i,j,k,st,sb,Flux,Et,Eb);
-  real s = HALF_F;
+  realc s = HALF_F;
   if (Flux(RHO,k,j,i) >  eps_UCT_CONTACT) s =  ONE_F;
   if (Flux(RHO,k,j,i) < -eps_UCT_CONTACT) s = ZERO_F;
 
@@ -45,9 +45,9 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreContact( const int i, const int j, const
 
 template <const int DIR>
 KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLL( const int i, const int j, const int k,
-                                        const real st, const real sb,
-                                        const real sl, const real sr,
-                                        real vL[], real vR[],
+                                        const realc st, const realc sb,
+                                        const realc sl, const realc sr,
+                                        realc vL[], realc vR[],
                                         const IdefixArray3D<real> &Et,
                                         const IdefixArray3D<real> &Eb,
                                         const IdefixArray3D<real> &aL,
@@ -58,9 +58,9 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLL( const int i, const int j, const int
         constexpr int Xt = (DIR == IDIR ? MX2 : MX1);  ,
         constexpr int Xb = (DIR == KDIR ? MX2 : MX3);  )
 
-  real ar = std::fmax(ZERO_F, sr);
-  real al = std::fmin(ZERO_F, sl);
-  real scrh = ONE_F/(ar - al);
+  realc ar = std::fmax(ZERO_F, sr);
+  realc al = std::fmin(ZERO_F, sl);
+  realc scrh = ONE_F/(ar - al);
 
   #if COMPONENTS > 1
   EXPAND( Et(k,j,i) = -st*(ar*vL[Xt] - al*vR[Xt])*scrh;  ,
@@ -76,11 +76,11 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLL( const int i, const int j, const int
 
 template <const int DIR>
 KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLLD( const int i, const int j, const int k,
-                                        const real st, const real sb,
-                                        const real c2Iso,
-                                        const real sl, const real sr,
-                                        real vL[], real vR[],
-                                        real uL[], real uR[],
+                                        const realc st, const realc sb,
+                                        const realc c2Iso,
+                                        const realc sl, const realc sr,
+                                        realc vL[], realc vR[],
+                                        realc uL[], realc uR[],
                                         const IdefixArray3D<real> &Et,
                                         const IdefixArray3D<real> &Eb,
                                         const IdefixArray3D<real> &aL,
@@ -91,7 +91,7 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLLD( const int i, const int j, const in
         const int Xt = (DIR == IDIR ? MX2 : MX1);  ,
         const int Xb = (DIR == KDIR ? MX2 : MX3);  )
   // Compute magnetic pressure
-  [[maybe_unused]] real ptR, ptL;
+  [[maybe_unused]] realc ptR, ptL;
 
   #if HAVE_ENERGY
     ptL  = vL[PRS] + HALF_F* ( EXPAND(vL[BX1]*vL[BX1]     ,
@@ -113,19 +113,19 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLLD( const int i, const int j, const in
 
   const int BXn = DIR+BX1;
 
-  real Bn = (sr*vR[BXn] - sl*vL[BXn])/(sr - sl);
+  realc Bn = (sr*vR[BXn] - sl*vL[BXn])/(sr - sl);
 
-  real chiL, chiR, nuLR, nuL, nuR, SaL, SaR;
-  real Sc;
-  real eps = 1.e-12*(fabs(sl) + fabs(sr));
-  real duL  = sl - vL[Xn];
-  real duR  = sr - vR[Xn];
+  realc chiL, chiR, nuLR, nuL, nuR, SaL, SaR;
+  realc Sc;
+  realc eps = 1.e-12*(fabs(sl) + fabs(sr));
+  realc duL  = sl - vL[Xn];
+  realc duR  = sr - vR[Xn];
 
 #if HAVE_ENERGY
   // Recompute speeds
-  real sqrL, sqrR, usLRHO, usRRHO;
+  realc sqrL, sqrR, usLRHO, usRRHO;
 
-  real scrh  = ONE_F/(duR*uR[RHO] - duL*uL[RHO]);
+  realc scrh  = ONE_F/(duR*uR[RHO] - duL*uL[RHO]);
   Sc = (duR*uR[Xn] - duL*uL[Xn] - ptR + ptL)*scrh;
 
   usLRHO = uL[RHO]*duL/(sl - Sc);
@@ -143,11 +143,11 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLLD( const int i, const int j, const in
   chiL  = (vL[Xn] - Sc)*(sl - Sc)/(SaL + sl - TWO_F*Sc);
   chiR  = (vR[Xn] - Sc)*(sr - Sc)/(SaR + sr - TWO_F*Sc);
 #else
-  real scrh    = ONE_F/(sr - sl);
-  real rho_h   = (uR[RHO]*duR - uL[RHO]*duL)*scrh;
+  realc scrh    = ONE_F/(sr - sl);
+  realc rho_h   = (uR[RHO]*duR - uL[RHO]*duL)*scrh;
   Sc = (sl*uR[RHO]*duR - sr*uL[RHO]*duL)*scrh/rho_h;
   // Recompute speeds
-  real sqrho_h = sqrt(rho_h);
+  realc sqrho_h = sqrt(rho_h);
   SaL = Sc - fabs(Bn)/sqrho_h;
   SaR = Sc + fabs(Bn)/sqrho_h;
 
@@ -179,8 +179,8 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLLD( const int i, const int j, const in
     aR(k,j,i) = HALF_F;
   }
 
-  real ar = std::fmax(ZERO_F, sr);
-  real al = std::fmin(ZERO_F, sl);
+  realc ar = std::fmax(ZERO_F, sr);
+  realc al = std::fmin(ZERO_F, sl);
   scrh = ONE_F/(ar - al);
 
   // HLL diffusion coefficients
@@ -193,7 +193,7 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreHLLD( const int i, const int j, const in
 
   // Lax-Friedrichs diffusion coefficients
   if(0) {
-    real lambda = std::fmax(sr,sl);
+    realc lambda = std::fmax(sr,sl);
     aL(k,j,i) = HALF_F;
     aR(k,j,i) = HALF_F;
     dR(k,j,i) = HALF_F*lambda;
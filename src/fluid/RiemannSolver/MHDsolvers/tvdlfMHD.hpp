@@ -67,7 +67,7 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
   // Define normal, tangent and bi-tanget indices
   // st and sb will be useful only when Hall is included
-  real st = ONE_F, sb = ONE_F;
+  realc st = ONE_F, sb = ONE_F;
 
   switch(DIR) {
     case(IDIR):
@@ -135,6 +135,10 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
       IDEFIX_ERROR("Wrong direction");
   }
 
+  // Reconstructed states (the stencil is read once from cache), fluxes and signal speeds
+  // (the EMF components stored for CT are not counted)
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc) + idfx::BytesPerCell(Vs),
+                       idfx::BytesPerCell(Flux) + idfx::BytesPerCell(cMax));
   idefix_for("CalcRiemannFlux",
              data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
              data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
@@ -146,15 +150,15 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
               const int BXt = (DIR == IDIR ? BX2 : BX1);  ,
               const int BXb = (DIR == KDIR ? BX2 : BX3);   )
       // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
-      real v[Phys::nvar];
+      realc vL[Phys::nvar];
+      realc vR[Phys::nvar];
+      realc v[Phys::nvar];
 
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+      realc uL[Phys::nvar];
+      realc uR[Phys::nvar];
 
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+      realc fluxL[Phys::nvar];
+      realc fluxR[Phys::nvar];
 
       // Load primitive variables
       extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
@@ -167,14 +171,14 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
 
       // Get the wave speed
       // Signal speeds
-      real cRL, cmax, c2Iso;
-      real gpr, Bt2, B2;
+      realc cRL, cmax, c2Iso;
+      realc gpr, Bt2, B2;
 
       // Init c2Isothermal (used only when isothermal approx is set)
       c2Iso = ZERO_F;
 
 #if HAVE_ENERGY
-      real gamma = eos.GetGamma(v[PRS],v[RHO]);
+      realc gamma = eos.GetGamma(v[PRS],v[RHO]);
       gpr=gamma*v[PRS];
 #else
       c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
@@ -195,7 +199,7 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
 
       cmax = std::fmax(std::fabs(v[Xn]+cRL),FABS(v[Xn]-cRL));
 
-      real sl, sr;
+      realc sl, sr;
       sl = -cmax;
       sr = cmax;
 
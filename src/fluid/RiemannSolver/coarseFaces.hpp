@@ -0,0 +1,124 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_RIEMANNSOLVER_COARSEFACES_HPP_
+#define FLUID_RIEMANNSOLVER_COARSEFACES_HPP_
+
+#include "idefix.hpp"
+#include "dataBlock.hpp"
+#include "flux.hpp"
+#include "convertConsToPrim.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Faces lying inside a group of coarsened cells along direction dir.
+/// Since the flow is averaged over each group before the stage (DataBlock::SetBoundaries),
+/// the left and right states reconstructed on these faces are identical (with first and second
+/// order reconstructions), so that the Riemann problem is trivial. The solvers then skip the
+/// reconstruction and the Riemann solve on these faces, and use the physical flux of the cell
+/// state instead. Only the fluxes through the boundaries of each group are fully computed.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Phys, int dir>
+class CoarseFaces {
+ public:
+  CoarseFaces(DataBlock *data, IdefixArray4D<real> &VcIn, EquationOfState *eosIn) : Vc{VcIn} {
+    if(!data->haveGridCoarsening || !data->coarseningDirection[dir]) return;
+
+    // Higher order reconstructions involve cells outside of the group on interior faces
+    #if ORDER > 2
+      return;
+    #endif
+
+    // The flow is only guaranteed to be uniform in the groups of the last coarsened direction,
+    // since CoarsenFlow averages each direction in turn.
+    for(int d = dir+1 ; d < DIMENSIONS ; d++) {
+      if(data->coarseningDirection[d]) return;
+    }
+
+    // Fargo subtracts a mean velocity which is only uniform along the mean advection direction
+    if(data->haveFargo) {
+      #if GEOMETRY == SPHERICAL
+        if(dir != KDIR) return;
+      #else
+        if(dir != JDIR) return;
+      #endif
+    }
+
+    isActive = true;
+    level = data->coarseningLevel[dir];
+    begDir = data->beg[dir];
+    if(eosIn != nullptr) eos = *eosIn;
+  }
+
+  // Whether face (k,j,i) (on the left of cell (k,j,i)) is interior to a coarsened group
+  KOKKOS_INLINE_FUNCTION bool IsInterior(const int k, const int j, const int i) const {
+    if(!isActive) return(false);
+    int factor, index;
+    //factor = 2^(coarsening-1)
+    if constexpr(dir==IDIR) {
+      factor = 1 << (level(k,j) - 1);
+      index = i;
+    }
+    if constexpr(dir==JDIR) {
+      factor = 1 << (level(k,i) - 1);
+      index = j;
+    }
+    if constexpr(dir==KDIR) {
+      factor = 1 << (level(j,i) - 1);
+      index = k;
+    }
+    return((index-begDir)%factor != 0);
+  }
+
+  // Physical flux and signal speed of the (uniform) state on the left of face (k,j,i)
+  KOKKOS_INLINE_FUNCTION void SetFlux(const int k, const int j, const int i,
+                                      const IdefixArray4D<real> &Flux,
+                                      const IdefixArray3D<real> &cMax) const {
+    constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+    constexpr int joffset = (dir==JDIR) ? 1 : 0;
+    constexpr int koffset = (dir==KDIR) ? 1 : 0;
+    constexpr int Xn = dir+MX1;
+
+    realc v[Phys::nvar];
+    realc u[Phys::nvar];
+    realc flux[Phys::nvar];
+
+#pragma unroll
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      v[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset);
+    }
+
+    realc c = ZERO_F;
+    if constexpr(Phys::dust) {
+      K_PrimToCons<Phys>(u, v, NULL);
+    } else {
+      // Same wave speed as the one the solvers would use with vL=vR
+      #if HAVE_ENERGY
+        c = std::sqrt(eos.GetGamma(v[PRS],v[RHO])*(v[PRS]/v[RHO]));
+      #else
+        c = HALF_F*(eos.GetWaveSpeed(k,j,i)
+                   +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
+      #endif
+      K_PrimToCons<Phys>(u, v, &eos);
+    }
+    K_Flux<Phys,dir>(flux, v, u, c*c);
+
+#pragma unroll
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      Flux(nv,k,j,i) = flux[nv];
+    }
+    cMax(k,j,i) = FABS(v[Xn]) + c;
+  }
+
+ private:
+  bool isActive{false};
+  IdefixArray2D<int> level;
+  int begDir{0};
+  IdefixArray4D<real> Vc;
+  EquationOfState eos;
+};
+
+#endif // FLUID_RIEMANNSOLVER_COARSEFACES_HPP_
@@ -75,7 +75,9 @@ class ExtrapolateToFaces {
   KOKKOS_FORCEINLINE_FUNCTION void ExtrapolatePrimVar(const int i,
                                                     const int j,
                                                     const int k,
-                                                    real vL[], real vR[]) const {
+                                                    realc vL[], realc vR[],
+                                                    const int o = 0) const {
+    // o is the index of the first variable of the fluid in Vc (for species-batched dust)
     // 1-- Store the primitive variables on the left, right, and averaged states
     constexpr int ioffset = (dir==IDIR ? 1 : 0);
     constexpr int joffset = (dir==JDIR ? 1 : 0);
@@ -83,18 +85,18 @@ class ExtrapolateToFaces {
 
     for(int nv = 0 ; nv < Phys::nvar ; nv++) {
       if constexpr(order == 1) {
-        vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset);
-        vR[nv] = Vc(nv,k,j,i);
+        vL[nv] = Vc(o+nv,k-koffset,j-joffset,i-ioffset);
+        vR[nv] = Vc(o+nv,k,j,i);
       } else if constexpr(order == 2) {
         if(isRegularGrid) {
           /////////////////////////////////////
           // Regular Grid, PLM reconstruction
           /////////////////////////////////////
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          realc dvm = Vc(o+nv,k-koffset,j-joffset,i-ioffset)
+                    -Vc(o+nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+          realc dvp = Vc(o+nv,k,j,i)-Vc(o+nv,k-koffset,j-joffset,i-ioffset);
 
-          real dv;
+          realc dv;
           if(shockFlattening) {
             if(flags(k-koffset,j-joffset,i-ioffset) == FlagShock::Shock) {
               // Force slope limiter to minmod
@@ -106,10 +108,10 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm);
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+          vL[nv] = Vc(o+nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
 
           dvm = dvp;
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvp = Vc(o+nv,k+koffset,j+joffset,i+ioffset) - Vc(o+nv,k,j,i);
 
           if(shockFlattening) {
             if(flags(k,j,i) == FlagShock::Shock) {
@@ -121,23 +123,23 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm);
           }
 
-          vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+          vR[nv] = Vc(o+nv,k,j,i) - HALF_F*dv;
         } else {
           /////////////////////////////////////
           // Irregular Grid, PLM reconstruction
           /////////////////////////////////////
           const int index = ioffset*i + joffset*j + koffset*k;
 
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          realc dvm = Vc(o+nv,k-koffset,j-joffset,i-ioffset)
+                    -Vc(o+nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+          realc dvp = Vc(o+nv,k,j,i)-Vc(o+nv,k-koffset,j-joffset,i-ioffset);
 
           dvm *= wmArray(index-1);
           dvp *= wpArray(index-1);
-          real cp = cpArray(index-1);
-          real cm = cmArray(index-1);
+          realc cp = cpArray(index-1);
+          realc cm = cmArray(index-1);
 
-          real dv;
+          realc dv;
           if(shockFlattening) {
             if(flags(k-koffset,j-joffset,i-ioffset) == FlagShock::Shock) {
               // Force slope limiter to minmod
@@ -149,10 +151,10 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm,cp,cm);
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + dpArray(index-1)*dv;
+          vL[nv] = Vc(o+nv,k-koffset,j-joffset,i-ioffset) + dpArray(index-1)*dv;
 
-          dvm = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvm = Vc(o+nv,k,j,i)-Vc(o+nv,k-koffset,j-joffset,i-ioffset);
+          dvp = Vc(o+nv,k+koffset,j+joffset,i+ioffset) - Vc(o+nv,k,j,i);
           dvm *= wmArray(index);
           dvp *= wpArray(index);
           cp = cpArray(index);
@@ -167,18 +169,18 @@ class ExtrapolateToFaces {
           } else { // No shock flattening
             dv = SL::PLMLim(dvp,dvm,cp,cm);
           }
-          vR[nv] = Vc(nv,k,j,i) - dmArray(index)*dv;
+          vR[nv] = Vc(o+nv,k,j,i) - dmArray(index)*dv;
         } // Regular grid
 
       } else if constexpr(order == 3) {
           // 1D index along the chosen direction
           const int index = ioffset*i + joffset*j + koffset*k;
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          realc dvm = Vc(o+nv,k-koffset,j-joffset,i-ioffset)
+                    -Vc(o+nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+          realc dvp = Vc(o+nv,k,j,i)-Vc(o+nv,k-koffset,j-joffset,i-ioffset);
 
           // Limo3 limiter
-          real dv;
+          realc dv;
           if(shockFlattening) {
             if(flags(k-koffset,j-joffset,i-ioffset) == FlagShock::Shock) {
               // Force slope limiter to minmod
@@ -190,14 +192,14 @@ class ExtrapolateToFaces {
               dv = dvp * SL::LimO3Lim(dvp, dvm, dx(index-1));
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+          vL[nv] = Vc(o+nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
 
           // Check positivity
           if(nv==RHO) {
             // If face element is negative, revert to minmod
             if(vL[nv] <= 0.0) {
               dv = SL::MinModLim(dvp,dvm);
-              vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+              vL[nv] = Vc(o+nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
             }
           }
           if constexpr(Phys::pressure) {
@@ -205,13 +207,13 @@ class ExtrapolateToFaces {
               // If face element is negative, revert to minmod
               if(vL[nv] <= 0.0) {
                 dv = SL::MinModLim(dvp,dvm);
-                vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+                vL[nv] = Vc(o+nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
               }
             }
           }
 
           dvm = dvp;
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvp = Vc(o+nv,k+koffset,j+joffset,i+ioffset) - Vc(o+nv,k,j,i);
 
           // Limo3 limiter
           if(shockFlattening) {
@@ -225,14 +227,14 @@ class ExtrapolateToFaces {
             dv = dvm * SL::LimO3Lim(dvm, dvp, dx(index));
           }
 
-          vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+          vR[nv] = Vc(o+nv,k,j,i) - HALF_F*dv;
 
           // Check positivity
           if(nv==RHO) {
             // If face element is negative, revert to vanleer
             if(vR[nv] <= 0.0) {
               dv = SL::MinModLim(dvp,dvm);
-              vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+              vR[nv] = Vc(o+nv,k,j,i) - HALF_F*dv;
             }
           }
           if constexpr(Phys::pressure) {
@@ -240,19 +242,19 @@ class ExtrapolateToFaces {
               // If face element is negative, revert to vanleer
               if(vR[nv] <= 0.0) {
                 dv = SL::MinModLim(dvp,dvm);
-                vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+                vR[nv] = Vc(o+nv,k,j,i) - HALF_F*dv;
               }
             }
           }
       } else if constexpr(order == 4) {
           // Reconstruction in cell i-1
-          real vm2 = Vc(nv,k-3*koffset,j-3*joffset,i-3*ioffset);;
-          real vm1 = Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real v0 = Vc(nv,k-koffset,j-joffset,i-ioffset);
-          real vp1 = Vc(nv,k,j,i);
-          real vp2 = Vc(nv,k+koffset,j+joffset,i+ioffset);
+          realc vm2 = Vc(o+nv,k-3*koffset,j-3*joffset,i-3*ioffset);;
+          realc vm1 = Vc(o+nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+          realc v0 = Vc(o+nv,k-koffset,j-joffset,i-ioffset);
+          realc vp1 = Vc(o+nv,k,j,i);
+          realc vp2 = Vc(o+nv,k+koffset,j+joffset,i+ioffset);
 
-          real vr,vl;
+          realc vr,vl;
           SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
           // vL= left side of current interface (i-1/2)= right side of cell i-1
 
@@ -260,7 +262,7 @@ class ExtrapolateToFaces {
           if(nv==RHO) {
             // If face element is negative, revert to vanleer
             if(vr <= 0.0) {
-              real dv = SL::PLMLim(vp1-v0,v0-vm1);
+              realc dv = SL::PLMLim(vp1-v0,v0-vm1);
               vr = v0+HALF_F*dv;
             }
           }
@@ -268,7 +270,7 @@ class ExtrapolateToFaces {
             if(nv==PRS) {
               // If face element is negative, revert to vanleer
               if(vr <= 0.0) {
-                real dv = SL::PLMLim(vp1-v0,v0-vm1);
+                realc dv = SL::PLMLim(vp1-v0,v0-vm1);
                 vr = v0+HALF_F*dv;
               }
             }
@@ -281,7 +283,7 @@ class ExtrapolateToFaces {
           vm1 = v0;
           v0 = vp1;
           vp1 = vp2;
-          vp2 = Vc(nv,k+2*koffset,j+2*joffset,i+2*ioffset);
+          vp2 = Vc(o+nv,k+2*koffset,j+2*joffset,i+2*ioffset);
 
           SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
 
@@ -289,7 +291,7 @@ class ExtrapolateToFaces {
           if(nv==RHO) {
             // If face element is negative, revert to vanleer
             if(vl <= 0.0) {
-              real dv = SL::PLMLim(vp1-v0,v0-vm1);
+              realc dv = SL::PLMLim(vp1-v0,v0-vm1);
               vl = v0-HALF_F*dv;
             }
           }
@@ -297,7 +299,7 @@ class ExtrapolateToFaces {
             if(nv==PRS) {
               // If face element is negative, revert to vanleer
               if(vl <= 0.0) {
-                real dv = SL::PLMLim(vp1-v0,v0-vm1);
+                realc dv = SL::PLMLim(vp1-v0,v0-vm1);
                 vl = v0-HALF_F*dv;
               }
             }
@@ -14,7 +14,7 @@
 // Local Kokkos Inlined functions
 
 /********************************************************************************************
- * @fn void K_Flux(real F[], real V[], real U[], real Cs2Iso,
+ * @fn void K_Flux(realc F[], realc V[], realc U[], realc Cs2Iso,
  *                                  const int Xn, const int Xt, const int Xb,
  *                                  const int BXn, const int BXt, const int BXb)
  * @param F[]   Array of flux variables (output)
@@ -26,8 +26,8 @@
  *  This routine computes the MHD out of V and U variables and stores it in F
  ********************************************************************************************/
 template<typename Phys, int DIR>
-KOKKOS_INLINE_FUNCTION void K_Flux(real *KOKKOS_RESTRICT F, const real *KOKKOS_RESTRICT V,
-                                   const real *KOKKOS_RESTRICT U, real Cs2Iso) {
+KOKKOS_INLINE_FUNCTION void K_Flux(realc *KOKKOS_RESTRICT F, const realc *KOKKOS_RESTRICT V,
+                                   const realc *KOKKOS_RESTRICT U, realc Cs2Iso) {
   constexpr int Xn = DIR+MX1;
   [[maybe_unused]] constexpr int BXn = DIR+BX1;
 
@@ -62,12 +62,12 @@ KOKKOS_INLINE_FUNCTION void K_Flux(real *KOKKOS_RESTRICT F, const real *KOKKOS_R
 
   if constexpr(Phys::pressure || Phys::isothermal) {
     // Pressure-related term
-    real ptot;
+    realc ptot;
     if constexpr(Phys::mhd) {
       ////////////////
       // MHD VERSION
       ///////////////
-      real Bmag2 = EXPAND(V[BX1]*V[BX1] , + V[BX2]*V[BX2], + V[BX3]*V[BX3]);
+      realc Bmag2 = EXPAND(V[BX1]*V[BX1] , + V[BX2]*V[BX2], + V[BX3]*V[BX3]);
       if constexpr(Phys::pressure) {
         ptot  = V[PRS] + HALF_F*Bmag2;
         // Energy flux
@@ -14,6 +14,14 @@
 #include "fluid.hpp"
 #include "input.hpp"
 
+// Whether the HLL-type solvers select the flux of each region with masked selects instead of
+// branches, so that the compiler can vectorise the face loop on CPUs (Idefix_RIEMANN_BRANCHLESS)
+#ifdef RIEMANN_BRANCHLESS
+  constexpr bool riemannBranchless = true;
+#else
+  constexpr bool riemannBranchless = false;
+#endif
+
 // Forward declaration
 template<typename Phys>
 class ShockFlattening;
@@ -137,8 +145,9 @@ RiemannSolver<Phys>::RiemannSolver(Input &input, Fluid<Phys>* hydro) : Vc{hydro-
       }
       IDEFIX_ERROR(msg);
     }
-    // Check if Hall is enabled
-    if(input.CheckEntry(std::string(Phys::prefix),"hall")>=0) {
+    // Check if Hall is enabled (sub-cycled Hall does not involve the Riemann solver)
+    if(input.CheckEntry(std::string(Phys::prefix),"hall")>=0 &&
+       input.Get<std::string>(std::string(Phys::prefix),"hall",0).compare("subcycle") != 0) {
         // Check consistency
         if(mySolver != HLL_MHD )
           IDEFIX_ERROR("Hall effect is only compatible with HLL Riemann solver.");
@@ -206,6 +215,9 @@ void RiemannSolver<Phys>::ShowConfig() {
   if(haveShockFlattening) {
     idfx::cout << Phys::prefix << ": Shock Flattening ENABLED." << std::endl;
   }
+  if constexpr(riemannBranchless) {
+    idfx::cout << "RiemannSolver: branch-free flux selection ENABLED." << std::endl;
+  }
 }
 
 template <typename Phys>
@@ -13,19 +13,20 @@ enum class PLMLimiter {VanLeer, MinMod, McLim};
 template<const PLMLimiter limiter = PLMLimiter::VanLeer>
 class SlopeLimiter {
  public:
-  KOKKOS_FORCEINLINE_FUNCTION static real MinModLim(const real dvp, const real dvm) {
-    real dq= 0.0;
+  KOKKOS_FORCEINLINE_FUNCTION static realc MinModLim(const realc dvp, const realc dvm) {
+    realc dq= 0.0;
     // MinMod
     if(dvp*dvm >0.0) {
-      real dq = ( fabs(dvp) < fabs(dvm) ? dvp : dvm);
+      realc dq = ( fabs(dvp) < fabs(dvm) ? dvp : dvm);
     }
     return(dq);
   }
 
-  KOKKOS_FORCEINLINE_FUNCTION real static LimO3Lim(const real dvp, const real dvm, const real dx) {
-    real r = 0.1;
-    real a,b,c,q, th, lim;
-    real eta, psi, eps = 1.e-12;
+  KOKKOS_FORCEINLINE_FUNCTION realc static LimO3Lim(const realc dvp, const realc dvm,
+                                                     const realc dx) {
+    realc r = 0.1;
+    realc a,b,c,q, th, lim;
+    realc eta, psi, eps = 1.e-12;
 
     th  = dvm/(dvp + 1.e-16);
 
@@ -51,51 +52,51 @@ class SlopeLimiter {
     return (lim);
   }
 
-  KOKKOS_FORCEINLINE_FUNCTION static real VanLeerLim(const real dvp, const real dvm) {
-    real dq = (dvp*dvm > ZERO_F ? TWO_F*dvp*dvm/(dvp + dvm) : ZERO_F);
+  KOKKOS_FORCEINLINE_FUNCTION static realc VanLeerLim(const realc dvp, const realc dvm) {
+    realc dq = (dvp*dvm > ZERO_F ? TWO_F*dvp*dvm/(dvp + dvm) : ZERO_F);
     return(dq);
   }
 
   // Generalize vanleer for non-homogeneous grids
-  KOKKOS_FORCEINLINE_FUNCTION static real VanLeerLim(const real dvp, const real dvm,
-                                              const real cp , const real cm) {
-    real dq = (dvp*dvm > 0.0 ? dvp*dvm*(cp*dvm + cm*dvp)
+  KOKKOS_FORCEINLINE_FUNCTION static realc VanLeerLim(const realc dvp, const realc dvm,
+                                              const realc cp , const realc cm) {
+    realc dq = (dvp*dvm > 0.0 ? dvp*dvm*(cp*dvm + cm*dvp)
                        /(dvp*dvp + dvm*dvm + (cp + cm - 2.0)*dvp*dvm) : 0.0);
     return dq;
   }
 
-  KOKKOS_FORCEINLINE_FUNCTION static real McLim(const real dvp, const real dvm) {
-    real dq = 0;
+  KOKKOS_FORCEINLINE_FUNCTION static realc McLim(const realc dvp, const realc dvm) {
+    realc dq = 0;
     if(dvp*dvm >0.0) {
-      real dqc = 0.5*(dvp+dvm);
-      real d2q = 2.0*( fabs(dvp) < fabs(dvm) ? dvp : dvm);
+      realc dqc = 0.5*(dvp+dvm);
+      realc d2q = 2.0*( fabs(dvp) < fabs(dvm) ? dvp : dvm);
       dq= fabs(d2q) < fabs(dqc) ? d2q : dqc;
     }
     return(dq);
   }
 
   // Generalized McLimiter for non-homogeneous grid
-  KOKKOS_FORCEINLINE_FUNCTION static real McLim(const real dvp, const real dvm,
-                                          const real cp , const real cm) {
-    real dq = 0;
+  KOKKOS_FORCEINLINE_FUNCTION static realc McLim(const realc dvp, const realc dvm,
+                                          const realc cp , const realc cm) {
+    realc dq = 0;
     if(dvp*dvm >0.0) {
-      real dqc = 0.5*(dvp+dvm);
-      real d2q =  fabs(dvp*cp) < fabs(dvm*cm) ? dvp*cp : dvm*cm;
+      realc dqc = 0.5*(dvp+dvm);
+      realc d2q =  fabs(dvp*cp) < fabs(dvm*cm) ? dvp*cp : dvm*cm;
       dq= fabs(d2q) < fabs(dqc) ? d2q : dqc;
     }
     return(dq);
   }
 
 
-  KOKKOS_FORCEINLINE_FUNCTION static real PLMLim(const real dvp, const real dvm) {
+  KOKKOS_FORCEINLINE_FUNCTION static realc PLMLim(const realc dvp, const realc dvm) {
     if constexpr(limiter == PLMLimiter::VanLeer) return(VanLeerLim(dvp,dvm));
     if constexpr(limiter == PLMLimiter::McLim) return(McLim(dvp,dvm));
     if constexpr(limiter == PLMLimiter::MinMod) return(MinModLim(dvp,dvm));
   }
 
   // Overlad of PLM limiter for irregular grids
-  KOKKOS_FORCEINLINE_FUNCTION static real PLMLim(const real dvp, const real dvm,
-                                          const real cp, const real cm) {
+  KOKKOS_FORCEINLINE_FUNCTION static realc PLMLim(const realc dvp, const realc dvm,
+                                          const realc cp, const realc cm) {
     if constexpr(limiter == PLMLimiter::VanLeer) return(VanLeerLim(dvp,dvm,cp,cm));
     if constexpr(limiter == PLMLimiter::McLim) return(McLim(dvp,dvm,cp,cm));
     if constexpr(limiter == PLMLimiter::MinMod) return(MinModLim(dvp,dvm));
@@ -118,20 +119,21 @@ class SlopeLimiter {
   // FS18: Felker, K. G. & Stone, J. M. A fourth-order accurate finite volume method for ideal MHD
   //       via upwind constrained transport. Journal of Computational Physics 375, 1365–1400 (2018).
 
-  KOKKOS_FORCEINLINE_FUNCTION static void limitPPMFaceValues(const real vm1, const real v0,
-                                                      const real vp1, const real vp2, real &vph) {
+  KOKKOS_FORCEINLINE_FUNCTION static void limitPPMFaceValues(const realc vm1, const realc v0,
+                                                      const realc vp1, const realc vp2,
+                                                      realc &vph) {
     // if local extremum, then use limited curvature estimate
     if( (vp1-vph)*(vph-v0) < 0.0) {
       // CD11, eqns. 85
-      const real deltaL = (vm1-2*v0+vp1);
-      const real deltaC = 3*(v0-2*vph+vp1);
-      const real deltaR = (v0-2*vp1+vp2);
+      const realc deltaL = (vm1-2*v0+vp1);
+      const realc deltaC = 3*(v0-2*vph+vp1);
+      const realc deltaR = (v0-2*vp1+vp2);
       // Compute limited curvature estimate
-      real delta = 0.0;
+      realc delta = 0.0;
 
       // CS08 eq. 18 with corrections from FS18 section. 2.2.2
       if(sign(deltaL) == sign(deltaC) && sign(deltaR) == sign(deltaC)) {
-        const real C = 1.25;
+        const realc C = 1.25;
         delta = C * FMIN(FABS(deltaL), FABS(deltaR));
         delta = sign(deltaC) * FMIN(delta, FABS(deltaC));
       }
@@ -139,9 +141,9 @@ class SlopeLimiter {
     }
   }
 
-  KOKKOS_FORCEINLINE_FUNCTION static void getPPMStates(const real vm2, const real vm1,
-                                                      const real v0, const real vp1, const real vp2,
-                                                      real &vl, real &vr) {
+  KOKKOS_FORCEINLINE_FUNCTION static void getPPMStates(const realc vm2, const realc vm1,
+                                                      const realc v0, const realc vp1,
+                                                      const realc vp2, realc &vl, realc &vr) {
     const int n = 2;
 
     // 1: unlimited left and right interpolant (PH13 3.26-3.27)
@@ -152,22 +154,22 @@ class SlopeLimiter {
     limitPPMFaceValues(vm2,vm1,v0,vp1,vl);
     limitPPMFaceValues(vm1,v0,vp1,vp2,vr);
 
-    real d2qf = 6.0*(vl + vr - 2.0*v0);
-    real d2qc0 = vm1 + vp1 - 2.0*v0;
-    real d2qcp1 = v0 + vp2 - 2.0*vp1;
-    real d2qcm1 = vm2 + v0 - 2.0*vm1;
+    realc d2qf = 6.0*(vl + vr - 2.0*v0);
+    realc d2qc0 = vm1 + vp1 - 2.0*v0;
+    realc d2qcp1 = v0 + vp2 - 2.0*vp1;
+    realc d2qcm1 = vm2 + v0 - 2.0*vm1;
 
-    real d2q = 0.0;
+    realc d2q = 0.0;
     if(sign(d2qf) == sign(d2qc0) && sign(d2qf) == sign(d2qcp1) && sign(d2qf) == sign(d2qcm1)) {
       // smooth extrememum
-      const real C = 1.25;
+      const realc C = 1.25;
       d2q = FMIN(FABS(d2qc0),FABS(d2qcp1));
       d2q = C * FMIN(FABS(d2qcm1), d2q);
       d2q = sign(d2qf) * FMIN(FABS(d2qf), d2q);
     }
 
-    real qmax = FMAX(FMAX(FABS(vm1),FABS(v0)),FABS(vp1));
-    real rho = 0.0;
+    realc qmax = FMAX(FMAX(FABS(vm1),FABS(v0)),FABS(vp1));
+    realc rho = 0.0;
     // todo(GL): replace 1e-12 by mixed precision value
     if(FABS(d2qf) > 1e-12*qmax) {
       rho = d2q / d2qf;
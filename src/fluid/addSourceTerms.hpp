@@ -42,6 +42,12 @@ struct Fluid_AddSourceTermsFunctor {
     }
     // shearing box (only with fargo&cartesian)
     sbS = hydro->sbS;
+
+    // Active regions of the dust species
+    if constexpr(Phys::dust) {
+      mask = hydro->activeMask;
+      species = hydro->instanceNumber;
+    }
   }
 
   //*****************************************************************
@@ -72,10 +78,19 @@ struct Fluid_AddSourceTermsFunctor {
   // shearing box (only with fargo&cartesian)
   real sbS;
 
+  // Active regions of the dust species
+  DustMask mask;
+  int species{0};
+
   //*****************************************************************
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    // Inactive dust is left untouched
+    if constexpr(Phys::dust) {
+      if(!mask.IsActive(species,k,j,i)) return;
+    }
+
     #if GEOMETRY == CARTESIAN
       // Manually add Coriolis force in cartesian geometry. Otherwise
       // Coriolis is treated as a modification to the fluxes
@@ -148,10 +148,10 @@ Boundary<Phys>::Boundary(Fluid<Phys>* fluid) {
     // using np_tot[...]+1 points to allow this buffer to represent
     // fields that are defined on faces
     sBArray = IdefixArray4D<real>("ShearingBoxArray",
-                                  nVar,
+                                  idfx::ArrayLayout4D(nVar,
                                   data->np_tot[KDIR]+1,
                                   data->np_tot[JDIR]+1,
-                                  data->nghost[IDIR]);
+                                  data->nghost[IDIR]));
   }
 
   // Init MPI stack when needed
@@ -202,12 +202,19 @@ void Boundary<Phys>::EnrollFluxBoundary(UserDefBoundaryFuncOld myFunc) {
       << "With the Phys of your choice (DefaultPhysics, DustPhysics...)" << std::endl;
 
   IDEFIX_WARNING(msg);
+  if(fluid->isBatched) {
+    IDEFIX_ERROR("Batched dust species are not compatible with user-defined flux boundaries");
+  }
   this->fluxBoundaryFuncOld = myFunc;
   this->haveFluxBoundary = true;
 }
 
 template<typename Phys>
 void Boundary<Phys>::EnrollFluxBoundary(UserDefBoundaryFunc<Phys> myFunc) {
+  // The fluxes of batched species are computed by DustBatch, which does not enforce them
+  if(fluid->isBatched) {
+    IDEFIX_ERROR("Batched dust species are not compatible with user-defined flux boundaries");
+  }
   this->haveFluxBoundary = true;
   this->fluxBoundaryFunc = myFunc;
 }
@@ -989,6 +996,8 @@ inline void Boundary<Phys>::BoundaryForAll(
     const int kbeg = (dir == KDIR) ? side*(kghost+nxk) : 0;
     const int kend = (dir == KDIR) ? kghost + side*(kghost+nxk) : data->np_tot[KDIR];
 
+    // One read and one write per variable in each ghost cell (4D loops count cells, not variables)
+    idfx::DeclareTraffic(this->nVar*sizeof(real), this->nVar*sizeof(real));
     idefix_for(name, 0, this->nVar, kbeg, kend, jbeg, jend, ibeg, iend, function);
 }
 
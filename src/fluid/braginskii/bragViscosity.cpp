@@ -33,9 +33,8 @@ void BragViscosity::InitArrays() {
         dmu(j) = 1.0/scrch;
       });
   #endif
-  bragViscSrc = IdefixArray4D<real>("BragViscosity_source", COMPONENTS, data->np_tot[KDIR],
-                                                                data->np_tot[JDIR],
-                                                                data->np_tot[IDIR]);
+  bragViscSrc = IdefixArray4D<real>("BragViscosity_source", idfx::ArrayLayout4D(COMPONENTS,
+                                    data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
 }
 void BragViscosity::ShowConfig() {
   if(status.status==Constant) {
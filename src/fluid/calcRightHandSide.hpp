@@ -47,6 +47,12 @@ struct Fluid_CorrectFluxFunctor {
 
     // Shearing box shear rate
     sbS = hydro->sbS;
+
+    // Active regions of the dust species
+    if constexpr(Phys::dust) {
+      mask = hydro->activeMask;
+      species0 = hydro->instanceNumber;
+    }
   }
 
   //*****************************************************************
@@ -78,10 +84,34 @@ struct Fluid_CorrectFluxFunctor {
   // timestep
   real dt;
 
+  // Active regions of the dust species (species0 is the species of the first fluid)
+  DustMask mask;
+  int species0{0};
+
+  // Number of fluids stored one after the other in Flux (species-batched dust)
+  int nBatch{1};
+
+  // Correct the fluxes of the nBatch fluids stored in the given array
+  void SetBatch(const int n, IdefixArray4D<real> &FluxIn) {
+    nBatch = n;
+    Flux = FluxIn;
+  }
+
   //*****************************************************************
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    for(int s = 0 ; s < nBatch ; s++) {
+      if constexpr(Phys::dust) {
+        if(!mask.IsFaceActive<dir>(species0+s, k, j, i)) continue;
+      }
+      CorrectFlux(s*Phys::nvar, k, j, i);
+    }
+  }
+
+  // Correct the flux of the fluid starting at index o in Flux
+  KOKKOS_INLINE_FUNCTION void CorrectFlux(const int o,
+                                          const int k, const int j,  const int i) const {
       // Add Fargo velocity to the fluxes
       if(haveFargo || haveRotation) {
         // Set mean advection direction
@@ -143,10 +173,11 @@ struct Fluid_CorrectFluxFunctor {
         // since in that case meanV=0
         if constexpr(Phys::pressure) {
           // Mignone (2012): second and third term of rhs of (25)
-          Flux(ENG,k,j,i) += meanV * (HALF_F*meanV*Flux(RHO,k,j,i) + Flux(MX1+meanDir,k,j,i));
+          Flux(o+ENG,k,j,i) += meanV * (HALF_F*meanV*Flux(o+RHO,k,j,i)
+                                       + Flux(o+MX1+meanDir,k,j,i));
         }
         // Mignone+2012: second term of rhs of (24)
-        Flux(MX1+meanDir,k,j,i) += meanV * Flux(RHO,k,j,i);
+        Flux(o+MX1+meanDir,k,j,i) += meanV * Flux(o+RHO,k,j,i);
       } // Fargo & Rotation corrections
 
       //////////////////////////////////////////////
@@ -190,7 +221,7 @@ struct Fluid_CorrectFluxFunctor {
 
       // Finally correct the flux
       for(int nv = 0 ; nv < Phys::nvar ; nv++) {
-        Flux(nv,k,j,i) = Flux(nv,k,j,i) * Ax[nv];
+        Flux(o+nv,k,j,i) = Flux(o+nv,k,j,i) * Ax[nv];
       }
     }
 };
@@ -217,8 +248,13 @@ struct Fluid_CalcRHSFunctor {
     sinx2 = hydro->data->sinx2;
     dx   = hydro->data->dx[dir];
     dx2  = hydro->data->dx[JDIR];
-    invDt = hydro->InvDt;
-    cMax = hydro->cMax;
+    // Single fluid: invDt and cMax are seen as a batch of one fluid
+    invDt = IdefixArray4D<real>(hydro->InvDt.data(), idfx::ArrayLayout4D(1, hydro->InvDt.extent(0),
+                                                        hydro->InvDt.extent(1),
+                                                        hydro->InvDt.extent(2), false));
+    cMax = IdefixArray4D<real>(hydro->cMax.data(), idfx::ArrayLayout4D(1, hydro->cMax.extent(0),
+                                                      hydro->cMax.extent(1),
+                                                      hydro->cMax.extent(2), false));
     dMax = hydro->dMax;
     this->dt = dt;
 
@@ -266,6 +302,12 @@ struct Fluid_CalcRHSFunctor {
 
     // Shearing box shear rate
     sbS = hydro->sbS;
+
+    // Active regions of the dust species
+    if constexpr(Phys::dust) {
+      mask = hydro->activeMask;
+      species0 = hydro->instanceNumber;
+    }
   }
   //*****************************************************************
   // Functor Variables
@@ -284,8 +326,8 @@ struct Fluid_CalcRHSFunctor {
   IdefixArray1D<real> sinx2;
   IdefixArray1D<real> dx;
   IdefixArray1D<real> dx2;
-  IdefixArray3D<real> invDt;
-  IdefixArray3D<real> cMax;
+  IdefixArray4D<real> invDt;
+  IdefixArray4D<real> cMax;
   IdefixArray3D<real> dMax;
   IdefixArray4D<real> viscSrc;
 
@@ -327,20 +369,57 @@ struct Fluid_CalcRHSFunctor {
   // timestep
   real dt;
 
+  // Active regions of the dust species (species0 is the species of the first fluid)
+  DustMask mask;
+  int species0{0};
+
+  // Number of fluids stored one after the other in Uc, Vc and Flux (species-batched dust)
+  int nBatch{1};
+
+  // Evolve the nBatch fluids stored in the given arrays (one invDt and cMax per fluid)
+  void SetBatch(const int n, IdefixArray4D<real> &UcIn, IdefixArray4D<real> &VcIn,
+                IdefixArray4D<real> &FluxIn, IdefixArray4D<real> &invDtIn,
+                IdefixArray4D<real> &cMaxIn) {
+    nBatch = n;
+    Uc = UcIn;
+    Vc = VcIn;
+    Flux = FluxIn;
+    invDt = invDtIn;
+    cMax = cMaxIn;
+  }
+
   //*****************************************************************
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    for(int s = 0 ; s < nBatch ; s++) {
+      CalcRHS(s, k, j, i);
+    }
+  }
+
+  // Evolve fluid s of the batch
+  KOKKOS_INLINE_FUNCTION void CalcRHS(const int s,
+                                      const int k, const int j,  const int i) const {
     const int ioffset = (dir==IDIR) ? 1 : 0;
     const int joffset = (dir==JDIR) ? 1 : 0;
     const int koffset = (dir==KDIR) ? 1 : 0;
 
+    // Inactive dust is left untouched, unless it receives the flux of an active face (so that
+    // the mass leaving the active cells is conserved)
+    if constexpr(Phys::dust) {
+      if(!mask.IsFaceActive<dir>(species0+s, k, j, i)
+         && !mask.IsFaceActive<dir>(species0+s, k+koffset, j+joffset, i+ioffset)) return;
+    }
+
+    // Index of the first variable of this fluid
+    const int o = s*Phys::nvar;
+
     real dtdV=dt / dV(k,j,i);
     real rhs[Phys::nvar];
 
     #pragma unroll
     for(int nv = 0 ; nv < Phys::nvar ; nv++) {
-      rhs[nv] = -  dtdV*(Flux(nv, k+koffset, j+joffset, i+ioffset) - Flux(nv, k, j, i));
+      rhs[nv] = -  dtdV*(Flux(o+nv, k+koffset, j+joffset, i+ioffset) - Flux(o+nv, k, j, i));
     }
 
     #if GEOMETRY != CARTESIAN
@@ -350,20 +429,20 @@ struct Fluid_CalcRHSFunctor {
         #endif
         if constexpr(Phys::mhd) {
           #if (GEOMETRY == POLAR || GEOMETRY == CYLINDRICAL) &&  (defined iBPHI)
-            rhs[iBPHI] = - dt / dx(i) * (Flux(iBPHI, k, j, i+1) - Flux(iBPHI, k, j, i) );
+            rhs[iBPHI] = - dt / dx(i) * (Flux(o+iBPHI, k, j, i+1) - Flux(o+iBPHI, k, j, i) );
 
           #elif (GEOMETRY == SPHERICAL)
             real q = dt / (x1(i)*dx(i));
             EXPAND(                                                                       ,
-                  rhs[iBTH]  = -q * ((Flux(iBTH, k, j, i+1)  - Flux(iBTH, k, j, i) ));  ,
-                  rhs[iBPHI] = -q * ((Flux(iBPHI, k, j, i+1) - Flux(iBPHI, k, j, i) )); )
+                  rhs[iBTH]  = -q * ((Flux(o+iBTH, k, j, i+1)  - Flux(o+iBTH, k, j, i) ));  ,
+                  rhs[iBPHI] = -q * ((Flux(o+iBPHI, k, j, i+1) - Flux(o+iBPHI, k, j, i) )); )
           #endif
         } // MHD
       } else if constexpr(dir==JDIR) {
         #if (GEOMETRY == SPHERICAL) && (COMPONENTS == 3)
           rhs[iMPHI] /= FABS(sinx2(j));
           if constexpr(Phys::mhd) {
-            rhs[iBPHI] = -dt / (rt(i)*dx(j)) * (Flux(iBPHI, k, j+1, i) - Flux(iBPHI, k, j, i));
+            rhs[iBPHI] = -dt / (rt(i)*dx(j)) * (Flux(o+iBPHI, k, j+1, i) - Flux(o+iBPHI, k, j, i));
           } // MHD
         #endif // GEOMETRY
       }
@@ -459,14 +538,14 @@ struct Fluid_CalcRHSFunctor {
                       - phiP(k+2,j,i) + 8.0 * phiP(k+1,j,i)
                       - 8.0*phiP(k-1,j,i) + phiP(k-2,j,i));
       }
-      rhs[MX1+dir] += dt * Vc(RHO,k,j,i) * dphi /dl;
+      rhs[MX1+dir] += dt * Vc(o+RHO,k,j,i) * dphi /dl;
 
       if constexpr(Phys::pressure) {
         // Add gravitational force work as a source term
         // This is equivalent to rho * v . nabla(phi)
         // (note that Flux has already been multiplied by A)
         rhs[ENG] += HALF_F * dtdV  *
-                  (Flux(RHO,k,j,i) + Flux(RHO, k+koffset, j+joffset, i+ioffset)) * dphi;
+                  (Flux(o+RHO,k,j,i) + Flux(o+RHO, k+koffset, j+joffset, i+ioffset)) * dphi;
       }
     }
 
@@ -479,30 +558,30 @@ struct Fluid_CalcRHSFunctor {
           bf -= -2*Omega*sbS * x1(i);
         }
       #endif
-      rhs[MX1+dir] += dt * Vc(RHO,k,j,i) * bf;
+      rhs[MX1+dir] += dt * Vc(o+RHO,k,j,i) * bf;
       if constexpr(Phys::pressure) {
         //  rho * v . f, where rhov is taken as a  volume average of Flux(RHO)
         rhs[ENG] += HALF_F * dtdV * dl *
-                      (Flux(RHO,k,j,i) + Flux(RHO, k+koffset, j+joffset, i+ioffset)) * bf;
+                      (Flux(o+RHO,k,j,i) + Flux(o+RHO, k+koffset, j+joffset, i+ioffset)) * bf;
       } // Pressure
 
       // Particular cases if we do not sweep all of the components
       #if DIMENSIONS == 1 && COMPONENTS > 1
         EXPAND(                                                           ,
-                  rhs[MX2] += dt * Vc(RHO,k,j,i) * bodyForce(JDIR,k,j,i);   ,
-                  rhs[MX3] += dt * Vc(RHO,k,j,i) * bodyForce(KDIR,k,j,i);    )
+                  rhs[MX2] += dt * Vc(o+RHO,k,j,i) * bodyForce(JDIR,k,j,i);   ,
+                  rhs[MX3] += dt * Vc(o+RHO,k,j,i) * bodyForce(KDIR,k,j,i);    )
         if constexpr(Phys::pressure) {
           rhs[ENG] += dt * (EXPAND( ZERO_F                                              ,
-                                    + Vc(RHO,k,j,i) * Vc(VX2,k,j,i) * bodyForce(JDIR,k,j,i)   ,
-                                    + Vc(RHO,k,j,i) * Vc(VX3,k,j,i) * bodyForce(KDIR,k,j,i) ));
+                                    + Vc(o+RHO,k,j,i) * Vc(o+VX2,k,j,i) * bodyForce(JDIR,k,j,i)   ,
+                                    + Vc(o+RHO,k,j,i) * Vc(o+VX3,k,j,i) * bodyForce(KDIR,k,j,i) ));
         }
       #endif
       #if DIMENSIONS == 2 && COMPONENTS == 3
         // Only add this term once!
         if constexpr (dir==JDIR) {
-          rhs[MX3] += dt * Vc(RHO,k,j,i) * bodyForce(KDIR,k,j,i);
+          rhs[MX3] += dt * Vc(o+RHO,k,j,i) * bodyForce(KDIR,k,j,i);
           if constexpr(Phys::pressure) {
-            rhs[ENG] += dt * Vc(RHO,k,j,i) * Vc(VX3,k,j,i) * bodyForce(KDIR,k,j,i);
+            rhs[ENG] += dt * Vc(o+RHO,k,j,i) * Vc(o+VX3,k,j,i) * bodyForce(KDIR,k,j,i);
           }
         }
       #endif
@@ -527,11 +606,11 @@ struct Fluid_CalcRHSFunctor {
     }
 
     // Compute dt from max signal speed
-    invDt(k,j,i) = invDt(k,j,i) + HALF_F*(cMax(k+koffset,j+joffset,i+ioffset)
-                  + cMax(k,j,i)) / (dl);
+    invDt(s,k,j,i) = invDt(s,k,j,i) + HALF_F*(cMax(s,k+koffset,j+joffset,i+ioffset)
+                  + cMax(s,k,j,i)) / (dl);
 
     if(haveParabolicTerms) {
-      invDt(k,j,i) = invDt(k,j,i) + TWO_F* FMAX(dMax(k+koffset,j+joffset,i+ioffset),
+      invDt(s,k,j,i) = invDt(s,k,j,i) + TWO_F* FMAX(dMax(k+koffset,j+joffset,i+ioffset),
                                                   dMax(k,j,i)) / (dl*dl);
     }
 
@@ -545,7 +624,7 @@ struct Fluid_CalcRHSFunctor {
                 if(nv == BX3) { continue; }  )
 
 
-      Uc(nv,k,j,i) = Uc(nv,k,j,i) + rhs[nv];
+      Uc(o+nv,k,j,i) = Uc(o+nv,k,j,i) + rhs[nv];
     }
   }
 };
@@ -585,6 +664,9 @@ void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
   /////////////////////////////////////////////////////////////////////////////
   // Final conserved quantity budget from fluxes divergence
   /////////////////////////////////////////////////////////////////////////////
+  idfx::DeclareTraffic(idfx::BytesPerCell(FluxRiemann) + idfx::BytesPerCell(Uc)
+                       + idfx::BytesPerCell(InvDt) + idfx::BytesPerCell(cMax),
+                       idfx::BytesPerCell(Uc) + idfx::BytesPerCell(InvDt));
   idefix_for("CalcRightHandSide",
              data->beg[KDIR],data->end[KDIR],
              data->beg[JDIR],data->end[JDIR],
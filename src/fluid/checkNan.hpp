@@ -67,8 +67,8 @@ int Fluid<Phys>::CheckNan()  {
 
       DataBlockHost dataHost(*data);
 
-      IdefixHostArray4D<real> VcHost = Kokkos::create_mirror_view(this->Vc);
-      Kokkos::deep_copy(VcHost,Vc);
+      IdefixHostArray4D<real> VcHost = idfx::CreateHostArray(this->Vc);
+      idfx::DeepCopy(VcHost,Vc);
 
       int nerrormax=10;
 
@@ -95,8 +95,8 @@ int Fluid<Phys>::CheckNan()  {
       }
 
       if constexpr(Phys::mhd) {
-        IdefixHostArray4D<real> VsHost = Kokkos::create_mirror_view(this->Vs);
-        Kokkos::deep_copy(VsHost,Vs);
+        IdefixHostArray4D<real> VsHost = idfx::CreateHostArray(this->Vs);
+        idfx::DeepCopy(VsHost,Vs);
         for(int k = data->beg[KDIR] ; k < data->end[KDIR]+KOFFSET ; k++) {
           for(int j = data->beg[JDIR] ; j < data->end[JDIR]+JOFFSET ; j++) {
             for(int i = data->beg[IDIR] ; i < data->end[IDIR]+IOFFSET ; i++) {
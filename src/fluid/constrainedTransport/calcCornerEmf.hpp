@@ -65,7 +65,7 @@ void ConstrainedTransport<Phys>::CalcArithmeticAverage() {
             data->beg[IDIR],data->end[IDIR]+IOFFSET,
     KOKKOS_LAMBDA (int k, int j, int i) {
                   // CT_EMF_ArithmeticAverage (emf, 0.25);
-      real w = ONE_FOURTH_F;
+      realc w = ONE_FOURTH_F;
     #if DIMENSIONS == 3
       ex(k,j,i) = w * (exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i));
       ey(k,j,i) = w * (eyi(k,j,i) + eyi(k-1,j,i) + eyk(k,j,i) + eyk(k,j,i-1));
@@ -96,8 +96,8 @@ void ConstrainedTransport<Phys>::CalcCellCenteredEMF() {
             0,data->np_tot[JDIR],
             0,data->np_tot[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i) {
-      [[maybe_unused]] real vx1, vx2, vx3;
-      [[maybe_unused]] real Bx1, Bx2, Bx3;
+      [[maybe_unused]] realc vx1, vx2, vx3;
+      [[maybe_unused]] realc Bx1, Bx2, Bx3;
 
       vx1 = vx2 = vx3 = ZERO_F;
       Bx1 = Bx2 = Bx3 = ZERO_F;
@@ -177,7 +177,7 @@ void ConstrainedTransport<Phys>::CalcUCT0Average() {
             data->beg[IDIR],data->end[IDIR]+IOFFSET,
     KOKKOS_LAMBDA (int k, int j, int i) {
       // CT_EMF_ArithmeticAverage (emf, 0.25);
-      const real w = ONE_FOURTH_F;
+      const realc w = ONE_FOURTH_F;
     #if DIMENSIONS == 3
       ex(k,j,i) = w * (exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i));
       ey(k,j,i) = w * (eyi(k,j,i) + eyi(k-1,j,i) + eyk(k,j,i) + eyk(k,j,i-1));
@@ -226,16 +226,16 @@ void ConstrainedTransport<Phys>::CalcContactAverage() {
             data->beg[JDIR],data->end[JDIR]+JOFFSET,
             data->beg[IDIR],data->end[IDIR]+IOFFSET,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      real ez_l2 = (1-wsx(k,j-1,i)) * (ezj(k,j,i)   - Ex3(k,j-1,i)) +
+      realc ez_l2 = (1-wsx(k,j-1,i)) * (ezj(k,j,i)   - Ex3(k,j-1,i)) +
                    (  wsx(k,j-1,i)) * (ezj(k,j,i-1) - Ex3(k,j-1,i-1));
 
-      real ez_r2 = (1-wsx(k,j,i)) * (ezj(k,j,i)   - Ex3(k,j,i)) +
+      realc ez_r2 = (1-wsx(k,j,i)) * (ezj(k,j,i)   - Ex3(k,j,i)) +
                    (  wsx(k,j,i)) * (ezj(k,j,i-1) - Ex3(k,j,i-1));
 
-      real ez_l1 = (1-wsy(k,j,i-1)) * (ezi(k,j,i)   - Ex3(k,j,i-1)) +
+      realc ez_l1 = (1-wsy(k,j,i-1)) * (ezi(k,j,i)   - Ex3(k,j,i-1)) +
                    (  wsy(k,j,i-1)) * (ezi(k,j-1,i) - Ex3(k,j-1,i-1));
 
-      real ez_r1 = (1-wsy(k,j,i)) * (ezi(k,j,i)   - Ex3(k,j,i)) +
+      realc ez_r1 = (1-wsy(k,j,i)) * (ezi(k,j,i)   - Ex3(k,j,i)) +
                    (  wsy(k,j,i)) * (ezi(k,j-1,i) - Ex3(k,j-1,i));
 
       ez(k,j,i) = ONE_FOURTH_F * (ez_l2 + ez_r2 + ez_l1 + ez_r1 +
@@ -247,31 +247,31 @@ void ConstrainedTransport<Phys>::CalcContactAverage() {
                         );
 
       #if DIMENSIONS == 3
-        real ex_l3 = (1-wsy(k-1,j,i)) * (exk(k,j,i)   - Ex1(k-1,j,i)) +
+        realc ex_l3 = (1-wsy(k-1,j,i)) * (exk(k,j,i)   - Ex1(k-1,j,i)) +
                      (  wsy(k-1,j,i)) * (exk(k,j-1,i) - Ex1(k-1,j-1,i));
 
-        real ex_r3 = (1-wsy(k,j,i)) * (exk(k,j,i)   - Ex1(k,j,i)) +
+        realc ex_r3 = (1-wsy(k,j,i)) * (exk(k,j,i)   - Ex1(k,j,i)) +
                      (  wsy(k,j,i)) * (exk(k,j-1,i) - Ex1(k,j-1,i));
 
-        real ex_l2 = (1-wsz(k,j-1,i)) * (exj(k,j,i)   - Ex1(k,j-1,i)) +
+        realc ex_l2 = (1-wsz(k,j-1,i)) * (exj(k,j,i)   - Ex1(k,j-1,i)) +
                      (  wsz(k,j-1,i)) * (exj(k-1,j,i) - Ex1(k-1,j-1,i));
 
-        real ex_r2 = (1-wsz(k,j,i)) * (exj(k,j,i)   - Ex1(k,j,i)) +
+        realc ex_r2 = (1-wsz(k,j,i)) * (exj(k,j,i)   - Ex1(k,j,i)) +
                      (  wsz(k,j,i)) * (exj(k-1,j,i) - Ex1(k-1,j,i));
 
         ex(k,j,i) = ONE_FOURTH_F * (ex_l3 + ex_r3 + ex_l2 + ex_r2 +
                             exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i) );
 
-        real ey_l3 = (1-wsx(k-1,j,i)) * (eyk(k,j,i)   - Ex2(k-1,j,i)) +
+        realc ey_l3 = (1-wsx(k-1,j,i)) * (eyk(k,j,i)   - Ex2(k-1,j,i)) +
                      (  wsx(k-1,j,i)) * (eyk(k,j,i-1) - Ex2(k-1,j,i-1));
 
-        real ey_r3 = (1-wsx(k,j,i)) * (eyk(k,j,i)   - Ex2(k,j,i)) +
+        realc ey_r3 = (1-wsx(k,j,i)) * (eyk(k,j,i)   - Ex2(k,j,i)) +
                      (  wsx(k,j,i)) * (eyk(k,j,i-1) - Ex2(k,j,i-1));
 
-        real ey_l1 = (1-wsz(k,j,i-1)) * (eyi(k,j,i)   - Ex2(k,j,i-1)) +
+        realc ey_l1 = (1-wsz(k,j,i-1)) * (eyi(k,j,i)   - Ex2(k,j,i-1)) +
                      (  wsz(k,j,i-1)) * (eyi(k-1,j,i) - Ex2(k-1,j,i-1));
 
-        real ey_r1 = (1-wsz(k,j,i)) * (eyi(k,j,i)   - Ex2(k,j,i)) +
+        realc ey_r1 = (1-wsz(k,j,i)) * (eyi(k,j,i)   - Ex2(k,j,i)) +
                      (  wsz(k,j,i)) * (eyi(k-1,j,i) - Ex2(k-1,j,i));
 
         ey(k,j,i) = ONE_FOURTH_F * (ey_l3 + ey_r3 + ey_l1 + ey_r1 +
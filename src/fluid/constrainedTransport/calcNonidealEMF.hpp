@@ -28,15 +28,21 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
   // These arrays have been previously computed in calcParabolicFlux
   IdefixArray3D<real> etaArr = hydro->etaOhmic;
   IdefixArray3D<real> xAmbiArr = hydro->xAmbipolar;
+  IdefixArray3D<real> xHallArr = hydro->xHall;
 
   // these two are required to ensure that the type is captured by KOKKOS_LAMBDA
   HydroModuleStatus resistivity = hydro->resistivityStatus.status;
   HydroModuleStatus ambipolar = hydro->ambipolarStatus.status;
+  HydroModuleStatus hall = hydro->hallStatus.status;
 
   bool haveResistivity{false};
   bool haveAmbipolar{false};
+  bool haveHall{false};
 
-  if(data->rklCycle) {
+  if(data->hallCycle) {
+    // Only the Hall EMF is computed during the Hall sub-cycle
+    haveHall = true;
+  } else if(data->rklCycle) {
     haveResistivity = hydro->resistivityStatus.isRKL;
     haveAmbipolar = hydro->ambipolarStatus.isRKL;
   } else {
@@ -46,21 +52,24 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
 
   real etaConstant = hydro->etaO;
   real xAConstant = hydro->xA;
+  real xHConstant = hydro->xH;
 
   idefix_for("CalcNIEMF",
              data->beg[KDIR],data->end[KDIR]+KOFFSET,
              data->beg[JDIR],data->end[JDIR]+JOFFSET,
              data->beg[IDIR],data->end[IDIR]+IOFFSET,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      real Bx1, Bx2, Bx3;
-      real Jx1, Jx2, Jx3;
-      real eta, xA;
+      realc Bx1, Bx2, Bx3;
+      realc Jx1, Jx2, Jx3;
+      realc eta, xA, xH;
       // CT_EMF_ArithmeticAverage (emf, 0.25);
 
       if(resistivity == Constant)
         eta = etaConstant;
       if(ambipolar == Constant)
         xA = xAConstant;
+      if(hall == Constant)
+        xH = xHConstant;
 
   #if DIMENSIONS == 3
       // -----------------------
@@ -86,12 +95,24 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         Jx2 = AVERAGE_4D_XY(J, JDIR, k, j, i+1);
         Jx3 = AVERAGE_4D_XZ(J, KDIR, k, j, i+1);
 
-        real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
-        real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
+        realc JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
+        realc BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
 
         ex(k,j,i) += xA * (BdotB*Jx1 - JdotB * Bx1);
       }
 
+      // Hall effect
+      if(haveHall) {
+        if(hall == UserDefFunction) xH = AVERAGE_3D_YZ(xHallArr,k,j,i);
+        Bx2 = AVERAGE_4D_Z(Vs, BX2s, k, j, i);
+        Bx3 = AVERAGE_4D_Y(Vs, BX3s, k, j, i);
+
+        Jx2 = AVERAGE_4D_XY(J, JDIR, k, j, i+1);
+        Jx3 = AVERAGE_4D_XZ(J, KDIR, k, j, i+1);
+
+        ex(k,j,i) += xH * (Jx2*Bx3 - Jx3*Bx2);
+      }
+
       // -----------------------
       // X2 EMF Component
       // -----------------------
@@ -114,11 +135,23 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         Jx1 = AVERAGE_4D_XY(J, IDIR, k, j+1, i);
         Jx3 = AVERAGE_4D_YZ(J, KDIR, k, j+1, i);
 
-        real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
-        real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
+        realc JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
+        realc BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
 
         ey(k,j,i) += xA * (BdotB*Jx2 - JdotB * Bx2);
       }
+
+      // Hall effect
+      if(haveHall) {
+        if(hall == UserDefFunction) xH = AVERAGE_3D_XZ(xHallArr,k,j,i);
+        Bx1 = AVERAGE_4D_Z(Vs, BX1s, k, j, i);
+        Bx3 = AVERAGE_4D_X(Vs, BX3s, k, j, i);
+
+        Jx1 = AVERAGE_4D_XY(J, IDIR, k, j+1, i);
+        Jx3 = AVERAGE_4D_YZ(J, KDIR, k, j+1, i);
+
+        ey(k,j,i) += xH * (Jx3*Bx1 - Jx1*Bx3);
+      }
   #endif
       // -----------------------
       // X3 EMF Component
@@ -163,11 +196,35 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         Jx1 = AVERAGE_4D_X(J, IDIR, k, j, i);
         Jx2 = AVERAGE_4D_Y(J, JDIR, k, j, i);
   #endif
-        real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
-        real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
+        realc JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
+        realc BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
 
         ez(k,j,i) += xA * (BdotB * Jx3 - JdotB * Bx3);
       }
+
+      // Hall effect
+      if(haveHall) {
+        if(hall == UserDefFunction) xH = AVERAGE_3D_XY(xHallArr,k,j,i);
+        Bx1 = AVERAGE_4D_Y(Vs, BX1s, k, j, i);
+  #if DIMENSIONS >= 2
+        Bx2 = AVERAGE_4D_X(Vs, BX2s, k, j, i);
+  #else
+    #if COMPONENTS >= 2
+        Bx2 = AVERAGE_4D_XY(Vc, BX2, k, j, i);
+    #else
+        Bx2 = 0.0;
+    #endif
+  #endif
+
+  #if DIMENSIONS == 3
+        Jx1 = AVERAGE_4D_XZ(J, IDIR, k+1, j, i);
+        Jx2 = AVERAGE_4D_YZ(J, JDIR, k+1, j, i);
+  #else
+        Jx1 = AVERAGE_4D_X(J, IDIR, k, j, i);
+        Jx2 = AVERAGE_4D_Y(J, JDIR, k, j, i);
+  #endif
+        ez(k,j,i) += xH * (Jx1*Bx2 - Jx2*Bx1);
+      }
     }
   );
 #endif
@@ -66,8 +66,8 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
     KOKKOS_LAMBDA (int k, int j, int i) {
       // IDIR
 #if DIMENSIONS >= 2
-      [[maybe_unused]] real phi, vL, vR, dv, bL, bR, db;
-      [[maybe_unused]] real aL, aR, dL, dR;
+      [[maybe_unused]] realc phi, vL, vR, dv, bL, bR, db;
+      [[maybe_unused]] realc aL, aR, dL, dR;
 
       [[maybe_unused]] const int im = i-1, jm = j-1, km = k-1;
 
@@ -170,7 +170,8 @@ ConstrainedTransport<Phys>::ConstrainedTransport(Input &input, Fluid<Phys> *hydr
       IDEFIX_ERROR("Unknown EMF averaging scheme");
     }
   } else {
-    if(hydro->hallStatus.status == HydroModuleStatus::Disabled) {
+    if(hydro->hallStatus.status == HydroModuleStatus::Disabled
+       || hydro->hallStatus.isSubcycled) {
       // by default, use uct_contact
       this->averaging = uct_contact;
     } else {
@@ -50,59 +50,65 @@ void ConstrainedTransport<Phys>::EvolveMagField(real t, real dt, IdefixArray4D<r
 
 
 
+  // The field is updated in realc (double precision in mixed precision)
+  const realc dtc = dt;
+
+  // Face-centered field and edge EMFs
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vs) + DIMENSIONS*idfx::BytesPerCell(Ex3),
+                       idfx::BytesPerCell(Vs));
   idefix_for("EvolvMagField",
              data->beg[KDIR],data->end[KDIR]+KOFFSET,
              data->beg[JDIR],data->end[JDIR]+JOFFSET,
              data->beg[IDIR],data->end[IDIR]+IOFFSET,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      real rhsx1;
-      [[maybe_unused]] real rhsx2, rhsx3;
+      realc rhsx1;
+      [[maybe_unused]] realc rhsx2, rhsx3;
 
 #if GEOMETRY == CARTESIAN
       rhsx1 = D_EXPAND( ZERO_F                                     ,
-                       - dt/dx2(j) * (Ex3(k,j+1,i) - Ex3(k,j,i) )  ,
-                       + dt/dx3(k) * (Ex2(k+1,j,i) - Ex2(k,j,i) )  );
+                       - dtc/dx2(j) * (Ex3(k,j+1,i) - Ex3(k,j,i) ) ,
+                       + dtc/dx3(k) * (Ex2(k+1,j,i) - Ex2(k,j,i) ) );
 
   #if DIMENSIONS >= 2
-      rhsx2 =  D_EXPAND( dt/dx1(i) * (Ex3(k,j,i+1) - Ex3(k,j,i) )  ,
+      rhsx2 =  D_EXPAND( dtc/dx1(i) * (Ex3(k,j,i+1) - Ex3(k,j,i) ) ,
                                                                    ,
-                        - dt/dx3(k) * (Ex1(k+1,j,i) - Ex1(k,j,i) ) );
+                        - dtc/dx3(k) * (Ex1(k+1,j,i) - Ex1(k,j,i) ) );
   #endif
   #if DIMENSIONS == 3
-      rhsx3 = - dt/dx1(i) * (Ex2(k,j,i+1) - Ex2(k,j,i) )
-              + dt/dx2(j) * (Ex1(k,j+1,i) - Ex1(k,j,i) );
+      rhsx3 = - dtc/dx1(i) * (Ex2(k,j,i+1) - Ex2(k,j,i) )
+              + dtc/dx2(j) * (Ex1(k,j+1,i) - Ex1(k,j,i) );
   #endif
 
 #elif GEOMETRY == CYLINDRICAL
-      rhsx1 = - dt/dx2(j) * (Ex3(k,j+1,i) - Ex3(k,j,i) );
+      rhsx1 = - dtc/dx2(j) * (Ex3(k,j+1,i) - Ex3(k,j,i) );
   #if DIMENSIONS >= 2
-      rhsx2 = dt * (FABS(x1p(i)) * Ex3(k,j,i+1) - FABS(x1m(i)) * Ex3(k,j,i)) / FABS(x1(i)*dx1(i));
+      rhsx2 = dtc * (FABS(x1p(i)) * Ex3(k,j,i+1) - FABS(x1m(i)) * Ex3(k,j,i)) / FABS(x1(i)*dx1(i));
   #endif
 
 #elif GEOMETRY == POLAR
       rhsx1 = D_EXPAND( ZERO_F                                                      ,
-                       - dt/(FABS(x1m(i)) * dx2(j)) * (Ex3(k,j+1,i) - Ex3(k,j,i) )  ,
-                       + dt/dx3(k) * (Ex2(k+1,j,i) - Ex2(k,j,i) )                   );
+                       - dtc/(FABS(x1m(i)) * dx2(j)) * (Ex3(k,j+1,i) - Ex3(k,j,i) ) ,
+                       + dtc/dx3(k) * (Ex2(k+1,j,i) - Ex2(k,j,i) )                  );
 
   #if DIMENSIONS >= 2
-      rhsx2 =  D_EXPAND( dt/dx1(i) * (Ex3(k,j,i+1) - Ex3(k,j,i) )  ,
+      rhsx2 =  D_EXPAND( dtc/dx1(i) * (Ex3(k,j,i+1) - Ex3(k,j,i) ) ,
                                                                    ,
-                        - dt/dx3(k) * (Ex1(k+1,j,i) - Ex1(k,j,i) ) );
+                        - dtc/dx3(k) * (Ex1(k+1,j,i) - Ex1(k,j,i) ) );
   #endif
   #if DIMENSIONS == 3
-      rhsx3 = dt/(FABS(x1(i))) * (
+      rhsx3 = dtc/(FABS(x1(i))) * (
                   -  (x1m(i+1)*Ex2(k,j,i+1) - x1m(i)*Ex2(k,j,i) ) / dx1(i)
                   +  (Ex1(k,j+1,i) - Ex1(k,j,i) ) / dx2(j) );
   #endif
 
 #elif GEOMETRY == SPHERICAL
-      real dV2  = dmu(j);
-      real Ax2p = FABS(sinx2m(j+1));
-      real Ax2m = FABS(sinx2m(j));
+      realc dV2  = dmu(j);
+      realc Ax2p = FABS(sinx2m(j+1));
+      realc Ax2m = FABS(sinx2m(j));
 
       rhsx1 = D_EXPAND( ZERO_F                                                        ,
-                       - dt/(x1m(i)*dV2) * ( Ax2p*Ex3(k,j+1,i) - Ax2m*Ex3(k,j,i) )    ,
-                       + dt*dx2(j)/(x1m(i)*dV2*dx3(k)) * (Ex2(k+1,j,i) - Ex2(k,j,i) ) );
+                       - dtc/(x1m(i)*dV2) * ( Ax2p*Ex3(k,j+1,i) - Ax2m*Ex3(k,j,i) )   ,
+                       + dtc*dx2(j)/(x1m(i)*dV2*dx3(k)) * (Ex2(k+1,j,i) - Ex2(k,j,i) ) );
 
   #if DIMENSIONS >= 2
       // If we include the axis, we symmetrize Ex on the axis. However, Ax2=0 on the axis
@@ -111,13 +117,13 @@ void ConstrainedTransport<Phys>::EvolveMagField(real t, real dt, IdefixArray4D<r
       if(haveAxis) {
         if(FABS(Ax2m)<1e-12) Ax2m = ONE_F;
       }
-      rhsx2 =  D_EXPAND( dt/(x1(i)*dx1(i)) * (x1m(i+1)*Ex3(k,j,i+1) - x1m(i)*Ex3(k,j,i) )  ,
+      rhsx2 =  D_EXPAND( dtc/(x1(i)*dx1(i)) * (x1m(i+1)*Ex3(k,j,i+1) - x1m(i)*Ex3(k,j,i) ) ,
                                                                                            ,
-                        - dt/(x1(i)*Ax2m*dx3(k)) * (Ex1(k+1,j,i) - Ex1(k,j,i) )            );
+                        - dtc/(x1(i)*Ax2m*dx3(k)) * (Ex1(k+1,j,i) - Ex1(k,j,i) )           );
   #endif
   #if DIMENSIONS == 3
-      rhsx3 = - dt/(x1(i)*dx1(i)) * (x1m(i+1)*Ex2(k,j,i+1) - x1m(i)*Ex2(k,j,i) )
-              + dt/(x1(i)*dx2(j)) * (Ex1(k,j+1,i) - Ex1(k,j,i) );
+      rhsx3 = - dtc/(x1(i)*dx1(i)) * (x1m(i+1)*Ex2(k,j,i+1) - x1m(i)*Ex2(k,j,i) )
+              + dtc/(x1(i)*dx2(j)) * (Ex1(k,j+1,i) - Ex1(k,j,i) );
   #endif
 #endif // GEOMETRY
 
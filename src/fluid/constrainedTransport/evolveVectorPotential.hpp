@@ -23,17 +23,19 @@ void ConstrainedTransport<Phys>::EvolveVectorPotential(real dt, IdefixArray4D<re
     IdefixArray3D<real> Ex1 = this->ex;
     IdefixArray3D<real> Ex2 = this->ey;
     IdefixArray3D<real> Ex3 = this->ez;
+    // The potential is updated in realc (double precision in mixed precision)
+    const realc dtc = dt;
     idefix_for("EvolvVectorPotential",
       data->beg[KDIR],data->end[KDIR]+KOFFSET,
       data->beg[JDIR],data->end[JDIR]+JOFFSET,
       data->beg[IDIR],data->end[IDIR]+IOFFSET,
       KOKKOS_LAMBDA (int k, int j, int i) {
         #if DIMENSIONS == 3
-          Ve(AX1e,k,j,i) += - dt * Ex1(k,j,i);
-          Ve(AX2e,k,j,i) += - dt * Ex2(k,j,i);
+          Ve(AX1e,k,j,i) += - dtc * Ex1(k,j,i);
+          Ve(AX2e,k,j,i) += - dtc * Ex2(k,j,i);
         #endif
         #if DIMENSIONS >= 2
-          Ve(AX3e,k,j,i) += - dt * Ex3(k,j,i);
+          Ve(AX3e,k,j,i) += - dtc * Ex3(k,j,i);
         #endif
       });
 
@@ -128,9 +130,9 @@ void ConstrainedTransport<Phys>::ComputeMagFieldFromA(IdefixArray4D<real> &Vein,
                   -  (Ve(AX1e,k,j+1,i) - Ve(AX1e,k,j,i) ) / dx2(j) );
     #endif
   #elif GEOMETRY == SPHERICAL
-    real dV2  = dmu(j);
-    real Ax2p = FABS(sinx2m(j+1));
-    real Ax2m = FABS(sinx2m(j));
+    realc dV2  = dmu(j);
+    realc Ax2p = FABS(sinx2m(j+1));
+    realc Ax2m = FABS(sinx2m(j));
 
     Vs(BX1s,k,j,i) = D_EXPAND( ZERO_F                                                        ,
                     + 1/(x1m(i)*dV2) * ( Ax2p*Ve(AX3e,k,j+1,i) - Ax2m*Ve(AX3e,k,j,i) )    ,
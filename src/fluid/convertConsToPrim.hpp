@@ -13,7 +13,7 @@
 #include "tracer.hpp"
 
 template <typename Phys>
-KOKKOS_INLINE_FUNCTION void K_ConsToPrim(real Vc[], real Uc[], const EquationOfState *eos) {
+KOKKOS_INLINE_FUNCTION void K_ConsToPrim(realc Vc[], realc Uc[], const EquationOfState *eos) {
   Vc[RHO] = Uc[RHO];
 
   EXPAND( Vc[VX1] = Uc[MX1]/Uc[RHO];  ,
@@ -28,12 +28,12 @@ KOKKOS_INLINE_FUNCTION void K_ConsToPrim(real Vc[], real Uc[], const EquationOfS
 
 
   if constexpr(Phys::pressure) {
-    real kin = HALF_F / Uc[RHO] * (EXPAND( Uc[MX1]*Uc[MX1]   ,
+    realc kin = HALF_F / Uc[RHO] * (EXPAND( Uc[MX1]*Uc[MX1]   ,
                                     + Uc[MX2]*Uc[MX2]  ,
                                     + Uc[MX3]*Uc[MX3]  ));
 
     if constexpr(Phys::mhd) {
-      real mag = HALF_F * (EXPAND( Uc[BX1]*Uc[BX1]   ,
+      realc mag = HALF_F * (EXPAND( Uc[BX1]*Uc[BX1]   ,
                           + Uc[BX2]*Uc[BX2]  ,
                           + Uc[BX3]*Uc[BX3]  ));
 
@@ -67,7 +67,7 @@ KOKKOS_INLINE_FUNCTION void K_ConsToPrim(real Vc[], real Uc[], const EquationOfS
 }
 
 template <typename Phys>
-KOKKOS_INLINE_FUNCTION void K_PrimToCons(real Uc[], real Vc[], const EquationOfState *eos) {
+KOKKOS_INLINE_FUNCTION void K_PrimToCons(realc Uc[], realc Vc[], const EquationOfState *eos) {
   Uc[RHO] = Vc[RHO];
 
   EXPAND( Uc[MX1] = Vc[VX1]*Vc[RHO];  ,
@@ -105,7 +105,43 @@ KOKKOS_INLINE_FUNCTION void K_PrimToCons(real Uc[], real Vc[], const EquationOfS
 template<typename Phys>
 void Fluid<Phys>::ConvertConsToPrim() {
   idfx::pushRegion("Fluid::ConvertConsToPrim");
+  ConsToPrimImpl(false, ONE_F, ZERO_F, this->Uc);
+  idfx::popRegion();
+}
+
+// Combine the conservative variables with a stored state (Uc = wc*Uc + w0*Uc0), and convert
+// them to primitive variables in the same pass
+template<typename Phys>
+void Fluid<Phys>::ConvertConsToPrim(const real wc, const real w0, StateContainer &stored) {
+  idfx::pushRegion("Fluid::ConvertConsToPrim(stage)");
+
+  if constexpr(Phys::mhd) {
+    // Face (or edge) centered fields are combined first, since the cell-centered field
+    // is reconstructed from them
+    IdefixArray4D<real> B0 = stored.GetArray(magState);
+    IdefixArray4D<real> B;
+    #ifdef EVOLVE_VECTOR_POTENTIAL
+      B = this->Ve;
+    #else
+      B = this->Vs;
+    #endif
+    idefix_for("ConsToPrim_CombineFaces",
+                0, B.extent(0),
+                0, B.extent(1),
+                0, B.extent(2),
+                0, B.extent(3),
+                KOKKOS_LAMBDA(int n, int k, int j, int i) {
+                  B(n,k,j,i) = wc * B(n,k,j,i) + w0 * B0(n,k,j,i);
+                } );
+  }
+
+  ConsToPrimImpl(true, wc, w0, stored.GetArray(ucState));
+  idfx::popRegion();
+}
 
+template<typename Phys>
+void Fluid<Phys>::ConsToPrimImpl(const bool combine, const real wc, const real w0,
+                                 IdefixArray4D<real> Uc0) {
   IdefixArray4D<real> Vc = this->Vc;
   IdefixArray4D<real> Uc = this->Uc;
   EquationOfState eos;
@@ -113,20 +149,36 @@ void Fluid<Phys>::ConvertConsToPrim() {
     eos = *(this->eos.get());
   }
 
+  // Cell-centered field components reconstructed from Vs should not be combined
+  int nvFaceBeg = Phys::nvar;
+  int nvFaceEnd = Phys::nvar;
   if constexpr(Phys::mhd) {
     #ifdef EVOLVE_VECTOR_POTENTIAL
       emf->ComputeMagFieldFromA(Ve,Vs);
     #endif
     boundary->ReconstructVcField(Uc);
+    nvFaceBeg = BX1;
+    nvFaceEnd = BX1+DIMENSIONS;
   }
+  const int nvTot = Uc.extent(0);
 
+  idfx::DeclareTraffic(idfx::BytesPerCell(Uc) * (combine ? 2 : 1),
+                       idfx::BytesPerCell(Vc) + (combine ? idfx::BytesPerCell(Uc) : 0));
   idefix_for("ConsToPrim",
              0,data->np_tot[KDIR],
              0,data->np_tot[JDIR],
              0,data->np_tot[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i) {
-      real U[Phys::nvar];
-      real V[Phys::nvar];
+      realc U[Phys::nvar];
+      realc V[Phys::nvar];
+
+      if(combine) {
+        for(int nv = 0 ; nv < nvTot; nv++) {
+          if(nv < nvFaceBeg || nv >= nvFaceEnd) {
+            Uc(nv,k,j,i) = wc * Uc(nv,k,j,i) + w0 * Uc0(nv,k,j,i);
+          }
+        }
+      }
 
 #pragma unroll
       for(int nv = 0 ; nv < Phys::nvar; nv++) {
@@ -144,15 +196,35 @@ void Fluid<Phys>::ConvertConsToPrim() {
   if(haveTracer) {
     tracer->ConvertConsToPrim();
   }
-
-  idfx::popRegion();
 }
 
 // Convert Primitive to conservative variables
 template<typename Phys>
 void Fluid<Phys>::ConvertPrimToCons() {
   idfx::pushRegion("Fluid::ConvertPrimToCons");
+  PrimToConsImpl(false, this->Uc);
+  idfx::popRegion();
+}
+
+// Convert Primitive to conservative variables, and store them in the given state
+// in the same pass
+template<typename Phys>
+void Fluid<Phys>::ConvertPrimToCons(StateContainer &stored) {
+  idfx::pushRegion("Fluid::ConvertPrimToCons(store)");
+  PrimToConsImpl(true, stored.GetArray(ucState));
 
+  if constexpr(Phys::mhd) {
+    #ifdef EVOLVE_VECTOR_POTENTIAL
+      Kokkos::deep_copy(stored.GetArray(magState), this->Ve);
+    #else
+      Kokkos::deep_copy(stored.GetArray(magState), this->Vs);
+    #endif
+  }
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void Fluid<Phys>::PrimToConsImpl(const bool store, IdefixArray4D<real> Uc0) {
   IdefixArray4D<real> Vc = this->Vc;
   IdefixArray4D<real> Uc = this->Uc;
   EquationOfState eos;
@@ -160,13 +232,15 @@ void Fluid<Phys>::ConvertPrimToCons() {
     eos = *(this->eos.get());
   }
 
+  idfx::DeclareTraffic(idfx::BytesPerCell(Vc), idfx::BytesPerCell(Uc) * (store ? 2 : 1));
+
   idefix_for("ConvertPrimToCons",
              0,data->np_tot[KDIR],
              0,data->np_tot[JDIR],
              0,data->np_tot[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i) {
-      real U[Phys::nvar];
-      real V[Phys::nvar];
+      realc U[Phys::nvar];
+      realc V[Phys::nvar];
 
 #pragma unroll
       for(int nv = 0 ; nv < Phys::nvar; nv++) {
@@ -178,14 +252,19 @@ void Fluid<Phys>::ConvertPrimToCons() {
 #pragma unroll
       for(int nv = 0 ; nv<Phys::nvar; nv++) {
         Uc(nv,k,j,i) = U[nv];
+        if(store) Uc0(nv,k,j,i) = U[nv];
       }
   });
 
   if(haveTracer) {
     tracer->ConvertPrimToCons();
+    if(store) {
+      // Tracers are converted separately, store them once converted
+      auto range = std::make_pair(static_cast<int>(Phys::nvar), static_cast<int>(Uc.extent(0)));
+      Kokkos::deep_copy(Kokkos::subview(Uc0, range, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL),
+                        Kokkos::subview(Uc, range, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL));
+    }
   }
-
-  idfx::popRegion();
 }
 
 #endif //FLUID_CONVERTCONSTOPRIM_HPP_
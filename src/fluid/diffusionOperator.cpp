@@ -0,0 +1,284 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <vector>
+
+#include "diffusionOperator.hpp"
+#include "dataBlock.hpp"
+
+DiffusionOperator::DiffusionOperator(DataBlock *datain, real thetaIn,
+                                     bool havePreconditionerIn) {
+  idfx::pushRegion("DiffusionOperator::DiffusionOperator");
+  this->data = datain;
+  this->theta = thetaIn;
+  this->havePreconditioner = havePreconditionerIn;
+
+  this->np_tot = data->np_tot;
+  this->np_int = data->np_int;
+  this->nghost = data->nghost;
+  this->beg = data->beg;
+  this->end = data->end;
+
+  // Map the boundary conditions of the datablock
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    for(int side = 0 ; side < 2 ; side++) {
+      BoundaryType bc = (side == 0) ? data->lbound[dir] : data->rbound[dir];
+      DiffusionBoundaryType type;
+      switch(bc) {
+        case internal:
+          type = internalmpi;
+          break;
+        case periodic:
+          type = periodic;
+          break;
+        case outflow:
+        case reflective:
+        case axis:
+          type = nullgrad;
+          break;
+        case userdef:
+        case undefined:
+          type = fixed;
+          break;
+        default:
+          IDEFIX_ERROR("DiffusionOperator:: implicit diffusion is not compatible with "
+                       "shearing box boundaries");
+      }
+      if(side == 0) {
+        lbound[dir] = type;
+      } else {
+        rbound[dir] = type;
+      }
+    }
+  }
+
+  this->capacity = IdefixArray3D<real>("DiffusionOperator_capacity", np_tot[KDIR],
+                                                                     np_tot[JDIR],
+                                                                     np_tot[IDIR]);
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    this->coupling[dir] = IdefixArray3D<real>("DiffusionOperator_coupling",
+                                              np_tot[KDIR]+(dir == KDIR),
+                                              np_tot[JDIR]+(dir == JDIR),
+                                              np_tot[IDIR]+(dir == IDIR));
+  }
+  if(havePreconditioner) {
+    this->precond = IdefixArray3D<real>("DiffusionOperator_precond", np_tot[KDIR],
+                                                                     np_tot[JDIR],
+                                                                     np_tot[IDIR]);
+  }
+
+  // Init MPI stack when needed
+  #ifdef WITH_MPI
+    this->arr4D = IdefixArray4D<real> ("WorkingArrayMpi", idfx::ArrayLayout4D(1, this->np_tot[KDIR],
+                                                            this->np_tot[JDIR],
+                                                            this->np_tot[IDIR]));
+
+    std::vector<int> mapVars;
+    mapVars.push_back(0);
+
+    this->mpi.Init(data->mygrid, mapVars, this->nghost.data(), this->np_int.data());
+  #endif
+
+  idfx::popRegion();
+}
+
+void DiffusionOperator::ComputePreconditioner() {
+  idfx::pushRegion("DiffusionOperator::ComputePreconditioner");
+  IdefixArray3D<real> P = this->precond;
+  IdefixArray3D<real> C = this->capacity;
+  IdefixArray3D<real> K1 = this->coupling[IDIR];
+  #if DIMENSIONS > 1
+  IdefixArray3D<real> K2 = this->coupling[JDIR];
+  #endif
+  #if DIMENSIONS > 2
+  IdefixArray3D<real> K3 = this->coupling[KDIR];
+  #endif
+  const real theta = this->theta;
+
+  idefix_for("DiffusionPrecond", beg[KDIR], end[KDIR], beg[JDIR], end[JDIR], beg[IDIR], end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      real diag = K1(k,j,i) + K1(k,j,i+1);
+      #if DIMENSIONS > 1
+      diag += K2(k,j,i) + K2(k,j+1,i);
+      #endif
+      #if DIMENSIONS > 2
+      diag += K3(k,j,i) + K3(k+1,j,i);
+      #endif
+      P(k,j,i) = C(k,j,i) + theta*diag;
+    });
+  idfx::popRegion();
+}
+
+void DiffusionOperator::operator()(IdefixArray3D<real> in, IdefixArray3D<real> out) {
+  idfx::pushRegion("DiffusionOperator::operator()");
+  IdefixArray3D<real> C = this->capacity;
+  IdefixArray3D<real> P = this->precond;
+  IdefixArray3D<real> K1 = this->coupling[IDIR];
+  #if DIMENSIONS > 1
+  IdefixArray3D<real> K2 = this->coupling[JDIR];
+  #endif
+  #if DIMENSIONS > 2
+  IdefixArray3D<real> K3 = this->coupling[KDIR];
+  #endif
+  const real theta = this->theta;
+  const bool havePreconditioner = this->havePreconditioner;
+
+  // Handling boundaries before the operator calculation
+  this->SetBoundaries(in);
+
+  idefix_for("DiffusionOperator", beg[KDIR], end[KDIR], beg[JDIR], end[JDIR], beg[IDIR], end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real x0 = in(k,j,i);
+      real flux = K1(k,j,i+1)*(in(k,j,i+1)-x0) + K1(k,j,i)*(in(k,j,i-1)-x0);
+      #if DIMENSIONS > 1
+      flux += K2(k,j+1,i)*(in(k,j+1,i)-x0) + K2(k,j,i)*(in(k,j-1,i)-x0);
+      #endif
+      #if DIMENSIONS > 2
+      flux += K3(k+1,j,i)*(in(k+1,j,i)-x0) + K3(k,j,i)*(in(k-1,j,i)-x0);
+      #endif
+      real result = C(k,j,i)*x0 - theta*flux;
+      if(havePreconditioner) result = result/P(k,j,i);
+      out(k,j,i) = result;
+    });
+
+  idfx::popRegion();
+}
+
+// Sum of the diffusive fluxes of a field (which ghost zones are assumed to be set)
+void DiffusionOperator::ComputeRHS(IdefixArray3D<real> &field, IdefixArray3D<real> &rhs) {
+  idfx::pushRegion("DiffusionOperator::ComputeRHS");
+  IdefixArray3D<real> P = this->precond;
+  IdefixArray3D<real> K1 = this->coupling[IDIR];
+  #if DIMENSIONS > 1
+  IdefixArray3D<real> K2 = this->coupling[JDIR];
+  #endif
+  #if DIMENSIONS > 2
+  IdefixArray3D<real> K3 = this->coupling[KDIR];
+  #endif
+  const bool havePreconditioner = this->havePreconditioner;
+
+  idefix_for("DiffusionRHS", beg[KDIR], end[KDIR], beg[JDIR], end[JDIR], beg[IDIR], end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real x0 = field(k,j,i);
+      real flux = K1(k,j,i+1)*(field(k,j,i+1)-x0) + K1(k,j,i)*(field(k,j,i-1)-x0);
+      #if DIMENSIONS > 1
+      flux += K2(k,j+1,i)*(field(k,j+1,i)-x0) + K2(k,j,i)*(field(k,j-1,i)-x0);
+      #endif
+      #if DIMENSIONS > 2
+      flux += K3(k+1,j,i)*(field(k+1,j,i)-x0) + K3(k,j,i)*(field(k-1,j,i)-x0);
+      #endif
+      if(havePreconditioner) flux = flux/P(k,j,i);
+      rhs(k,j,i) = flux;
+    });
+
+  idfx::popRegion();
+}
+
+void DiffusionOperator::SetBoundaries(IdefixArray3D<real> &arr) {
+  idfx::pushRegion("DiffusionOperator::SetBoundaries");
+
+  #ifdef WITH_MPI
+  this->arr4D = IdefixArray4D<real> (arr.data(), idfx::ArrayLayout4D(1, this->np_tot[KDIR],
+                                                    this->np_tot[JDIR],
+                                                    this->np_tot[IDIR], false));
+  #endif
+
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    // MPI Exchange data when needed
+    #ifdef WITH_MPI
+    if(data->mygrid->nproc[dir]>1) {
+      switch(dir) {
+        case 0:
+          this->mpi.ExchangeX1(this->arr4D);
+          break;
+        case 1:
+          this->mpi.ExchangeX2(this->arr4D);
+          break;
+        case 2:
+          this->mpi.ExchangeX3(this->arr4D);
+          break;
+      }
+    }
+    #endif
+
+    EnforceBoundary(dir, left, this->lbound[dir], arr);
+    EnforceBoundary(dir, right, this->rbound[dir], arr);
+  }
+
+  idfx::popRegion();
+}
+
+void DiffusionOperator::EnforceBoundary(int dir, BoundarySide side, DiffusionBoundaryType type,
+                                        IdefixArray3D<real> &arr) {
+  idfx::pushRegion("DiffusionOperator::EnforceBoundary");
+
+  IdefixArray3D<real> localVar = arr;
+
+  // Number of active cells
+  const int nxi = this->np_int[IDIR];
+  const int nxj = this->np_int[JDIR];
+  const int nxk = this->np_int[KDIR];
+
+  // Number of ghost cells
+  const int ighost = this->nghost[IDIR];
+  const int jghost = this->nghost[JDIR];
+  const int kghost = this->nghost[KDIR];
+
+  // Boundaries of the loop
+  const int ibeg = (dir == IDIR) ? side*(ighost+nxi) : 0;
+  const int iend = (dir == IDIR) ? ighost + side*(ighost+nxi) : this->np_tot[IDIR];
+  const int jbeg = (dir == JDIR) ? side*(jghost+nxj) : 0;
+  const int jend = (dir == JDIR) ? jghost + side*(jghost+nxj) : this->np_tot[JDIR];
+  const int kbeg = (dir == KDIR) ? side*(kghost+nxk) : 0;
+  const int kend = (dir == KDIR) ? kghost + side*(kghost+nxk) : this->np_tot[KDIR];
+
+  switch(type) {
+    case internalmpi:
+      // internal is used for MPI-enforced boundary conditions. Nothing to be done here.
+      break;
+
+    case periodic: {
+      if(data->mygrid->nproc[dir] > 1) break; // Periodicity already enforced by MPI calls
+
+      idefix_for("BoundaryPeriodic", kbeg, kend, jbeg, jend, ibeg, iend,
+            KOKKOS_LAMBDA (int k, int j, int i) {
+              const int iref = (dir==IDIR) ? ighost + (i+ighost*(nxi-1))%nxi : i;
+              const int jref = (dir==JDIR) ? jghost + (j+jghost*(nxj-1))%nxj : j;
+              const int kref = (dir==KDIR) ? kghost + (k+kghost*(nxk-1))%nxk : k;
+
+              localVar(k,j,i) = localVar(kref,jref,iref);
+      });
+      break;
+    }
+
+    case nullgrad: {
+      idefix_for("BoundaryNullGrad", kbeg, kend, jbeg, jend, ibeg, iend,
+            KOKKOS_LAMBDA (int k, int j, int i) {
+              const int iref = (dir==IDIR) ? ighost + side*(nxi-1) : i;
+              const int jref = (dir==JDIR) ? jghost + side*(nxj-1) : j;
+              const int kref = (dir==KDIR) ? kghost + side*(nxk-1) : k;
+
+              localVar(k,j,i) = localVar(kref,jref,iref);
+      });
+      break;
+    }
+
+    case fixed: {
+      idefix_for("BoundaryFixed", kbeg, kend, jbeg, jend, ibeg, iend,
+            KOKKOS_LAMBDA (int k, int j, int i) {
+              localVar(k,j,i) = ZERO_F;
+      });
+      break;
+    }
+
+    default: {
+      IDEFIX_ERROR("DiffusionOperator:: Boundary condition type is not yet implemented");
+    }
+  }
+
+  idfx::popRegion();
+}
@@ -0,0 +1,72 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_DIFFUSIONOPERATOR_HPP_
+#define FLUID_DIFFUSIONOPERATOR_HPP_
+
+#include <array>
+#include "idefix.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Linear operator of an implicit step for a scalar diffusion equation C dx/dt = div(K grad x).
+/// It is written in volume-integrated form for the increment dx over the step:
+///   A(dx) = C dV dx - theta sum_faces coupling (dx_neighbour - dx)
+/// where coupling = dt*K*area/dl is defined on the left face of each cell, and theta=1
+/// (backward Euler) or 1/2 (Crank-Nicolson). A is symmetric positive definite, and is used
+/// by the iterative solvers in the same way as the self-gravity Laplacian.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+class DiffusionOperator {
+ public:
+  // Types of boundary which can be treated
+  enum DiffusionBoundaryType {internalmpi,   // exchanged by MPI
+                              periodic,
+                              nullgrad,      // no diffusive flux through the boundary
+                              fixed};        // ghost values are kept (null increment)
+
+  DiffusionOperator(DataBlock *, real, bool);
+
+  // The main operator
+  void operator() (IdefixArray3D<real> in,  IdefixArray3D<real> out);
+
+  void SetBoundaries(IdefixArray3D<real> &);  // Set the proper boundaries for the given array
+  void ComputeRHS(IdefixArray3D<real> &, IdefixArray3D<real> &); // diffusive fluxes of a field
+  void ComputePreconditioner();   // Diagonal preconditioner (to be called once C and K are set)
+
+  IdefixArray3D<real> capacity;                 ///< C dV
+  std::array<IdefixArray3D<real>,3> coupling;   ///< dt*K*area/dl on the left face of each cell
+  IdefixArray3D<real> precond;                  ///< Diagonal preconditionner
+
+  // Local array size
+  std::array<int,3> np_tot;
+  std::array<int,3> np_int;
+  std::array<int,3> nghost;
+  std::array<int,3> beg;
+  std::array<int,3> end;
+
+  real theta;                    ///< implicitness of the scheme
+  bool havePreconditioner{false};
+
+ private:
+  void EnforceBoundary(int, BoundarySide, DiffusionBoundaryType, IdefixArray3D<real> &);
+
+  std::array<DiffusionBoundaryType,3> lbound;
+  std::array<DiffusionBoundaryType,3> rbound;
+
+  DataBlock *data;
+
+  #ifdef WITH_MPI
+  Mpi mpi;  // Mpi object when WITH_MPI is set
+  IdefixArray4D<real> arr4D; // Intermediate array for boundary handling
+  #endif
+};
+
+#endif // FLUID_DIFFUSIONOPERATOR_HPP_
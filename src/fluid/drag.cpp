@@ -26,10 +26,14 @@ void Drag::AddDragForce(const real dt) {
   auto gammaDrag = this->gammaDrag;
   gammaDrag.RefreshUserDrag(data);
 
+  auto mask = this->activeMask;
+  const int species = this->instanceNumber;
+
   // Compute a drag force fd = - gamma*rhod*rhog*(vd-vg)
   // Where gamma is computed according to the choice of drag type
   idefix_for("DragForce",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i) {
+      if(!mask.IsActive(species,k,j,i)) return;
       real gamma = gammaDrag.GetGamma(k,j,i);  // The drag coefficient
 
       real dp = dt * gamma * VcDust(RHO,k,j,i) * VcGas(RHO,k,j,i);
@@ -83,10 +87,21 @@ void Drag::AddImplicitBackReaction(const real dt, IdefixArray3D<real> preFactor)
   auto gammaDrag = this->gammaDrag;
   gammaDrag.RefreshUserDrag(data);
 
+  auto mask = this->activeMask;
+  const int species = this->instanceNumber;
+
   // Compute a drag force fd = - gamma*rhod*rhog*(vd-vg)
   // Where gamma is computed according to the choice of drag type
-  idefix_for("DragForce",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
+  idefix_for("DragForce",
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i) {
+      // Inactive cells do not contribute (but the prefactor is still initialised)
+      if(!mask.IsActive(species,k,j,i)) {
+        if(isFirst) preFactor(k,j,i) = ZERO_F;
+        return;
+      }
       real gamma = gammaDrag.GetGamma(k,j,i);  // The drag coefficient
 
 
@@ -121,7 +136,10 @@ void Drag::NormalizeImplicitBackReaction(const real dt) {
 
   // Compute a drag force fd = - gamma*rhod*rhog*(vd-vg)
   // Where gamma is computed according to the choice of drag type
-  idefix_for("DragForce",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
+  idefix_for("DragForce",
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i) {
       const real factor = 1+preFactor(k,j,i);
       for(int n = MX1 ; n < MX1+COMPONENTS ; n++) {
@@ -149,10 +167,17 @@ void Drag::AddImplicitFluidMomentum(const real dt) {
   auto gammaDrag = this->gammaDrag;
   if(!feedback) gammaDrag.RefreshUserDrag(data);
 
+  auto mask = this->activeMask;
+  const int species = this->instanceNumber;
+
   // Compute a drag force fd = - gamma*rhod*rhog*(vd-vg)
   // Where gamma is computed according to the choice of drag type
-  idefix_for("DragForce",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
+  idefix_for("DragForce",
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i) {
+      if(!mask.IsActive(species,k,j,i)) return;
       real gamma = gammaDrag.GetGamma(k,j,i);  // The drag coefficient
 
       for(int n = MX1 ; n < MX1+COMPONENTS ; n++) {
@@ -175,6 +200,89 @@ void Drag::AddImplicitFluidMomentum(const real dt) {
   idfx::popRegion();
 }
 
+// Implicit drag of all of the species of a DustBatch in a single pass: the gas momentum is
+// first updated with the back reaction of all of the species, then each species relaxes
+// towards the new gas momentum (same scheme as the three functions above). As in these
+// functions, only the active cells are updated, since the ghost cells are refilled by the
+// boundary conditions.
+void Drag::AddImplicitDragBatch(const real dt) {
+  idfx::pushRegion("Drag::AddImplicitDragBatch");
+
+  if(!implicit) {
+    IDEFIX_ERROR("AddImplicitDragBatch should not be called when drag is explicit");
+  }
+
+  // User-defined drag coefficients of all of the species
+  for(int s = 0 ; s < data->dust.size() ; s++) {
+    data->dust[s]->drag->gammaDrag.RefreshUserDrag(data);
+  }
+
+  auto UcGas = this->UcGas;
+  auto UcDust = data->dustBatch->Uc;
+  auto VcDust = data->dustBatch->Vc;
+  auto gammaUser = data->dustBatch->dragGamma;
+  auto coeff = this->batchDragCoeff;
+  const int nSpecies = data->dustBatch->nSpecies;
+  const bool userdef = gammaDrag.type == GammaDrag::Type::Userdef;
+  auto mask = this->activeMask;
+
+  bool feedback = this->feedback;
+
+  auto gammaDrag = this->gammaDrag;
+
+  idefix_for("ImplicitDragBatch",
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real rhoGas = UcGas(RHO,k,j,i);
+      real mGas[COMPONENTS];
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        mGas[n] = UcGas(MX1+n,k,j,i);
+      }
+
+      // Back reaction of all of the species on the gas
+      if(feedback) {
+        real preFactor = ZERO_F;
+        for(int s = 0 ; s < nSpecies ; s++) {
+          if(!mask.IsActive(s,k,j,i)) continue;
+          const int o = s*DustPhysics::nvar;
+          const real gamma = gammaDrag.GetGamma(k, j, i, coeff(s),
+                                                userdef ? gammaUser(s,k,j,i) : ZERO_F);
+          preFactor += UcDust(o+RHO,k,j,i)*gamma*dt/(1+rhoGas*gamma*dt);
+          for(int n = 0 ; n < COMPONENTS ; n++) {
+            mGas[n] += dt * gamma * rhoGas * UcDust(o+MX1+n,k,j,i) / (1 + rhoGas*dt*gamma);
+          }
+        }
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          mGas[n] /= 1+preFactor;
+          UcGas(MX1+n,k,j,i) = mGas[n];
+        }
+      }
+
+      // Relaxation of each species towards the gas momentum
+      [[maybe_unused]] real dEnergy = ZERO_F;
+      for(int s = 0 ; s < nSpecies ; s++) {
+        if(!mask.IsActive(s,k,j,i)) continue;
+        const int o = s*DustPhysics::nvar;
+        const real gamma = gammaDrag.GetGamma(k, j, i, coeff(s),
+                                              userdef ? gammaUser(s,k,j,i) : ZERO_F);
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          const real oldUc = UcDust(o+MX1+n,k,j,i);
+          const real newUc = (oldUc + dt * gamma * UcDust(o+RHO,k,j,i) * mGas[n]) /
+                             (1 + rhoGas*dt*gamma);
+          UcDust(o+MX1+n,k,j,i) = newUc;
+          // Energy dissipated for the dust, added back to the gas (see AddDragForce)
+          dEnergy -= (newUc - oldUc)*VcDust(o+VX1+n,k,j,i);
+        }
+      }
+      #if HAVE_ENERGY == 1
+        if(feedback) UcGas(ENG,k,j,i) += dEnergy;
+      #endif
+    });
+  idfx::popRegion();
+}
+
 void Drag::ShowConfig() {
   idfx::cout << "Drag: Using ";
   if(implicit) {
@@ -246,10 +354,16 @@ GammaDrag::GammaDrag(Input &input, std::string BlockName, int instanceNumber, Da
       this->VcGas = data->hydro->Vc;
     } else if(dragType.compare("userdef") == 0) {
       this->type = Type::Userdef;
-      this->gammai = IdefixArray3D<real>("UserDrag",
-                                  data->np_tot[KDIR],
-                                  data->np_tot[JDIR],
-                                  data->np_tot[IDIR]);
+      if(data->dustBatch) {
+        // Our coefficient is stored with the ones of the other species of the batch
+        this->gammai = Kokkos::subview(data->dustBatch->dragGamma, instanceNumber,
+                                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+      } else {
+        this->gammai = IdefixArray3D<real>("UserDrag",
+                                    data->np_tot[KDIR],
+                                    data->np_tot[JDIR],
+                                    data->np_tot[IDIR]);
+      }
     } else {
       std::stringstream msg;
       msg << "Unknown drag type \"" <<  dragType
@@ -12,6 +12,7 @@
 #include "input.hpp"
 #include "fluid_defs.hpp"
 #include "eos.hpp"
+#include "dustMask.hpp"
 
 using UserDefDragFunc = void (*) (DataBlock *, int n, real beta, IdefixArray3D<real> &gammai);
 
@@ -25,13 +26,20 @@ class GammaDrag {
   void RefreshUserDrag(DataBlock *);
 
   KOKKOS_INLINE_FUNCTION real GetGamma(const int k, const int j, const int i) const {
+    return GetGamma(k, j, i, dragCoeff, (type == Type::Userdef) ? gammai(k,j,i) : ZERO_F);
+  }
+
+  // Same drag law, with the drag parameter beta and the user-defined coefficient gammaUser
+  // of any species
+  KOKKOS_INLINE_FUNCTION real GetGamma(const int k, const int j, const int i,
+                                       const real beta, const real gammaUser) const {
     real gamma;  // The drag coefficient
     if(type ==  Type::Gamma) {
-      gamma = dragCoeff;
+      gamma = beta;
 
     } else if(type == Type::Tau) {
       // In this case, the coefficient is the stopping time (assumed constant)
-      gamma = 1/(dragCoeff*VcGas(RHO,k,j,i));
+      gamma = 1/(beta*VcGas(RHO,k,j,i));
     } else if(type == Type::Size) {
       real cs;
       // Assume a fixed size, hence for both Epstein or Stokes, gamma~1/rho_g/cs
@@ -42,9 +50,9 @@ class GammaDrag {
       #else
         cs = eos.GetWaveSpeed(k,j,i);
       #endif
-      gamma = cs/dragCoeff;
+      gamma = cs/beta;
     } else if(type == Type::Userdef) {
-      gamma = gammai(k,j,i);
+      gamma = gammaUser;
     }
     return gamma;
   }
@@ -73,6 +81,7 @@ class Drag {
   void AddImplicitBackReaction(const real, IdefixArray3D<real>);  // Add the back reaction
   void NormalizeImplicitBackReaction(const real);  // Normalize the implicit back reaction
   void AddImplicitFluidMomentum(const real);  // Add the implicit drag force on dust grains
+  void AddImplicitDragBatch(const real);  // Same for all of the species of a DustBatch at once
   /////////////////////////
 
   void EnrollUserDrag(UserDefDragFunc);   // User defined drag function enrollment
@@ -84,6 +93,8 @@ class Drag {
   IdefixArray4D<real> VcGas;  // Gas primitive quantities
   IdefixArray3D<real> InvDt;  // The InvDt of current dust specie
   IdefixArray3D<real> implicitFactor; // The prefactor used by the implicit timestepping
+  IdefixArray1D<real> batchDragCoeff; // Drag parameters of all of the species of a DustBatch
+  DustMask activeMask;        // Active regions of the dust species
 
   GammaDrag gammaDrag;  // The drag law
 
@@ -108,6 +119,7 @@ Drag::Drag(Input &input, Fluid<Phys> *hydroin):
   // Save the parent hydro object
 
   this->data = hydroin->data;
+  this->activeMask = hydroin->activeMask;
 
   // Check in which block we should fetch our information
   std::string blockName;
@@ -126,10 +138,21 @@ Drag::Drag(Input &input, Fluid<Phys> *hydroin):
     this->implicit = input.GetOrSet<bool>(blockName,"drag_implicit",0,false);
 
     if(implicit && instanceNumber == 0) {
-      this->implicitFactor = IdefixArray3D<real>("ImplicitFactor",
-                                  data->np_tot[KDIR],
-                                  data->np_tot[JDIR],
-                                  data->np_tot[IDIR]);
+      if(data->dustBatch) {
+        // The first species couples all of the species of the batch in a single kernel
+        const int nSpecies = data->dustBatch->nSpecies;
+        this->batchDragCoeff = IdefixArray1D<real>("BatchDragCoeff", nSpecies);
+        IdefixHostArray1D<real> coeffHost = Kokkos::create_mirror_view(batchDragCoeff);
+        for(int s = 0 ; s < nSpecies ; s++) {
+          coeffHost(s) = input.Get<real>(blockName,"drag",s+1);
+        }
+        Kokkos::deep_copy(batchDragCoeff, coeffHost);
+      } else {
+        this->implicitFactor = IdefixArray3D<real>("ImplicitFactor",
+                                    data->np_tot[KDIR],
+                                    data->np_tot[JDIR],
+                                    data->np_tot[IDIR]);
+      }
     }
 
   } else {
@@ -0,0 +1,278 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <string>
+
+#include "dustBatch.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "hllDust.hpp"
+
+DustBatch::DustBatch(Input &input, DataBlock *datain, int n) {
+  idfx::pushRegion("DustBatch::DustBatch");
+  this->data = datain;
+  this->nSpecies = n;
+
+  // The reconstruction is shared by all of the species, shock flags are not
+  if(input.CheckEntry("Dust","shockFlattening")>=0) {
+    IDEFIX_ERROR("Batched dust species are not compatible with shock flattening");
+  }
+
+  constexpr int nvar = DustPhysics::nvar;
+
+  Vc = IdefixArray4D<real>("Dust_Vc", idfx::ArrayLayout4D(nSpecies*nvar,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+  Uc = IdefixArray4D<real>("Dust_Uc", idfx::ArrayLayout4D(nSpecies*nvar,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+  FluxRiemann = IdefixArray4D<real>("Dust_FluxRiemann", idfx::ArrayLayout4D(nSpecies*nvar,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+  // These are sliced into the 3D arrays of each species, so the species index stays outermost
+  InvDt = IdefixArray4D<real>("Dust_InvDt", idfx::ArrayLayout4D(nSpecies,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR], false));
+  cMax = IdefixArray4D<real>("Dust_cMax", idfx::ArrayLayout4D(nSpecies,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR], false));
+
+  // User-defined drag coefficients, gathered for the fused implicit drag kernel
+  if(input.CheckEntry("Dust","drag")>=0
+      && input.Get<std::string>("Dust","drag",0).compare("userdef") == 0) {
+    dragGamma = IdefixArray4D<real>("Dust_UserDrag", idfx::ArrayLayout4D(nSpecies,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR], false));
+  }
+
+  // A single state for all of the species, so that the stages are combined in one pass
+  ucState = data->states["current"].PushArray(Uc, State::center, "Dust_Uc");
+
+  idfx::popRegion();
+}
+
+void DustBatch::ShowConfig() {
+  idfx::cout << "Dust: " << nSpecies << " species evolved with species-batched kernels."
+             << std::endl;
+}
+
+void DustBatch::ResetStage() {
+  idfx::pushRegion("DustBatch::ResetStage");
+  IdefixArray4D<real> InvDt = this->InvDt;
+
+  idefix_for("DustBatchResetStage",
+             0, nSpecies,
+             0, data->np_tot[KDIR],
+             0, data->np_tot[JDIR],
+             0, data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      InvDt(s,k,j,i) = ZERO_F;
+  });
+
+  idfx::popRegion();
+}
+
+void DustBatch::ConvertConsToPrim() {
+  idfx::pushRegion("DustBatch::ConvertConsToPrim");
+  ConsToPrimImpl(false, ONE_F, ZERO_F, this->Uc);
+  idfx::popRegion();
+}
+
+// Combine the conservative variables with a stored state (Uc = wc*Uc + w0*Uc0), and convert
+// them to primitive variables in the same pass
+void DustBatch::ConvertConsToPrim(const real wc, const real w0, StateContainer &stored) {
+  idfx::pushRegion("DustBatch::ConvertConsToPrim(stage)");
+  ConsToPrimImpl(true, wc, w0, stored.GetArray(ucState));
+  idfx::popRegion();
+}
+
+void DustBatch::ConvertPrimToCons() {
+  idfx::pushRegion("DustBatch::ConvertPrimToCons");
+  PrimToConsImpl(false, this->Uc);
+  idfx::popRegion();
+}
+
+void DustBatch::ConvertPrimToCons(StateContainer &stored) {
+  idfx::pushRegion("DustBatch::ConvertPrimToCons(store)");
+  PrimToConsImpl(true, stored.GetArray(ucState));
+  idfx::popRegion();
+}
+
+void DustBatch::ConsToPrimImpl(const bool combine, const real wc, const real w0,
+                               IdefixArray4D<real> Uc0) {
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<real> Uc = this->Uc;
+
+  idefix_for("DustBatch_ConsToPrim",
+             0, nSpecies,
+             0, data->np_tot[KDIR],
+             0, data->np_tot[JDIR],
+             0, data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      const int o = s*DustPhysics::nvar;
+      realc U[DustPhysics::nvar];
+      realc V[DustPhysics::nvar];
+
+#pragma unroll
+      for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+        if(combine) {
+          Uc(o+nv,k,j,i) = wc * Uc(o+nv,k,j,i) + w0 * Uc0(o+nv,k,j,i);
+        }
+        U[nv] = Uc(o+nv,k,j,i);
+      }
+
+      K_ConsToPrim<DustPhysics>(V,U,NULL);
+
+#pragma unroll
+      for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+        Vc(o+nv,k,j,i) = V[nv];
+      }
+  });
+}
+
+void DustBatch::PrimToConsImpl(const bool store, IdefixArray4D<real> Uc0) {
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<real> Uc = this->Uc;
+
+  idefix_for("DustBatch_PrimToCons",
+             0, nSpecies,
+             0, data->np_tot[KDIR],
+             0, data->np_tot[JDIR],
+             0, data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      const int o = s*DustPhysics::nvar;
+      realc U[DustPhysics::nvar];
+      realc V[DustPhysics::nvar];
+
+#pragma unroll
+      for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+        V[nv] = Vc(o+nv,k,j,i);
+      }
+
+      K_PrimToCons<DustPhysics>(U,V,NULL);
+
+#pragma unroll
+      for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+        Uc(o+nv,k,j,i) = U[nv];
+        if(store) Uc0(o+nv,k,j,i) = U[nv];
+      }
+  });
+}
+
+// Hyperbolic part of the stage for all of the species. The remaining terms (source terms,
+// drag) are added by each species in Fluid::EvolveStage
+void DustBatch::EvolveStage(const real t, const real dt) {
+  idfx::pushRegion("DustBatch::EvolveStage");
+  LoopDir<IDIR>(t, dt);
+  idfx::popRegion();
+}
+
+template<int dir>
+void DustBatch::LoopDir(const real t, const real dt) {
+  CalcFlux<dir>();
+  CalcRightHandSide<dir>(t, dt);
+
+  // Recursive: do next dimension
+  if constexpr (dir+1 < DIMENSIONS) LoopDir<dir+1>(t, dt);
+}
+
+// HLL fluxes of all of the species
+template<int dir>
+void DustBatch::CalcFlux() {
+  idfx::pushRegion("DustBatch::CalcFlux");
+
+  constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+  constexpr int joffset = (dir==JDIR) ? 1 : 0;
+  constexpr int koffset = (dir==KDIR) ? 1 : 0;
+
+  IdefixArray4D<real> Flux = this->FluxRiemann;
+  IdefixArray4D<real> cMax = this->cMax;
+  const int nSpecies = this->nSpecies;
+
+  // The reconstruction of the first species, working on the variables of the whole batch
+  ExtrapolateToFaces<DustPhysics,dir> extrapol = *data->dust[0]->rSolver->GetExtrapolator<dir>();
+  extrapol.Vc = this->Vc;
+  DustMask mask = data->dust[0]->activeMask;
+
+  idefix_for("DustBatch_HLL_Kernel",
+             data->beg[KDIR],data->end[KDIR]+koffset,
+             data->beg[JDIR],data->end[JDIR]+joffset,
+             data->beg[IDIR],data->end[IDIR]+ioffset,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      for(int s = 0 ; s < nSpecies ; s++) {
+        const int o = s*DustPhysics::nvar;
+        // Faces between two inactive cells carry no flux
+        if(!mask.IsFaceActive<dir>(s,k,j,i)) {
+          for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+            Flux(o+nv,k,j,i) = ZERO_F;
+          }
+          cMax(s,k,j,i) = ZERO_F;
+          continue;
+        }
+        realc vL[DustPhysics::nvar];
+        realc vR[DustPhysics::nvar];
+        realc flux[DustPhysics::nvar];
+
+        extrapol.ExtrapolatePrimVar(i, j, k, vL, vR, o);
+        realc cmax = K_HllDust<DustPhysics,dir>(vL, vR, flux);
+
+#pragma unroll
+        for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+          Flux(o+nv,k,j,i) = flux[nv];
+        }
+        cMax(s,k,j,i) = cmax;
+      }
+  });
+
+  idfx::popRegion();
+}
+
+// Flux corrections and flux divergence of all of the species
+template<int dir>
+void DustBatch::CalcRightHandSide(const real t, const real dt) {
+  idfx::pushRegion("DustBatch::CalcRightHandSide");
+
+  // Update fargo velocity when needed
+  if(data->haveFargo && data->fargo->type == Fargo::userdef) {
+    data->fargo->GetFargoVelocity(t);
+  }
+
+  // All of the species share the physics of the first one
+  Fluid<DustPhysics> *dust0 = data->dust[0].get();
+
+  auto fluxCorrection = Fluid_CorrectFluxFunctor<DustPhysics,dir>(dust0, dt);
+  fluxCorrection.SetBatch(nSpecies, FluxRiemann);
+
+  const int ioffset = (dir==IDIR) ? 1 : 0;
+  const int joffset = (dir==JDIR) ? 1 : 0;
+  const int koffset = (dir==KDIR) ? 1 : 0;
+  idefix_for("DustBatch_CorrectFlux",
+             data->beg[KDIR],data->end[KDIR]+koffset,
+             data->beg[JDIR],data->end[JDIR]+joffset,
+             data->beg[IDIR],data->end[IDIR]+ioffset,
+             fluxCorrection);
+
+  auto calcRHS = Fluid_CalcRHSFunctor<DustPhysics,dir>(dust0, dt);
+  calcRHS.SetBatch(nSpecies, Uc, Vc, FluxRiemann, InvDt, cMax);
+
+  idefix_for("DustBatch_CalcRightHandSide",
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
+             calcRHS);
+
+  idfx::popRegion();
+}
+
+real DustBatch::ComputeTimestep() {
+  IdefixArray4D<real> InvDt = this->InvDt;
+  real dt;
+  idefix_reduce("Timestep_reduction_dust_batch",
+          0, nSpecies,
+          data->beg[KDIR], data->end[KDIR],
+          data->beg[JDIR], data->end[JDIR],
+          data->beg[IDIR], data->end[IDIR],
+          KOKKOS_LAMBDA (int s, int k, int j, int i, real &dtmin) {
+                  dtmin=FMIN(ONE_F/InvDt(s,k,j,i),dtmin);
+              },
+          Kokkos::Min<real>(dt));
+  return(dt);
+}
@@ -0,0 +1,60 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_DUSTBATCH_HPP_
+#define FLUID_DUSTBATCH_HPP_
+
+#include "idefix.hpp"
+#include "input.hpp"
+#include "stateContainer.hpp"
+
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Species-batched storage of the dust fluids. The variables of all of the species are stored
+/// one after the other in the same arrays (species n uses the indices n*nvar...(n+1)*nvar-1),
+/// and each dust Fluid object works on a view of its own species. The conversions between
+/// primitive and conservative variables, the Riemann fluxes, the flux divergence and the
+/// timestep are then computed for all of the species in single kernels, while the boundary
+/// conditions, the drag laws, the source terms and the outputs are still handled by each
+/// species.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class DustBatch {
+ public:
+  DustBatch(Input &, DataBlock *, int);
+  void ResetStage();
+  void ConvertConsToPrim();
+  void ConvertConsToPrim(const real, const real, StateContainer &); // fused stage combination
+  void ConvertPrimToCons();
+  void ConvertPrimToCons(StateContainer &);   // and store the result
+  void EvolveStage(const real, const real);   // hyperbolic fluxes of all of the species
+  real ComputeTimestep();
+  void ShowConfig();
+
+  int nSpecies;                     // # of dust species in the batch
+
+  IdefixArray4D<real> Vc;           // Primitive variables of all of the species
+  IdefixArray4D<real> Uc;           // Conservative variables of all of the species
+  IdefixArray4D<real> FluxRiemann;  // Intercell fluxes of all of the species
+  IdefixArray4D<real> InvDt;        // Inverse timestep of each species
+  IdefixArray4D<real> cMax;         // Maximum propagation speed of each species
+  IdefixArray4D<real> dragGamma;    // User-defined drag coefficient of each species
+
+ private:
+  template <int> void LoopDir(const real, const real);
+  template <int> void CalcFlux();
+  template <int> void CalcRightHandSide(const real, const real);
+
+  void ConsToPrimImpl(const bool, const real, const real, IdefixArray4D<real>);
+  void PrimToConsImpl(const bool, IdefixArray4D<real>);
+
+  DataBlock *data;
+
+  int ucState{-1};                  // Index of Uc in the datablock states
+};
+
+#endif // FLUID_DUSTBATCH_HPP_
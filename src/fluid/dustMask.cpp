@@ -0,0 +1,131 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include "dustMask.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+
+DustMask::DustMask(Input &input, DataBlock *datain, int n) {
+  idfx::pushRegion("DustMask::DustMask");
+  this->data = datain;
+  this->nSpecies = n;
+
+  const int nThreshold = input.CheckEntry("Dust","mask_threshold");
+  densityThreshold = input.Get<real>("Dust","mask_threshold",0);
+  if(nThreshold > 1) {
+    fluxThreshold = input.Get<real>("Dust","mask_threshold",1);
+    haveFluxThreshold = true;
+  }
+
+  const int tile = input.GetOrSet<int>("Dust","mask_tile",0,8);
+  halo = input.GetOrSet<int>("Dust","mask_halo",0,1);
+  period = input.GetOrSet<int>("Dust","mask_period",0,10);
+  if(tile < 1 || halo < 0 || period < 1) {
+    IDEFIX_ERROR("[Dust] mask_tile and mask_period should be >= 1, and mask_halo >= 0");
+  }
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    tileSize[dir] = (dir < DIMENSIONS) ? tile : 1;
+    nTiles[dir] = (data->np_tot[dir] + tileSize[dir] - 1) / tileSize[dir];
+  }
+
+  active = IdefixArray4D<int>("DustMask_active", idfx::ArrayLayout4D(nSpecies, nTiles[KDIR],
+                                                                     nTiles[JDIR], nTiles[IDIR]));
+  seed = IdefixArray4D<int>("DustMask_seed", idfx::ArrayLayout4D(nSpecies, nTiles[KDIR],
+                                                                 nTiles[JDIR], nTiles[IDIR]));
+  // Everything is evolved until the first update
+  Kokkos::deep_copy(active, 1);
+  haveMask = true;
+
+  idfx::popRegion();
+}
+
+void DustMask::ShowConfig() {
+  idfx::cout << "Dust: species evolved in active tiles of " << tileSize[IDIR];
+  for(int dir = 1 ; dir < DIMENSIONS ; dir++) idfx::cout << "x" << tileSize[dir];
+  idfx::cout << " cells, where rho > " << densityThreshold;
+  if(haveFluxThreshold) idfx::cout << " or rho|v| > " << fluxThreshold;
+  idfx::cout << "." << std::endl;
+  idfx::cout << "Dust: masks updated every " << period << " cycles with a halo of "
+             << halo << " tile(s)." << std::endl;
+}
+
+void DustMask::Update(const int64_t ncycles) {
+  if(ncycles % period != 0) return;
+  idfx::pushRegion("DustMask::Update");
+
+  IdefixArray4D<int> active = this->active;
+  IdefixArray4D<int> seed = this->seed;
+
+  const int tk = tileSize[KDIR];
+  const int tj = tileSize[JDIR];
+  const int ti = tileSize[IDIR];
+  const int nk = data->np_tot[KDIR];
+  const int nj = data->np_tot[JDIR];
+  const int ni = data->np_tot[IDIR];
+  const real densityThreshold = this->densityThreshold;
+  const real fluxThreshold = this->fluxThreshold;
+  const bool haveFluxThreshold = this->haveFluxThreshold;
+
+  // 1-- Seed the tiles holding dust above the thresholds (ghost cells included, so that the
+  // dust coming from the neighbouring subdomains is seen)
+  for(int s = 0 ; s < nSpecies ; s++) {
+    IdefixArray4D<real> Vc = data->dust[s]->Vc;
+    idefix_for("DustMask_Seed",
+               0, nTiles[KDIR],
+               0, nTiles[JDIR],
+               0, nTiles[IDIR],
+      KOKKOS_LAMBDA (int kt, int jt, int it) {
+        const int kend = ((kt+1)*tk < nk) ? (kt+1)*tk : nk;
+        const int jend = ((jt+1)*tj < nj) ? (jt+1)*tj : nj;
+        const int iend = ((it+1)*ti < ni) ? (it+1)*ti : ni;
+        int flag = 0;
+        for(int k = kt*tk ; k < kend ; k++) {
+          for(int j = jt*tj ; j < jend ; j++) {
+            for(int i = it*ti ; i < iend ; i++) {
+              const real rho = Vc(RHO,k,j,i);
+              if(rho > densityThreshold) flag = 1;
+              if(haveFluxThreshold) {
+                const real v2 = EXPAND( Vc(VX1,k,j,i)*Vc(VX1,k,j,i) ,
+                                       +Vc(VX2,k,j,i)*Vc(VX2,k,j,i) ,
+                                       +Vc(VX3,k,j,i)*Vc(VX3,k,j,i) );
+                if(rho*std::sqrt(v2) > fluxThreshold) flag = 1;
+              }
+            }
+          }
+        }
+        seed(s,kt,jt,it) = flag;
+      });
+  }
+
+  // 2-- Add the safety halo around the seeded tiles
+  const int hk = (KDIR < DIMENSIONS) ? halo : 0;
+  const int hj = (JDIR < DIMENSIONS) ? halo : 0;
+  const int hi = halo;
+  const int nkt = nTiles[KDIR];
+  const int njt = nTiles[JDIR];
+  const int nit = nTiles[IDIR];
+
+  idefix_for("DustMask_Dilate",
+             0, nSpecies,
+             0, nkt,
+             0, njt,
+             0, nit,
+    KOKKOS_LAMBDA (int s, int kt, int jt, int it) {
+      int flag = 0;
+      for(int k = ((kt-hk > 0) ? kt-hk : 0) ; k <= ((kt+hk < nkt) ? kt+hk : nkt-1) ; k++) {
+        for(int j = ((jt-hj > 0) ? jt-hj : 0) ; j <= ((jt+hj < njt) ? jt+hj : njt-1) ; j++) {
+          for(int i = ((it-hi > 0) ? it-hi : 0) ; i <= ((it+hi < nit) ? it+hi : nit-1) ; i++) {
+            flag |= seed(s,k,j,i);
+          }
+        }
+      }
+      active(s,kt,jt,it) = flag;
+    });
+
+  idfx::popRegion();
+}
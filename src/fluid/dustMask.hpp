@@ -0,0 +1,68 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_DUSTMASK_HPP_
+#define FLUID_DUSTMASK_HPP_
+
+#include "idefix.hpp"
+#include "input.hpp"
+
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Active regions of the dust species. The local domain (ghost zones included) is split into
+/// tiles of tileSize cells in each direction. A tile is seeded for a species when the density
+/// (or the mass flux) of this species exceeds a threshold in one of its cells, and it is active
+/// when a seeded tile lies less than halo tiles away. The fluxes, flux divergence, source terms
+/// and drag of each species are only computed in its active tiles: the dust left in the inactive
+/// tiles is frozen and does not constrain the time step. The masks are updated every period
+/// cycles, so that halo*tileSize should exceed the number of cells crossed by the dust meanwhile.
+/// A default-constructed mask has all of the cells active.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class DustMask {
+ public:
+  DustMask() = default;
+  DustMask(Input &, DataBlock *, int);
+  void Update(const int64_t);           // Update the masks when the cycle # is a multiple of period
+  void ShowConfig();
+
+  // Whether cell (k,j,i) is evolved for species s
+  KOKKOS_INLINE_FUNCTION bool IsActive(const int s, const int k, const int j, const int i) const {
+    if(!haveMask) return(true);
+    return(active(s, k/tileSize[KDIR], j/tileSize[JDIR], i/tileSize[IDIR]) > 0);
+  }
+
+  // Whether face (k,j,i) (on the left of cell (k,j,i)) bounds a cell evolved for species s
+  template<int dir>
+  KOKKOS_INLINE_FUNCTION bool IsFaceActive(const int s,
+                                           const int k, const int j, const int i) const {
+    constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+    constexpr int joffset = (dir==JDIR) ? 1 : 0;
+    constexpr int koffset = (dir==KDIR) ? 1 : 0;
+    return(IsActive(s,k,j,i) || IsActive(s,k-koffset,j-joffset,i-ioffset));
+  }
+
+  bool haveMask{false};
+
+  IdefixArray4D<int> active;        // Active tiles of each species
+  IdefixArray4D<int> seed;          // Tiles holding dust above the thresholds
+
+  int nSpecies{0};
+  int tileSize[3]{1, 1, 1};         // # of cells of a tile in each direction
+  int nTiles[3]{1, 1, 1};           // # of tiles in each direction
+  int halo{1};                      // # of tiles added around the seeded tiles
+  int period{10};                   // # of cycles between two updates of the masks
+
+  real densityThreshold{ZERO_F};
+  real fluxThreshold{ZERO_F};
+  bool haveFluxThreshold{false};
+
+ private:
+  DataBlock *data{nullptr};
+};
+
+#endif // FLUID_DUSTMASK_HPP_
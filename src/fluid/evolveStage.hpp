@@ -43,7 +43,7 @@ void Fluid<Phys>::EvolveStage(const real t, const real dt) {
   // Compute current when needed
   if(needExplicitCurrent) CalcCurrent();
 
-  if(hallStatus.status == UserDefFunction) {
+  if(hallStatus.status == UserDefFunction && hallStatus.isExplicit) {
     if(hallDiffusivityFunc)
       hallDiffusivityFunc(*data, t, xHall);
     else
@@ -54,8 +54,8 @@ void Fluid<Phys>::EvolveStage(const real t, const real dt) {
     eos->Refresh(*data, t);
   }
 
-  // Loop on all of the directions
-  LoopDir<IDIR>(t,dt);
+  // Loop on all of the directions (done once for all of the species of a dust batch)
+  if(!isBatched) LoopDir<IDIR>(t,dt);
 
   // Step 4: add source terms to the conserved variables (curvature, rotation, etc)
   if(haveSourceTerms) AddSourceTerms(t, dt);
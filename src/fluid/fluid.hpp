@@ -13,8 +13,11 @@
 #include <memory>
 
 #include "idefix.hpp"
+#include "numa.hpp"
 #include "grid.hpp"
 #include "fluid_defs.hpp"
+#include "stateContainer.hpp"
+#include "dustMask.hpp"
 #include "eos.hpp"
 #include "thermalDiffusion.hpp"
 #include "bragThermalDiffusion.hpp"
@@ -36,6 +39,9 @@ class ConstrainedTransport;
 template<typename Phys>
 class RKLegendre;
 
+template<typename Phys>
+class HallSubcycle;
+
 template<typename Phys>
 class RiemannSolver;
 
@@ -55,7 +61,9 @@ class Fluid {
  public:
   Fluid( Grid &, Input&, DataBlock *, int n = 0);
   void ConvertConsToPrim();
+  void ConvertConsToPrim(const real, const real, StateContainer &); // fused stage combination
   void ConvertPrimToCons();
+  void ConvertPrimToCons(StateContainer &);   // and store the result
   template <int> void CalcParabolicFlux(const real);
   template <int> void AddNonIdealMHDFlux(const real);
   template <int> void CalcRightHandSide(real, real );
@@ -82,9 +90,13 @@ class Fluid {
   // Parabolic terms
   bool haveExplicitParabolicTerms{false};
   bool haveRKLParabolicTerms{false};
+  bool haveImplicitParabolicTerms{false};
 
   std::unique_ptr<RKLegendre<Phys>> rkl;
 
+  // Sub-cycled Hall effect
+  std::unique_ptr<HallSubcycle<Phys>> hallSubcycle;
+
   // Current
   bool haveCurrent{false};
   bool needExplicitCurrent{false};
@@ -139,6 +151,12 @@ class Fluid {
   bool haveTracer{false};
   int nTracer{0};
 
+  // Dust species stored in the datablock DustBatch, which computes the hyperbolic fluxes
+  bool isBatched{false};
+
+  // Active regions of the dust species (all of the cells are active otherwise)
+  DustMask activeMask;
+
 
   // Enroll user-defined boundary conditions (proxies for boundary class functions)
   template <typename T>
@@ -197,6 +215,7 @@ class Fluid {
   friend class ConstrainedTransport<Phys>;
   friend class Fargo;
   friend class RKLegendre<Phys>;
+  friend class HallSubcycle<Phys>;
   friend class Boundary<Phys>;
   friend class ShockFlattening<Phys>;
   friend class RiemannSolver<Phys>;
@@ -244,6 +263,15 @@ class Fluid {
   // Loop on dimensions
   template <int dir>
   void LoopDir(const real, const real);
+
+  // Index of our arrays (Uc and Vs or Ve) in the datablock states
+  int ucState{-1};
+  int magState{-1};
+
+  // Conversion to primitive variables, optionally combining Uc with Uc0 first
+  void ConsToPrimImpl(const bool, const real, const real, IdefixArray4D<real>);
+  // Conversion to conservative variables, optionally storing them in Uc0
+  void PrimToConsImpl(const bool, IdefixArray4D<real>);
 };
 
 #include "physics.hpp"
@@ -252,6 +280,7 @@ class Fluid {
 #include "constrainedTransport.hpp"
 #include "axis.hpp"
 #include "rkl.hpp"
+#include "hallSubcycle.hpp"
 #include "riemannSolver.hpp"
 #include "viscosity.hpp"
 #include "bragViscosity.hpp"
@@ -377,6 +406,9 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     } else if(opType.compare("rkl") == 0 ) {
       haveRKLParabolicTerms = true;
       thermalDiffusionStatus.isRKL = true;
+    } else if(opType.compare("implicit") == 0 ) {
+      haveImplicitParabolicTerms = true;
+      thermalDiffusionStatus.isImplicit = true;
     } else {
       std::stringstream msg;
       msg  << "Unknown integration type for thermal diffusion: " << opType;
@@ -501,6 +533,8 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
         if(opType.compare("explicit") == 0 ) {
           hallStatus.isExplicit = true;
           needExplicitCurrent = true;
+        } else if(opType.compare("subcycle") == 0 ) {
+          hallStatus.isSubcycled = true;
         } else if(opType.compare("rkl") == 0 ) {
           IDEFIX_ERROR("RKL inegration is incompatible with Hall");
         } else {
@@ -526,43 +560,72 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   /////////////////////////////////////////
 
   // We now allocate the fields required by the hydro solver
-  Vc = IdefixArray4D<real>(prefix+"_Vc", Phys::nvar+nTracer,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc = IdefixArray4D<real>(prefix+"_Uc", Phys::nvar+nTracer,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-
-  data->states["current"].PushArray(Uc, State::center, prefix+"_Uc");
-
-  InvDt = IdefixArray3D<real>(prefix+"_InvDt",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  cMax = IdefixArray3D<real>(prefix+"_cMax",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  dMax = IdefixArray3D<real>(prefix+"_dMax",
+  if constexpr(Phys::dust) {
+    isBatched = (data->dustBatch != nullptr);
+    if(data->dustMask) {
+      // Tracers and parabolic fluxes are not computed from the masked Riemann fluxes
+      if(haveTracer || haveExplicitParabolicTerms || haveRKLParabolicTerms
+                    || haveImplicitParabolicTerms) {
+        IDEFIX_ERROR("Dust masks are not compatible with tracers or parabolic terms");
+      }
+      activeMask = *data->dustMask;
+    }
+  }
+  if(isBatched) {
+    if(haveTracer || haveExplicitParabolicTerms || haveRKLParabolicTerms
+                  || haveImplicitParabolicTerms) {
+      IDEFIX_ERROR("Batched dust species are not compatible with tracers or parabolic terms");
+    }
+    // Our fields are views of our own species in the arrays of the batch
+    // (the batch registers its Uc in the datablock states)
+    auto range = std::make_pair(n*Phys::nvar, (n+1)*Phys::nvar);
+    Vc = Kokkos::subview(data->dustBatch->Vc, range, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+    Uc = Kokkos::subview(data->dustBatch->Uc, range, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+    FluxRiemann = Kokkos::subview(data->dustBatch->FluxRiemann, range,
+                                  Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+    InvDt = Kokkos::subview(data->dustBatch->InvDt, n, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+    cMax = Kokkos::subview(data->dustBatch->cMax, n, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+  } else {
+    // Large arrays are first touched by the threads which compute them (see numa.hpp)
+    Vc = idfx::FirstTouchArray4D<real>(prefix+"_Vc", idfx::ArrayLayout4D(Phys::nvar+nTracer,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+    Uc = idfx::FirstTouchArray4D<real>(prefix+"_Uc", idfx::ArrayLayout4D(Phys::nvar+nTracer,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+
+    ucState = data->states["current"].PushArray(Uc, State::center, prefix+"_Uc");
+
+    InvDt = idfx::FirstTouchArray3D<real>(prefix+"_InvDt",
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    cMax = idfx::FirstTouchArray3D<real>(prefix+"_cMax",
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    FluxRiemann =  idfx::FirstTouchArray4D<real>(prefix+"_FluxRiemann",
+                                      idfx::ArrayLayout4D(Phys::nvar+nTracer, data->np_tot[KDIR],
+                                                          data->np_tot[JDIR], data->np_tot[IDIR]));
+  }
+  dMax = idfx::FirstTouchArray3D<real>(prefix+"_dMax",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  FluxRiemann =  IdefixArray4D<real>(prefix+"_FluxRiemann", Phys::nvar+nTracer,
-                                     data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
 
   if constexpr(Phys::mhd) {
-    Vs = IdefixArray4D<real>(prefix+"_Vs", DIMENSIONS,
-              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET);
+    Vs = idfx::FirstTouchArray4D<real>(prefix+"_Vs", idfx::ArrayLayout4D(DIMENSIONS,
+              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET));
     #ifdef EVOLVE_VECTOR_POTENTIAL
       #if DIMENSIONS == 1
         IDEFIX_ERROR("EVOLVE_VECTOR_POTENTIAL is not compatible with 1D MHD");
       #else
-        Ve = IdefixArray4D<real>(prefix+"_Ve", AX3e+1,
-              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET);
+        Ve = idfx::FirstTouchArray4D<real>(prefix+"_Ve", idfx::ArrayLayout4D(AX3e+1,
+              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET));
 
-        data->states["current"].PushArray(Ve, State::center, prefix+"_Ve");
+        magState = data->states["current"].PushArray(Ve, State::center, prefix+"_Ve");
       #endif
     #else // EVOLVE_VECTOR_POTENTIAL
-      data->states["current"].PushArray(Vs, State::center, prefix+"_Vs");
+      magState = data->states["current"].PushArray(Vs, State::center, prefix+"_Vs");
     #endif // EVOLVE_VECTOR_POTENTIAL
   }
 
   if(this->haveCurrent) {
     // Allocate current (when hydro needs it)
-    J = IdefixArray4D<real>(prefix+"_J", 3,
-                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    J = idfx::FirstTouchArray4D<real>(prefix+"_J", idfx::ArrayLayout4D(3,
+                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
   }
 
   // Allocate nonideal MHD effects array when a user-defined function is used
@@ -720,6 +783,10 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     this->rkl = std::make_unique<RKLegendre<Phys>>(input,this);
   }
 
+  if(hallStatus.isSubcycled) {
+    this->hallSubcycle = std::make_unique<HallSubcycle<Phys>>(input,this);
+  }
+
   // Thermal diffusion
   if(thermalDiffusionStatus.status != Disabled ) {
     this->thermalDiffusion = std::make_unique<ThermalDiffusion>(input, grid, this);
@@ -33,6 +33,8 @@ struct ParabolicModuleStatus {
   HydroModuleStatus status{Disabled};
   bool isExplicit{false};
   bool isRKL{false};
+  bool isImplicit{false};
+  bool isSubcycled{false};
 };
 
 
@@ -0,0 +1,286 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_HALLSUBCYCLE_HPP_
+#define FLUID_HALLSUBCYCLE_HPP_
+
+#include <string>
+#include <vector>
+
+#include "idefix.hpp"
+#include "numa.hpp"
+#include "input.hpp"
+#include "dataBlock.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Operator-split integration of the Hall effect. The Hall EMF xH J x B and the induction
+/// equation are sub-cycled with a third-order SSP Runge-Kutta scheme over the hydro time step,
+/// so that the Riemann solver and the hydro time step are those of ideal MHD. Since the Hall
+/// EMF does not dissipate energy (J.E_H=0), the gas pressure is kept constant during the cycle.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Phys>
+class HallSubcycle {
+ public:
+  HallSubcycle(Input &, Fluid<Phys>*);
+  void Cycle();
+  void ComputeDt();
+  void ShowConfig();
+
+  IdefixArray4D<real> Vs0;     // Vs at the beginning of the sub-step
+
+  real dt;                     // Sub-step
+  real cfl;                    // Courant number of the sub-steps
+  real rmax;                   // maximum ratio hyperbolic/Hall timestep
+  int nsubcycles{0};           // # of sub-steps of the last cycle
+
+ private:
+  void EvolveStage(real, real);
+  void SetBoundaries(real);    // Enforce boundary conditions on the magnetic field
+
+  DataBlock *data;
+  Fluid<Phys> *hydro;
+
+#ifdef WITH_MPI
+  Mpi mpi;                     // Hall-specific MPI layer, exchanging only Vs
+#endif
+};
+
+#include "fluid.hpp"
+
+template<typename Phys>
+HallSubcycle<Phys>::HallSubcycle(Input &input, Fluid<Phys>* hydroin) {
+  idfx::pushRegion("HallSubcycle::HallSubcycle");
+
+  // Save the datablock to which we are attached from now on
+  this->data = hydroin->data;
+  this->hydro = hydroin;
+
+  #if DIMENSIONS < 2 || COMPONENTS != DIMENSIONS
+    IDEFIX_ERROR("Hall sub-cycling requires all of the field components to be face-centered "
+                 "(DIMENSIONS >= 2 and COMPONENTS == DIMENSIONS)");
+  #endif
+  #ifdef EVOLVE_VECTOR_POTENTIAL
+    IDEFIX_ERROR("Hall sub-cycling is not compatible with EVOLVE_VECTOR_POTENTIAL");
+  #endif
+
+  cfl = input.GetOrSet<real>("Hall","cfl",0, 0.3);
+  rmax = input.GetOrSet<real>("Hall","rmax",0, 100.0);
+
+  #ifdef WITH_MPI
+    std::vector<int> varListHost;
+    mpi.Init(data->mygrid, varListHost, data->nghost.data(), data->np_int.data(), true);
+  #endif
+
+  Vs0 = idfx::FirstTouchArray4D<real>("Hall_Vs0", idfx::ArrayLayout4D(DIMENSIONS,
+                            data->np_tot[KDIR]+KOFFSET,
+                            data->np_tot[JDIR]+JOFFSET,
+                            data->np_tot[IDIR]+IOFFSET));
+
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void HallSubcycle<Phys>::ShowConfig() {
+  idfx::cout << Phys::prefix << ": Hall effect is sub-cycled with a 3rd order SSP "
+             << "Runge-Kutta scheme." << std::endl;
+  idfx::cout << Phys::prefix << ": Hall sub-cycle cfl set to " << cfl << "." << std::endl;
+  idfx::cout << Phys::prefix << ": maximum ratio hyperbolic/Hall timestep "
+             << rmax << "." << std::endl;
+}
+
+template<typename Phys>
+void HallSubcycle<Phys>::Cycle() {
+  idfx::pushRegion("HallSubcycle::Cycle");
+
+  IdefixArray4D<real> Vs = hydro->Vs;
+  IdefixArray4D<real> Vs0 = this->Vs0;
+
+  real time = data->t;
+  const real dt_hyp = data->dt;
+
+  // Tell the datablock that we're performing the Hall cycle
+  data->hallCycle = true;
+
+  if(hydro->hallStatus.status == UserDefFunction) {
+    if(hydro->hallDiffusivityFunc)
+      hydro->hallDiffusivityFunc(*data, time, hydro->xHall);
+    else
+      IDEFIX_ERROR("No user-defined Hall diffusivity function has been enrolled");
+  }
+
+  SetBoundaries(time);
+
+  // The whistler time step is only computed once per cycle
+  ComputeDt();
+  nsubcycles = static_cast<int>(std::ceil(dt_hyp/dt));
+  const real dt_sub = dt_hyp/nsubcycles;
+
+  for(int n = 0 ; n < nsubcycles ; n++) {
+    Kokkos::deep_copy(Vs0, Vs);
+
+    // Shu-Osher form of SSP-RK3: Vs = a*Vs0 + (1-a)*(Vs + dt_sub*L(Vs))
+    EvolveStage(time, dt_sub);
+    SetBoundaries(time + dt_sub);
+
+    EvolveStage(time + dt_sub, dt_sub);
+    idefix_for("Hall_Stage2",
+              0, DIMENSIONS,
+              data->beg[KDIR],data->end[KDIR]+KOFFSET,
+              data->beg[JDIR],data->end[JDIR]+JOFFSET,
+              data->beg[IDIR],data->end[IDIR]+IOFFSET,
+      KOKKOS_LAMBDA (int nv, int k, int j, int i) {
+        Vs(nv,k,j,i) = 0.75*Vs0(nv,k,j,i) + 0.25*Vs(nv,k,j,i);
+      });
+    SetBoundaries(time + 0.5*dt_sub);
+
+    EvolveStage(time + 0.5*dt_sub, dt_sub);
+    idefix_for("Hall_Stage3",
+              0, DIMENSIONS,
+              data->beg[KDIR],data->end[KDIR]+KOFFSET,
+              data->beg[JDIR],data->end[JDIR]+JOFFSET,
+              data->beg[IDIR],data->end[IDIR]+IOFFSET,
+      KOKKOS_LAMBDA (int nv, int k, int j, int i) {
+        Vs(nv,k,j,i) = (Vs0(nv,k,j,i) + 2.0*Vs(nv,k,j,i))/3.0;
+      });
+
+    time += dt_sub;
+    SetBoundaries(time);
+  }
+
+  // Tell the datablock that we're done
+  data->hallCycle = false;
+  idfx::popRegion();
+}
+
+// Advance Vs by dt with the Hall EMF computed from the current state
+template<typename Phys>
+void HallSubcycle<Phys>::EvolveStage(real t, real dt) {
+  idfx::pushRegion("HallSubcycle::EvolveStage");
+
+  IdefixArray3D<real> ex = hydro->emf->ex;
+  IdefixArray3D<real> ey = hydro->emf->ey;
+  IdefixArray3D<real> ez = hydro->emf->ez;
+
+  hydro->CalcCurrent();
+
+  idefix_for("Hall_ResetEMF",
+             0,data->np_tot[KDIR],
+             0,data->np_tot[JDIR],
+             0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      D_EXPAND( ez(k,j,i) = 0.0;    ,
+                                    ,
+                ex(k,j,i) = 0.0;
+                ey(k,j,i) = 0.0;    )
+    });
+
+  hydro->emf->CalcNonidealEMF(t);
+  hydro->emf->EnforceEMFBoundary();
+  hydro->emf->EvolveMagField(t, dt, hydro->Vs);
+
+  idfx::popRegion();
+}
+
+// Whistler time step: dt = cfl/(|xH| |B| sum_dir 1/dl^2)
+template<typename Phys>
+void HallSubcycle<Phys>::ComputeDt() {
+  idfx::pushRegion("HallSubcycle::ComputeDt");
+
+  IdefixArray4D<real> Vc = hydro->Vc;
+  IdefixArray3D<real> xHallArr = hydro->xHall;
+  IdefixArray1D<real> dx1 = data->dx[IDIR];
+  IdefixArray1D<real> dx2 = data->dx[JDIR];
+  IdefixArray1D<real> dx3 = data->dx[KDIR];
+  [[maybe_unused]] IdefixArray1D<real> x1 = data->x[IDIR];
+  [[maybe_unused]] IdefixArray1D<real> rt = data->rt;
+  [[maybe_unused]] IdefixArray1D<real> dmu = data->dmu;
+
+  HydroModuleStatus hall = hydro->hallStatus.status;
+  const real xHConstant = hydro->xH;
+
+  real newinvdt = ZERO_F;
+  idefix_reduce("Hall_Timestep_reduction",
+    data->beg[KDIR], data->end[KDIR],
+    data->beg[JDIR], data->end[JDIR],
+    data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i, real &invdt) {
+      real xH = (hall == UserDefFunction) ? xHallArr(k,j,i) : xHConstant;
+      real B2 = EXPAND( Vc(BX1,k,j,i)*Vc(BX1,k,j,i) ,
+                       +Vc(BX2,k,j,i)*Vc(BX2,k,j,i) ,
+                       +Vc(BX3,k,j,i)*Vc(BX3,k,j,i) );
+
+      [[maybe_unused]] real dl1 = dx1(i);
+      [[maybe_unused]] real dl2 = dx2(j);
+      [[maybe_unused]] real dl3 = dx3(k);
+      #if GEOMETRY == POLAR
+        dl2 = dl2*x1(i);
+      #elif GEOMETRY == SPHERICAL
+        dl2 = dl2*rt(i);
+        dl3 = dl3*rt(i)*dmu(j)/dx2(j);
+      #endif
+
+      real idl2 = D_EXPAND( ONE_F/(dl1*dl1) ,
+                           +ONE_F/(dl2*dl2) ,
+                           +ONE_F/(dl3*dl3) );
+
+      invdt = std::fmax(invdt, FABS(xH)*std::sqrt(B2)*idl2);
+    },
+    Kokkos::Max<real>(newinvdt)
+  );
+
+#ifdef WITH_MPI
+  if(idfx::psize>1) {
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &newinvdt, 1, realMPI, MPI_MAX, MPI_COMM_WORLD));
+  }
+#endif
+
+  // A vanishing field (or Hall coefficient) does not constrain the time step
+  dt = (newinvdt > ZERO_F) ? cfl/newinvdt : data->dt;
+
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void HallSubcycle<Phys>::SetBoundaries(real t) {
+  idfx::pushRegion("HallSubcycle::SetBoundaries");
+  if(data->haveGridCoarsening) {
+    hydro->CoarsenMagField(hydro->Vs);
+  }
+
+  for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
+    // MPI Exchange data when needed
+    // We use the Hall instance MPI object to only exchange the face-centered field
+    #ifdef WITH_MPI
+    if(data->mygrid->nproc[dir]>1) {
+      switch(dir) {
+        case 0:
+          this->mpi.ExchangeX1(hydro->Vc, hydro->Vs);
+          break;
+        case 1:
+          this->mpi.ExchangeX2(hydro->Vc, hydro->Vs);
+          break;
+        case 2:
+          this->mpi.ExchangeX3(hydro->Vc, hydro->Vs);
+          break;
+      }
+    }
+    #endif
+    hydro->boundary->EnforceBoundaryDir(t, dir);
+    // Reconstruct the normal field component when using CT
+    hydro->boundary->ReconstructNormalField(dir);
+  } // Loop on dimension ends
+
+  // Remake the cell-centered field.
+  hydro->boundary->ReconstructVcField(hydro->Vc);
+
+  idfx::popRegion();
+}
+
+#endif // FLUID_HALLSUBCYCLE_HPP_
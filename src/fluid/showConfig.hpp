@@ -118,6 +118,8 @@ void Fluid<Phys>::ShowConfig() {
     }
     if(hallStatus.isExplicit) {
       idfx::cout << Phys::prefix << ": Hall effect uses an explicit time integration." << std::endl;
+    } else if(hallStatus.isSubcycled) {
+      hallSubcycle->ShowConfig();
     }  else {
       IDEFIX_ERROR("Unknown time integrator for Hall effect");
     }
@@ -13,6 +13,8 @@
 #include "dataBlock.hpp"
 #include "fluid.hpp"
 #include "eos.hpp"
+#include "bicgstab.hpp"
+#include "cg.hpp"
 
 
 
@@ -34,6 +36,11 @@ void ThermalDiffusion::ShowConfig() {
   } else if(status.isRKL) {
     idfx::cout << "Thermal Diffusion: uses a Runge-Kutta-Legendre time integration."
                 << std::endl;
+  } else if(status.isImplicit) {
+    idfx::cout << "Thermal Diffusion: uses an implicit "
+               << (implicitOperator->theta < ONE_F ? "Crank-Nicolson" : "backward Euler")
+               << " time integration with the " << implicitSolverName << " solver." << std::endl;
+    implicitSolver->ShowConfig();
   } else {
     IDEFIX_ERROR("Unknown time integrator for viscosity.");
   }
@@ -147,3 +154,184 @@ void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t, const IdefixArray
       });
   idfx::popRegion();
 }
+
+void ThermalDiffusion::InitImplicit(Input &input) {
+  idfx::pushRegion("ThermalDiffusion::InitImplicit");
+  if(data->haveGridCoarsening) {
+    IDEFIX_ERROR("Implicit thermal diffusion is not compatible with grid coarsening");
+  }
+
+  std::string scheme = input.GetOrSet<std::string>("Implicit","scheme",0,"backwardEuler");
+  real theta;
+  if(scheme.compare("backwardEuler")==0) {
+    theta = ONE_F;
+  } else if(scheme.compare("crankNicolson")==0) {
+    theta = HALF_F;
+  } else {
+    std::stringstream msg;
+    msg << "Unknown implicit scheme \"" << scheme << "\". "
+        << "Use \"backwardEuler\" or \"crankNicolson\".";
+    IDEFIX_ERROR(msg);
+  }
+
+  implicitSolverName = input.GetOrSet<std::string>("Implicit","solver",0,"PBICGSTAB");
+  const real targetError = input.GetOrSet<real>("Implicit","targetError",0,1e-6);
+  const int maxIter = input.GetOrSet<int>("Implicit","maxIter",0,1000);
+  const bool havePreconditioner = (implicitSolverName.compare("PCG")==0
+                                   || implicitSolverName.compare("PBICGSTAB")==0);
+
+  implicitOperator = std::make_unique<DiffusionOperator>(data, theta, havePreconditioner);
+  if(implicitSolverName.compare("CG")==0 || implicitSolverName.compare("PCG")==0) {
+    implicitSolver = new Cg<DiffusionOperator>(*implicitOperator.get(), targetError, maxIter,
+                                               data->np_tot, data->beg, data->end);
+  } else if(implicitSolverName.compare("BICGSTAB")==0
+            || implicitSolverName.compare("PBICGSTAB")==0) {
+    implicitSolver = new Bicgstab<DiffusionOperator>(*implicitOperator.get(), targetError,
+                                                     maxIter, data->np_tot, data->beg, data->end);
+  } else {
+    std::stringstream msg;
+    msg << "Unknown implicit solver \"" << implicitSolverName << "\". "
+        << "Use CG, PCG, BICGSTAB or PBICGSTAB.";
+    IDEFIX_ERROR(msg);
+  }
+
+  temperature = IdefixArray3D<real>("ThermalDiffusion_T", data->np_tot[KDIR],
+                                                          data->np_tot[JDIR],
+                                                          data->np_tot[IDIR]);
+  dTemperature = IdefixArray3D<real>("ThermalDiffusion_dT", data->np_tot[KDIR],
+                                                            data->np_tot[JDIR],
+                                                            data->np_tot[IDIR]);
+  implicitRHS = IdefixArray3D<real>("ThermalDiffusion_RHS", data->np_tot[KDIR],
+                                                            data->np_tot[JDIR],
+                                                            data->np_tot[IDIR]);
+  idfx::popRegion();
+}
+
+// Advance the thermal diffusion equation rho/(gamma-1) dT/dt = div(kappa grad T) over dt
+// with a theta-scheme. The diffusivity and the heat capacity are frozen at the beginning
+// of the step, so that the problem is linear in the temperature increment.
+void ThermalDiffusion::ImplicitStep(const real t, const real dt) {
+  idfx::pushRegion("ThermalDiffusion::ImplicitStep");
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray3D<real> kappaArr = this->kappaArr;
+  IdefixArray3D<real> T = this->temperature;
+  IdefixArray3D<real> dT = this->dTemperature;
+  IdefixArray3D<real> rhs = this->implicitRHS;
+  IdefixArray3D<real> C = implicitOperator->capacity;
+  IdefixArray3D<real> dV = data->dV;
+  EquationOfState eos = *(this->eos);
+  HydroModuleStatus haveThermalDiffusion = this->status.status;
+  real kappaConstant = this->kappa;
+
+  // Apply Boundary conditions on the full set of variables
+  data->hydro->boundary->SetBoundaries(t);
+
+  if(haveThermalDiffusion == UserDefFunction) {
+    if(diffusivityFunc) {
+      idfx::pushRegion("UserDef::ThermalDiffusivityFunction");
+      diffusivityFunc(*this->data, t, kappaArr);
+      idfx::popRegion();
+    } else {
+      IDEFIX_ERROR("No user-defined thermal diffusion function has been enrolled");
+    }
+  }
+
+  idefix_for("ImplicitTDiffusionInit", 0, data->np_tot[KDIR],
+                                       0, data->np_tot[JDIR],
+                                       0, data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      T(k,j,i) = Vc(PRS,k,j,i) / Vc(RHO,k,j,i);
+      dT(k,j,i) = ZERO_F;
+      const real gamma = eos.GetGamma(Vc(PRS,k,j,i),Vc(RHO,k,j,i));
+      C(k,j,i) = Vc(RHO,k,j,i) / (gamma - ONE_F) * dV(k,j,i);
+    });
+
+  // Face couplings, following the discretisation of AddDiffusiveFlux
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    IdefixArray3D<real> K = implicitOperator->coupling[dir];
+    IdefixArray3D<real> A = data->A[dir];
+    IdefixArray1D<real> dx = this->data->dx[dir];
+    #if GEOMETRY == POLAR
+      IdefixArray1D<real> x1 = this->data->x[IDIR];
+    #endif
+    #if GEOMETRY == SPHERICAL
+      IdefixArray1D<real> rt   = this->data->rt;
+      IdefixArray1D<real> dmu  = this->data->dmu;
+      IdefixArray1D<real> dx2 = this->data->dx[JDIR];
+    #endif
+    const int ioffset = (dir==IDIR) ? 1 : 0;
+    const int joffset = (dir==JDIR) ? 1 : 0;
+    const int koffset = (dir==KDIR) ? 1 : 0;
+
+    idefix_for("ImplicitTDiffusionCoupling",
+               data->beg[KDIR], data->end[KDIR]+koffset,
+               data->beg[JDIR], data->end[JDIR]+joffset,
+               data->beg[IDIR], data->end[IDIR]+ioffset,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        // index along dir
+        const int ig = ioffset*i + joffset*j + koffset*k;
+
+        // dx at the interface is the averaged between the two adjacent centered dx
+        real dl = HALF_F*(dx(ig-1) + dx(ig));
+        #if GEOMETRY == POLAR
+          if(dir==JDIR) dl = dl*x1(i);
+        #elif GEOMETRY == SPHERICAL
+          if(dir==JDIR) dl = dl*rt(i);
+          if(dir==KDIR) dl = dl*rt(i)*dmu(j)/dx2(j);
+        #endif // GEOMETRY
+
+        real kappa;
+        if(haveThermalDiffusion == UserDefFunction) {
+          kappa = HALF_F*(kappaArr(k,j,i) +  kappaArr(k-koffset,j-joffset,i-ioffset));
+        } else {
+          kappa = kappaConstant;
+        }
+        K(k,j,i) = dt*kappa*A(k,j,i)/dl;
+      });
+  }
+
+  if(implicitOperator->havePreconditioner) implicitOperator->ComputePreconditioner();
+
+  // Explicit fluxes of the current temperature field
+  implicitOperator->ComputeRHS(T, rhs);
+
+  // Nothing to do if the temperature is already uniform
+  real rhsMax = 0;
+  idefix_reduce("ImplicitTDiffusionRHS",
+                data->beg[KDIR], data->end[KDIR],
+                data->beg[JDIR], data->end[JDIR],
+                data->beg[IDIR], data->end[IDIR],
+                KOKKOS_LAMBDA (int k, int j, int i, real &localMax) {
+                  localMax = FMAX(FABS(rhs(k,j,i)), localMax);
+                },
+                Kokkos::Max<real>(rhsMax));
+  #ifdef WITH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &rhsMax, 1, realMPI, MPI_MAX, MPI_COMM_WORLD);
+  #endif
+  if(rhsMax == ZERO_F) {
+    implicitIterations = 0;
+    idfx::popRegion();
+    return;
+  }
+
+  implicitIterations = implicitSolver->Solve(dT, rhs);
+  if(implicitIterations < 0) {
+    // Try again from a null guess
+    Kokkos::deep_copy(dT, ZERO_F);
+    implicitIterations = implicitSolver->Solve(dT, rhs);
+    if(implicitIterations < 0) {
+      IDEFIX_ERROR("ThermalDiffusion:: implicit solver failed despite restart");
+    }
+  }
+
+  // Update the pressure (density is unchanged)
+  idefix_for("ImplicitTDiffusionUpdate",
+             data->beg[KDIR], data->end[KDIR],
+             data->beg[JDIR], data->end[JDIR],
+             data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      Vc(PRS,k,j,i) += Vc(RHO,k,j,i)*dT(k,j,i);
+    });
+
+  idfx::popRegion();
+}
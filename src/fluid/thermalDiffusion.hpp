@@ -8,6 +8,7 @@
 #ifndef FLUID_THERMALDIFFUSION_HPP_
 #define FLUID_THERMALDIFFUSION_HPP_
 
+#include <memory>
 #include <string>
 
 #include "idefix.hpp"
@@ -15,6 +16,8 @@
 #include "grid.hpp"
 #include "fluid_defs.hpp"
 #include "eos.hpp"
+#include "diffusionOperator.hpp"
+#include "iterativesolver.hpp"
 
 
 // Forward class hydro declaration
@@ -31,6 +34,8 @@ class ThermalDiffusion {
 
   void AddDiffusiveFlux(int, const real, const IdefixArray4D<real> &);
 
+  void ImplicitStep(const real, const real);  // Implicit update of the pressure over dt
+
   // Enroll user-defined viscous diffusivity
   void EnrollThermalDiffusivity(DiffusivityFunc);
 
@@ -57,6 +62,16 @@ class ThermalDiffusion {
 
   // equation of state (required to get the heat capacity)
   EquationOfState *eos;
+
+  // Implicit integration
+  void InitImplicit(Input &);
+  std::unique_ptr<DiffusionOperator> implicitOperator;
+  IterativeSolver<DiffusionOperator> *implicitSolver{nullptr};
+  std::string implicitSolverName;
+  IdefixArray3D<real> temperature;    // temperature at the beginning of the step
+  IdefixArray3D<real> dTemperature;   // temperature increment
+  IdefixArray3D<real> implicitRHS;
+  int implicitIterations{0};          // number of iterations of the last implicit step
 };
 
 #include "fluid.hpp"
@@ -87,6 +102,10 @@ ThermalDiffusion::ThermalDiffusion(Input &input, Grid &grid, Fluid<Phys> *hydroi
     IDEFIX_ERROR("Thermal diffusion is not compatible with the ISOTHERMAL approximation");
   #endif
 
+  if(status.isImplicit) {
+    InitImplicit(input);
+  }
+
   idfx::popRegion();
 }
 
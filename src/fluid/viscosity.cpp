@@ -58,9 +58,8 @@ void Viscosity::InitArrays() {
         dmu(j) = 1.0/scrch;
       });
   #endif
-  viscSrc = IdefixArray4D<real>("Viscosity_source", COMPONENTS, data->np_tot[KDIR],
-                                                                data->np_tot[JDIR],
-                                                                data->np_tot[IDIR]);
+  viscSrc = IdefixArray4D<real>("Viscosity_source", idfx::ArrayLayout4D(COMPONENTS,
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
 }
 void Viscosity::ShowConfig() {
   if(status.status==Constant) {
@@ -30,6 +30,7 @@ IdefixOutStream cout;
 IdefixErrStream cerr;
 Profiler prof;
 LoopPattern defaultLoopPattern;
+LoopTuner loopTuner;
 Units units;
 
 #ifdef DEBUG
@@ -65,11 +66,20 @@ int initialize() {
 
 void pushRegion(const std::string& kName) {
   Kokkos::Profiling::pushRegion(kName);
-  if(prof.perfEnabled) {
-    Kokkos::fence();
-    prof.currentRegion = prof.currentRegion->GetChild(kName);
-    prof.currentRegion->Start();
+  if(prof.perfEnabled) prof.Push(prof.Intern(kName));
+#ifdef DEBUG
+  regionIndent=regionIndent+4;
+  for(int i=0; i < regionIndent ; i++) {
+    cout << "-";
   }
+  cout << "> " << kName << "..." << std::endl;
+#endif
+}
+
+// Same, without building a string unless a Kokkos tool is loaded
+void pushRegion(const char *kName) {
+  if(Kokkos::Tools::profileLibraryLoaded()) Kokkos::Profiling::pushRegion(kName);
+  if(prof.perfEnabled) prof.Push(prof.Intern(kName));
 #ifdef DEBUG
   regionIndent=regionIndent+4;
   for(int i=0; i < regionIndent ; i++) {
@@ -81,11 +91,7 @@ void pushRegion(const std::string& kName) {
 
 void popRegion() {
   Kokkos::Profiling::popRegion();
-  if(prof.perfEnabled) {
-    Kokkos::fence();
-    prof.currentRegion->Stop();
-    prof.currentRegion = prof.currentRegion->parent;
-  }
+  if(prof.perfEnabled) prof.Pop();
 #ifdef DEBUG
   for(int i=0; i < regionIndent ; i++) {
     cout << "-";
@@ -150,4 +156,19 @@ void safeExit(int retCode) {
   exit(retCode);
 }
 
+HaloPrecision ParseHaloPrecision(const std::string &name, const std::string &block) {
+  if(name.compare("full")==0) {
+    return(HaloPrecision::Full);
+  } else if(name.compare("float")==0) {
+    return(HaloPrecision::Float);
+  } else if(name.compare("scaledFloat")==0) {
+    return(HaloPrecision::ScaledFloat);
+  }
+  std::stringstream msg;
+  msg << block << ": Unknown halo precision \"" << name << "\". "
+      << "Use \"full\", \"float\" or \"scaledFloat\"." << std::endl;
+  IDEFIX_ERROR(msg);
+  return(HaloPrecision::Full);
+}
+
 } // namespace idfx
@@ -9,6 +9,7 @@
 #define GLOBAL_HPP_
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "arrays.hpp"
 #include "npy.hpp"
@@ -20,6 +21,7 @@ void safeExit(int );       // Exit the code
 class IdefixOutStream;
 class IdefixErrStream;
 class Profiler;
+class LoopTuner;
 class Units;
 
 extern int prank;                       //< parallel rank
@@ -29,10 +31,12 @@ extern IdefixErrStream cerr;              //< custom cerr for idefix
 extern Profiler prof;                   //< profiler (for memory & performance usage)
 extern double mpiCallsTimer;            //< time significant MPI calls
 extern LoopPattern defaultLoopPattern;  //< default loop patterns (for idefix_for loops)
+extern LoopTuner loopTuner;             //< runtime choice of the loop patterns
 extern bool warningsAreErrors;    //< whether warnings should be considered as errors
 extern Units units;               //< Units for the run
 
 void pushRegion(const std::string&);
+void pushRegion(const char *);
 void popRegion();
 
 template<typename T>
@@ -47,11 +51,55 @@ IdefixArray1D<T> ConvertVectorToIdefixArray(std::vector<T> &inputVector) {
   return(outArr);
 }
 
+///< deep copy between arrays which may have different layouts (with VARIABLES_INNERMOST,
+///< the 4D device arrays are strided while the host arrays are not)
+template<typename DstType, typename SrcType>
+void DeepCopy(const DstType &dst, const SrcType &src) {
+  using DstSpace = typename DstType::memory_space;
+  using SrcSpace = typename SrcType::memory_space;
+  if constexpr(std::is_same<typename DstType::array_layout,
+                            typename SrcType::array_layout>::value
+               || std::is_same<DstSpace, SrcSpace>::value) {
+    Kokkos::deep_copy(dst, src);
+  } else if constexpr(Kokkos::SpaceAccessibility<Kokkos::HostSpace, SrcSpace>::accessible) {
+    // Send the host array as it is, and change its layout in the destination space
+    Kokkos::View<typename SrcType::non_const_data_type, typename SrcType::array_layout, DstSpace>
+      buffer("DeepCopyBuffer", src.layout());
+    Kokkos::deep_copy(buffer, src);
+    Kokkos::deep_copy(dst, buffer);
+  } else {
+    // Change the layout in the source space, and send the result to the host
+    Kokkos::View<typename DstType::non_const_data_type, typename DstType::array_layout, SrcSpace>
+      buffer("DeepCopyBuffer", dst.layout());
+    Kokkos::deep_copy(buffer, src);
+    Kokkos::deep_copy(dst, buffer);
+  }
+}
+
+///< host array of the size of a 4D device array (its mirror view when both have the same layout),
+///< to be synchronised with DeepCopy
+template<typename T>
+IdefixHostArray4D<T> CreateHostArray(const IdefixArray4D<T> &array) {
+  if constexpr(std::is_same<typename IdefixArray4D<T>::array_layout,
+                            typename IdefixHostArray4D<T>::array_layout>::value) {
+    return(Kokkos::create_mirror_view(array));
+  } else {
+    return(IdefixHostArray4D<T>(array.label()+"_mirror", array.extent(0), array.extent(1),
+                                array.extent(2), array.extent(3)));
+  }
+}
+
 ///< dump Idefix array to a numpy array on disk
 template<typename ArrayType>
 void DumpArray(std::string filename, ArrayType array) {
-  auto hArray = Kokkos::create_mirror(array);
-  Kokkos::deep_copy(hArray, array);
+  // Row-major host copy, whatever the layout of the array
+  Kokkos::LayoutRight layout;
+  for (size_t i = 0; i < ArrayType::rank; ++i) {
+    layout.dimension[i] = array.extent(i);
+  }
+  Kokkos::View<typename ArrayType::non_const_data_type, Kokkos::LayoutRight, Kokkos::HostSpace>
+    hArray("DumpArray", layout);
+  DeepCopy(hArray, array);
 
   std::array<uint64_t, ArrayType::rank> shape;
   bool fortran_order{false};
@@ -95,9 +95,9 @@ Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> left
 
   // Init MPI stack when needed
   #ifdef WITH_MPI
-    this->arr4D = IdefixArray4D<real> ("WorkingArrayMpi", 1, this->np_tot[KDIR],
+    this->arr4D = IdefixArray4D<real> ("WorkingArrayMpi", idfx::ArrayLayout4D(1, this->np_tot[KDIR],
                                                             this->np_tot[JDIR],
-                                                            this->np_tot[IDIR]);
+                                                            this->np_tot[IDIR]));
 
     int ntarget = 0;
     std::vector<int> mapVars;
@@ -109,6 +109,12 @@ Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> left
   idfx::popRegion();
 }
 
+void Laplacian::SetHaloPrecision(HaloPrecision precision) {
+  #ifdef WITH_MPI
+    this->mpi.SetHaloPrecision(precision);
+  #endif
+}
+
 void Laplacian::InitInternalGrid() {
   idfx::pushRegion("Laplacian::InitInternalGrid");
   // Extend the grid so that the inner radius will be 1/10 of the initial inner radius
@@ -328,21 +334,21 @@ void Laplacian::PreComputeLaplacian() {
   // Precompute Laplacian Factor
 
   // Allocate Laplacian factors
-  this->Lx1 = IdefixArray4D<real>("SelfGravity_Lx1",2,
+  this->Lx1 = IdefixArray4D<real>("SelfGravity_Lx1",idfx::ArrayLayout4D(2,
                                                     this->np_tot[KDIR],
                                                     this->np_tot[JDIR],
-                                                    this->np_tot[IDIR]);
+                                                    this->np_tot[IDIR]));
   #if DIMENSIONS > 1
-    this->Lx2 = IdefixArray4D<real>("SelfGravity_Lx2",2,
+    this->Lx2 = IdefixArray4D<real>("SelfGravity_Lx2",idfx::ArrayLayout4D(2,
                                                       this->np_tot[KDIR],
                                                       this->np_tot[JDIR],
-                                                      this->np_tot[IDIR]);
+                                                      this->np_tot[IDIR]));
 
     #if DIMENSIONS > 2
-      this->Lx3 = IdefixArray4D<real>("SelfGravity_Lx3",2,
+      this->Lx3 = IdefixArray4D<real>("SelfGravity_Lx3",idfx::ArrayLayout4D(2,
                                                         this->np_tot[KDIR],
                                                         this->np_tot[JDIR],
-                                                        this->np_tot[IDIR]);
+                                                        this->np_tot[IDIR]));
     #endif
   #endif
 
@@ -594,17 +600,17 @@ void Laplacian::EnforceBoundary(int dir, BoundarySide side, LaplacianBoundaryTyp
       // all have the same value.
       int iref = this->beg[IDIR];
 
-      real psiIn = 0.0;
+      realc psiIn = 0.0;
 
       idefix_reduce("meanPsiIn",
                     beg[KDIR], end[KDIR],
                     beg[JDIR], end[JDIR],
-                    KOKKOS_LAMBDA(int k, int j, real &psi) {
+                    KOKKOS_LAMBDA(int k, int j, realc &psi) {
                       psi += localVar(k,j,iref);
-                    },Kokkos::Sum<real> (psiIn));
+                    },Kokkos::Sum<realc> (psiIn));
 
       #ifdef WITH_MPI
-        MPI_Allreduce(MPI_IN_PLACE, &psiIn, 1, realMPI, MPI_SUM, originComm);
+        MPI_Allreduce(MPI_IN_PLACE, &psiIn, 1, realcMPI, MPI_SUM, originComm);
       #endif
       // Do a mean by dividing by the number of points
       psiIn = psiIn/(data->mygrid->np_int[JDIR]*data->mygrid->np_int[KDIR]);
@@ -636,9 +642,9 @@ void Laplacian::SetBoundaries(IdefixArray3D<real> &arr) {
   idfx::pushRegion("Laplacian::SetBoundaries");
 
   #ifdef WITH_MPI
-  this->arr4D = IdefixArray4D<real> (arr.data(), 1, this->np_tot[KDIR],
+  this->arr4D = IdefixArray4D<real> (arr.data(), idfx::ArrayLayout4D(1, this->np_tot[KDIR],
                                                     this->np_tot[JDIR],
-                                                    this->np_tot[IDIR]);
+                                                    this->np_tot[IDIR], false));
   #endif
 
   for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
@@ -39,6 +39,8 @@ class Laplacian {
 
   void SetBoundaries(IdefixArray3D<real> &);  // Set the proper boundaries for the given array
 
+  void SetHaloPrecision(HaloPrecision);   // Precision of the MPI halos exchanged by SetBoundaries
+
   real ComputeCFL(); // Compute the CFL associated to the Laplacian operator (for explicit schemes)
 
   // The main laplacian operator
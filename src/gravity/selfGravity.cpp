@@ -153,6 +153,12 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
   // Make the Laplacian operator
   laplacian = std::make_unique<Laplacian>(data, lbound, rbound, this->havePreconditioner );
 
+  // Reduced precision MPI halos during the iterations (opt-in)
+  if(input.CheckEntry("SelfGravity","haloPrecision") >= 0) {
+    laplacian->SetHaloPrecision(idfx::ParseHaloPrecision(
+                      input.Get<std::string>("SelfGravity","haloPrecision",0), "SelfGravity"));
+  }
+
   np_tot = laplacian->np_tot;
 
   // Instantiate the bicgstab solver
@@ -355,7 +361,7 @@ void SelfGravity::SubstractMeanDensity() {
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &meanDensityVector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &meanDensityVector.v, 2, realcMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   real mean = meanDensityVector.v[0] / meanDensityVector.v[1];
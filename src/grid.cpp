@@ -5,6 +5,10 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
 #include <string>
 
 #include "idefix.hpp"
@@ -32,9 +36,15 @@ Grid::Grid(SubGrid * subgrid) {
 
   haveGridCoarsening = subgrid->parentGrid->haveGridCoarsening;
   coarseningDirection = subgrid->parentGrid->coarseningDirection;
+  coarseningTargetGain = subgrid->parentGrid->coarseningTargetGain;
+  coarseningTargetSize = subgrid->parentGrid->coarseningTargetSize;
 
   nproc = subgrid->parentGrid->nproc;
   xproc = subgrid->parentGrid->xproc;
+  procBeg = subgrid->parentGrid->procBeg;
+  haveWeightedDecomposition = subgrid->parentGrid->haveWeightedDecomposition;
+  haveDatatypeHalos = subgrid->parentGrid->haveDatatypeHalos;
+  haveSharedHalos = subgrid->parentGrid->haveSharedHalos;
 
   // Now slice if along the chosen direction
   SliceMe(subgrid);
@@ -150,6 +160,46 @@ Grid::Grid(Input &input) {
     xproc[i] = 0;
   }
 
+  // Domain decomposition type: uniform subdomains (default), or weighted by a cost profile
+  std::vector<std::string> costFiles;
+  if(input.CheckEntry("Grid","decomposition")>=0) {
+    std::string decompType = input.Get<std::string>("Grid","decomposition",0);
+    if(decompType.compare("weighted")==0) {
+      haveWeightedDecomposition = true;
+      if(input.CheckEntry("Grid","decomposition")>1) {
+        costFiles.push_back(input.Get<std::string>("Grid","decomposition",1));
+      }
+      if(input.restartRequested) {
+        // Rebalance using the profile measured by the run we restart from
+        std::string dmpDir = "./";
+        if(input.CheckEntry("Output","dmp_dir")>=0) {
+          dmpDir = input.Get<std::string>("Output","dmp_dir",0);
+        }
+        costFiles.push_back(dmpDir + "/idefix.cost");
+      }
+    } else if(decompType.compare("uniform")!=0) {
+      std::stringstream msg;
+      msg << "Grid decomposition can only be uniform or weighted. I got: " << decompType;
+      IDEFIX_ERROR(msg);
+    }
+  }
+
+  // Minimum width of a subdomain
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    minProcWidth[dir] = std::max(nghost[dir],1);
+  }
+  if(input.CheckBlock("Fargo") || input.CheckEntry("Hydro","fargo")>=0) {
+    // Fargo requires maxShift+nghost cells in each subdomain of the orbital direction
+    #if GEOMETRY == SPHERICAL
+      const int fargoDir = KDIR;
+    #else
+      const int fargoDir = JDIR;
+    #endif
+    int maxShift = 10;
+    if(input.CheckEntry("Fargo","maxShift")>=0) maxShift = input.Get<int>("Fargo","maxShift",0);
+    minProcWidth[fargoDir] += maxShift;
+  }
+
 #ifdef WITH_MPI
   // Domain decomposition required for the grid
 
@@ -165,36 +215,19 @@ Grid::Grid(Input &input) {
       ngridtot *= np_int[dir];
     }
     // Check that the total grid dimension is effectively divisible by number of procs
-    if(ngridtot % idfx::psize)
+    if(!haveWeightedDecomposition && ngridtot % idfx::psize)
       IDEFIX_ERROR("Total grid size must be a multiple of the number of mpi process");
     // Check that dec option has been passed
     if(input.CheckEntry("CommandLine","dec")  != DIMENSIONS) {
-      // No command line decomposition, make auto-decomposition if possible
-      // (only when nproc and dimensions are powers of 2, and in 1D)
-      if(DIMENSIONS == 1) {
-        nproc[0] = idfx::psize;
-      } else {
-        if(!isPow2(idfx::psize))
-          IDEFIX_ERROR(
-            "Automatic domain decomposition requires the number of processes to be a power of 2. "
-            "Alternatively, set a manual decomposition with -dec"
-          );
-        for(int dir = 0; dir < 3; dir++) {
-          if(!isPow2(np_int[dir]))
-            IDEFIX_ERROR(
-              "Automatic domain decomposition requires nx1, nx2 and nx3 to be powers of 2. "
-              "Alternatively, set a manual decomposition with -dec"
-            );
-        }
-        makeDomainDecomposition();
-      }
+      // No command line decomposition, make auto-decomposition
+      makeDomainDecomposition();
     } else {
       // Manual domain decomposition (with -dec option)
       int ntot=1;
       for(int dir=0 ; dir < DIMENSIONS; dir++) {
         nproc[dir] = input.Get<int>("CommandLine","dec",dir);
         // Check that the dimension is effectively divisible by number of procs along each direction
-        if(np_int[dir] % nproc[dir])
+        if(!haveWeightedDecomposition && np_int[dir] % nproc[dir])
           IDEFIX_ERROR("Grid size must be a multiple of the domain decomposition");
         // Count the total number of procs we'll need for the specified domain decomposition
         ntot = ntot * nproc[dir];
@@ -219,8 +252,49 @@ Grid::Grid(Input &input) {
   }
 
   // Create cartesian communicator along with cartesian coordinates.
-  MPI_Cart_create(MPI_COMM_WORLD, 3, nproc.data(), period, 0, &CartComm);
-  MPI_Cart_coords(CartComm, idfx::prank, 3, xproc.data());
+  if(input.CheckEntry("Grid","placement")>=0) {
+    std::string placement = input.Get<std::string>("Grid","placement",0);
+    if(placement.compare("node")==0) {
+      haveNodePlacement = true;
+    } else if(placement.compare("linear")!=0) {
+      std::stringstream msg;
+      msg << "Grid placement can only be linear or node. I got: " << placement;
+      IDEFIX_ERROR(msg);
+    }
+  }
+
+  // Halo exchange: packed in buffers (default), in place with MPI derived datatypes, or packed
+  // in an MPI shared memory window read directly by the neighbours on the same node
+  if(input.CheckEntry("Grid","haloExchange")>=0) {
+    std::string exchange = input.Get<std::string>("Grid","haloExchange",0);
+    if(exchange.compare("datatype")==0 || exchange.compare("shared")==0) {
+      if constexpr(Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                              IdefixArray4D<real>::memory_space>::accessible) {
+        haveDatatypeHalos = (exchange.compare("datatype")==0);
+        haveSharedHalos = (exchange.compare("shared")==0);
+      } else {
+        IDEFIX_WARNING("Datatype and shared halo exchanges require host accessible arrays, "
+                       "using packed exchanges.");
+      }
+    } else if(exchange.compare("packed")!=0) {
+      std::stringstream msg;
+      msg << "Grid haloExchange can only be packed, datatype or shared. I got: " << exchange;
+      IDEFIX_ERROR(msg);
+    }
+  }
+  if(haveNodePlacement && idfx::psize > 1) {
+    // Renumber the procs so that each node holds a compact block of subdomains
+    int cartRank = makeNodePlacement();
+    MPI_Comm orderedComm;
+    MPI_SAFE_CALL(MPI_Comm_split(MPI_COMM_WORLD, 0, cartRank, &orderedComm));
+    MPI_SAFE_CALL(MPI_Cart_create(orderedComm, 3, nproc.data(), period, 0, &CartComm));
+    MPI_SAFE_CALL(MPI_Comm_free(&orderedComm));
+  } else {
+    MPI_Cart_create(MPI_COMM_WORLD, 3, nproc.data(), period, 0, &CartComm);
+  }
+  int cartRank;
+  MPI_Comm_rank(CartComm, &cartRank);
+  MPI_Cart_coords(CartComm, cartRank, 3, xproc.data());
 
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -233,6 +307,14 @@ Grid::Grid(Input &input) {
   }
 #endif
 
+  // Compute the extent of each subdomain
+  std::array<std::vector<double>,3> profile;
+  for(const std::string &file : costFiles) {
+    // Later files (i.e. measured profiles) supersede earlier ones
+    ReadCost(file, profile);
+  }
+  makeProcBoundaries(profile);
+
   // init coarsening
   if(input.CheckEntry("Grid","coarsening")>=0) {
     std::string coarsenType = input.Get<std::string>("Grid","coarsening",0);
@@ -240,9 +322,27 @@ Grid::Grid(Input &input) {
       this->haveGridCoarsening = GridCoarsening::enabled;
     } else if(coarsenType.compare("dynamic")==0) {
       this->haveGridCoarsening = GridCoarsening::dynamic;
+    } else if(coarsenType.compare("auto")==0) {
+      this->haveGridCoarsening = GridCoarsening::automatic;
+      std::string target = input.Get<std::string>("Grid","coarseningTarget",0);
+      if(target.compare("gain")==0) {
+        this->coarseningTargetGain = input.Get<real>("Grid","coarseningTarget",1);
+        if(coarseningTargetGain < ONE_F) {
+          IDEFIX_ERROR("The target timestep gain of automatic grid coarsening should be >= 1");
+        }
+      } else if(target.compare("size")==0) {
+        this->coarseningTargetSize = input.Get<real>("Grid","coarseningTarget",1);
+        if(coarseningTargetSize <= ZERO_F) {
+          IDEFIX_ERROR("The target cell size of automatic grid coarsening should be > 0");
+        }
+      } else {
+        std::stringstream msg;
+        msg << "Automatic grid coarsening target can only be gain or size. I got: " << target;
+        IDEFIX_ERROR(msg);
+      }
     } else {
       std::stringstream msg;
-      msg << "Grid coarsening can only be static or dynamic. I got: " << coarsenType;
+      msg << "Grid coarsening can only be static, dynamic or auto. I got: " << coarsenType;
       IDEFIX_ERROR(msg);
     }
     this->coarseningDirection = {false, false, false};
@@ -262,50 +362,80 @@ Grid::Grid(Input &input) {
         IDEFIX_ERROR(msg);
       }
     }
-
-    this->haveGridCoarsening = GridCoarsening::enabled;
   }
   idfx::popRegion();
 }
 
-bool Grid::isPow2(int n) {
-  return( (n & (n-1)) == 0);
+// Check whether nproc procs along dir is an acceptable decomposition of the grid
+bool Grid::isValidDecomposition(int dir, int n) {
+  if(n == 1) return(true);
+  if(dir >= DIMENSIONS) return(false);
+  // Subdomains should be wide enough
+  if(np_int[dir] < n*minProcWidth[dir]) return(false);
+  // Uniform subdomains require divisibility
+  if(!haveWeightedDecomposition && np_int[dir] % n) return(false);
+  // Shearing box boundaries do not support domain decomposition in X2
+  if(dir == JDIR && (lbound[IDIR] == shearingbox || rbound[IDIR] == shearingbox)) return(false);
+  // Axis boundaries pair procs that are pi apart in X3
+  if(dir == KDIR && haveAxis && (n % 2 || np_int[dir] % n)) return(false);
+  return(true);
 }
 
-// Produce a domain decomposition in nProc assuming psize and np_int[] are powers of 2
+// Number of ghost cells exchanged between procs (counting both ways) at each halo exchange
+// for a given domain decomposition
+int64_t Grid::HaloVolume(const std::array<int,3> &decomp) {
+  int64_t volume = 0;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(decomp[dir] == 1) continue;
+    bool isPeriodic = (rbound[dir] == periodic || rbound[dir] == shearingbox);
+    int64_t interfaces = isPeriodic ? decomp[dir] : decomp[dir] - 1;
+    int64_t surface = 1;
+    for(int d = 0 ; d < DIMENSIONS ; d++) {
+      // Halos include the ghost cells of the directions that have already been exchanged
+      if(d < dir) surface *= np_int[d] + 2*nghost[d]*decomp[d];
+      if(d > dir) surface *= np_int[d];
+    }
+    volume += 2*interfaces*nghost[dir]*surface;
+  }
+  return(volume);
+}
+
+// Produce a domain decomposition of psize procs. All of the factorisations of psize are
+// explored, and the one that minimises the halo volume (and hence the surface-to-volume
+// ratio of the subdomains) is kept.
 void Grid::makeDomainDecomposition() {
-  // initialize the routine
-  int nleft=idfx::psize;
-  int nlocal[3];
-  for(int dir = 0; dir < 3; dir++) {
-    nproc[dir] = 1;
-    nlocal[dir] = np_int[dir];
-  }
-
-  // Loop
-  while(nleft>1) {
-    // Find the direction where there is a maximum of point
-    int dirmax;
-    int nmax=1;
-    int ndir=2;
-
-    for(int dir = ndir; dir >= 0; dir--) {
-      // We do this loop backward so that we divide the domain first in the last dimension
-      // (better for cache optimisation)
-      if(nlocal[dir]>nmax ) {
-        nmax=nlocal[dir];
-        dirmax=dir;
+  std::array<int,3> best = {0, 0, 0};
+  int64_t bestVolume = -1;
+  const int psize = idfx::psize;
+
+  for(int n1 = 1 ; n1 <= psize ; n1++) {
+    if(psize % n1 || !isValidDecomposition(IDIR, n1)) continue;
+    for(int n2 = 1 ; n2 <= psize/n1 ; n2++) {
+      if((psize/n1) % n2 || !isValidDecomposition(JDIR, n2)) continue;
+      const int n3 = psize/n1/n2;
+      if(!isValidDecomposition(KDIR, n3)) continue;
+      std::array<int,3> decomp = {n1, n2, n3};
+      int64_t volume = HaloVolume(decomp);
+      // For equal volumes, we keep the first one found, i.e. the one
+      // dividing the last dimensions first (better for cache optimisation)
+      if(bestVolume < 0 || volume < bestVolume) {
+        bestVolume = volume;
+        best = decomp;
       }
     }
-    // At this point, we have nmax points in direction dirmax,
-    // which is the direction we're going to divide by 2
-    if(nmax==1)
-      IDEFIX_ERROR("Your domain size is too small to be decomposed "
-                   "on this number of MPI processes");
-    nlocal[dirmax]=nlocal[dirmax]/2;
-    nproc[dirmax]=nproc[dirmax]*2;
-    nleft=nleft/2;
   }
+  if(bestVolume < 0) {
+    std::stringstream msg;
+    msg << "Cannot find an automatic domain decomposition of (";
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      msg << np_int[dir];
+      if(dir < DIMENSIONS-1) msg << ", ";
+    }
+    msg << ") cells on " << psize << " MPI processes." << std::endl
+        << "Check the number of processes, or set a manual decomposition with -dec";
+    IDEFIX_ERROR(msg);
+  }
+  nproc = best;
 }
 /*
 Grid& Grid::operator=(const Grid& grid) {
@@ -397,6 +527,16 @@ void Grid::ShowConfig() {
       idfx::cout << " " << nproc[dir] << " ";
     }
     idfx::cout << ")" << std::endl;
+    if(idfx::psize > 1) {
+      int64_t volume = HaloVolume(nproc);
+      int64_t ncells = 1;
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) ncells *= np_int[dir];
+      std::stringstream msg;
+      msg << std::setprecision(3) << "Grid: predicted halo exchange volume is " << volume
+          << " cells (" << static_cast<double>(volume)/ncells*100 << "% of the domain, "
+          << volume*sizeof(real)/1024.0/1024.0 << " MB per field)";
+      idfx::cout << msg.str() << std::endl;
+    }
     idfx::cout << "Grid: Current MPI proc coordinates (";
 
     for(int dir = 0; dir < 3; dir++) {
@@ -404,12 +544,38 @@ void Grid::ShowConfig() {
       if(dir < 2) idfx::cout << ", ";
     }
     idfx::cout << ")" << std::endl;
+    if(haveNodePlacement) {
+      idfx::cout << "Grid: node-aware rank placement, each node holds (";
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        idfx::cout << " " << nodeBlock[dir] << " ";
+      }
+      idfx::cout << ") subdomains" << std::endl;
+    }
+    if(haveDatatypeHalos) {
+      idfx::cout << "Grid: halos exchanged in place with MPI derived datatypes." << std::endl;
+    }
+    if(haveSharedHalos) {
+      idfx::cout << "Grid: halos of the neighbours on the same node read from shared memory."
+                 << std::endl;
+    }
+    if(haveWeightedDecomposition) {
+      idfx::cout << "Grid: weighted domain decomposition, subdomain widths are" << std::endl;
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        idfx::cout << "\t Direction X" << (dir+1) << ":";
+        for(int p = 0 ; p < nproc[dir] ; p++) {
+          idfx::cout << " " << procBeg[dir][p+1]-procBeg[dir][p];
+        }
+        idfx::cout << std::endl;
+      }
+    }
   #endif
   if(haveGridCoarsening) {
     if(haveGridCoarsening == GridCoarsening::enabled ) {
       idfx::cout << "Grid: static grid coarsening enabled in direction(s) ";
     } else if (haveGridCoarsening == GridCoarsening::dynamic ) {
       idfx::cout << "Grid: dynamic grid coarsening enabled in direction(s) ";
+    } else if (haveGridCoarsening == GridCoarsening::automatic ) {
+      idfx::cout << "Grid: automatic grid coarsening enabled in direction(s) ";
     } else {
       IDEFIX_ERROR("Unknown grid coarsening");
     }
@@ -464,4 +630,235 @@ void Grid::SliceMe(SubGrid *subgrid) {
     nproc[dir] = 1;
     xproc[dir] = 0;
   #endif
+  this->procBeg[dir] = {0, 1};
+}
+
+#ifdef WITH_MPI
+// Find the rank of the current proc in a cartesian communicator where the procs sharing a node
+// hold a compact block of subdomains, so that most of the halo exchanges remain within nodes.
+// Nodes are the shared memory domains found by MPI, or groups of IDEFIX_RANKS_PER_NODE
+// consecutive ranks when this environment variable is set (e.g. to emulate nodes on a laptop).
+int Grid::makeNodePlacement() {
+  idfx::pushRegion("Grid::makeNodePlacement");
+  MPI_Comm nodeComm;
+  const char *ranksPerNode = std::getenv("IDEFIX_RANKS_PER_NODE");
+  if(ranksPerNode != NULL && std::atoi(ranksPerNode) > 0) {
+    MPI_SAFE_CALL(MPI_Comm_split(MPI_COMM_WORLD, idfx::prank/std::atoi(ranksPerNode),
+                                 idfx::prank, &nodeComm));
+  } else {
+    MPI_SAFE_CALL(MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, idfx::prank,
+                                      MPI_INFO_NULL, &nodeComm));
+  }
+  int nodeRank, nodeSize;
+  MPI_Comm_rank(nodeComm, &nodeRank);
+  MPI_Comm_size(nodeComm, &nodeSize);
+
+  // Number the nodes according to the world rank of their first proc
+  int leader = idfx::prank;
+  MPI_SAFE_CALL(MPI_Bcast(&leader, 1, MPI_INT, 0, nodeComm));
+  MPI_SAFE_CALL(MPI_Comm_free(&nodeComm));
+  std::vector<int> leaders(idfx::psize);
+  std::vector<int> sizes(idfx::psize);
+  MPI_SAFE_CALL(MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, MPI_COMM_WORLD));
+  MPI_SAFE_CALL(MPI_Allgather(&nodeSize, 1, MPI_INT, sizes.data(), 1, MPI_INT, MPI_COMM_WORLD));
+  int nodeId = 0;
+  for(int p = 0 ; p < idfx::psize ; p++) {
+    // Count the node leaders before ours
+    if(leaders[p] == p && p < leader) nodeId++;
+  }
+
+  // Node blocks must all be the same
+  nodeBlock = {1, 1, 1};
+  if(*std::min_element(sizes.begin(), sizes.end()) != nodeSize
+     || *std::max_element(sizes.begin(), sizes.end()) != nodeSize) {
+    IDEFIX_WARNING("Nodes hold different numbers of MPI processes, using linear placement.");
+    idfx::popRegion();
+    return(idfx::prank);
+  }
+
+  // Choose the block of subdomains held by each node which minimises the surface of the block
+  // (i.e. the inter-node halo volume)
+  double bestSurface = -1;
+  for(int b1 = 1 ; b1 <= nodeSize ; b1++) {
+    if(nodeSize % b1 || nproc[IDIR] % b1) continue;
+    for(int b2 = 1 ; b2 <= nodeSize/b1 ; b2++) {
+      if((nodeSize/b1) % b2 || nproc[JDIR] % b2) continue;
+      const int b3 = nodeSize/b1/b2;
+      if(nproc[KDIR] % b3) continue;
+      std::array<int,3> block = {b1, b2, b3};
+      double surface = 0;
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        // No inter-node exchange when the node holds the full direction
+        if(block[dir] == nproc[dir]) continue;
+        double area = 1;
+        for(int d = 0 ; d < DIMENSIONS ; d++) {
+          if(d != dir) area *= static_cast<double>(block[d])*np_int[d]/nproc[d];
+        }
+        surface += area*nghost[dir];
+      }
+      if(bestSurface < 0 || surface < bestSurface) {
+        bestSurface = surface;
+        nodeBlock = block;
+      }
+    }
+  }
+  if(bestSurface < 0) {
+    IDEFIX_WARNING("Cannot fit node blocks in the domain decomposition, using linear placement.");
+    nodeBlock = {1, 1, 1};
+    idfx::popRegion();
+    return(idfx::prank);
+  }
+
+  // Cartesian coordinates of the current proc: node coordinates in the grid of nodes, then
+  // coordinates of the proc within the node block (last dimension varying fastest, as MPI does)
+  std::array<int,3> nodeGrid, coords;
+  for(int dir = 0 ; dir < 3 ; dir++) nodeGrid[dir] = nproc[dir]/nodeBlock[dir];
+  int node = nodeId;
+  int local = nodeRank;
+  for(int dir = 2 ; dir >= 0 ; dir--) {
+    coords[dir] = (node % nodeGrid[dir])*nodeBlock[dir] + local % nodeBlock[dir];
+    node /= nodeGrid[dir];
+    local /= nodeBlock[dir];
+  }
+  idfx::popRegion();
+  return((coords[0]*nproc[1] + coords[1])*nproc[2] + coords[2]);
+}
+#endif
+
+// Compute the offset of the first active cell of each proc in each direction. Subdomains are
+// uniform unless a weighted decomposition is used with a valid cost profile. In that case, each
+// proc gets an even share of the cumulated cost. The decomposition remains rectilinear (one set
+// of widths per direction), so that MPI neighbours always share complete faces.
+void Grid::makeProcBoundaries(const std::array<std::vector<double>,3> &profile) {
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const int n = np_int[dir];
+    const int p = nproc[dir];
+    procBeg[dir].assign(p+1, 0);
+
+    bool useProfile = haveWeightedDecomposition && p > 1
+                      && profile[dir].size() == static_cast<size_t>(n);
+    // The axis boundary pairs procs which are pi apart in X3: keep X3 uniform
+    if(haveAxis && dir == KDIR) useProfile = false;
+
+    if(haveWeightedDecomposition && p > 1) {
+      if(n < p*minProcWidth[dir]) {
+        std::stringstream msg;
+        msg << "Cannot split X" << dir+1 << " (" << n << " cells) in " << p
+            << " subdomains of at least " << minProcWidth[dir] << " cells.";
+        IDEFIX_ERROR(msg);
+      }
+      if(haveAxis && dir == KDIR && n % p) {
+        IDEFIX_ERROR("Axis boundaries require the X3 size to be a multiple of nproc along X3");
+      }
+    }
+
+    // Cumulated cost
+    std::vector<double> cumul(n+1, 0.0);
+    if(useProfile) {
+      for(int i = 0 ; i < n ; i++) {
+        cumul[i+1] = cumul[i] + profile[dir][i];
+      }
+      if(cumul[n] <= 0) useProfile = false;
+    }
+
+    for(int r = 1 ; r < p ; r++) {
+      int b;
+      if(useProfile) {
+        const double target = cumul[n]*r/p;
+        b = std::lower_bound(cumul.begin(), cumul.end(), target) - cumul.begin();
+        // Take the closest boundary
+        if(b > 0 && target - cumul[b-1] < cumul[b] - target) b--;
+        b = std::max(b, procBeg[dir][r-1] + minProcWidth[dir]);
+        b = std::min(b, n - (p-r)*minProcWidth[dir]);
+      } else {
+        b = static_cast<int>((static_cast<int64_t>(r)*n)/p);
+      }
+      procBeg[dir][r] = b;
+    }
+    procBeg[dir][p] = n;
+  }
+}
+
+// Read a cost profile. Each line reads "X<dir> <n> <cost_0> ... <cost_n-1>". Directions
+// which do not match the current grid or which have no cost are left untouched.
+bool Grid::ReadCost(const std::string &filename, std::array<std::vector<double>,3> &profile) {
+  std::ifstream file(filename);
+  if(!file.is_open()) return(false);
+
+  bool found = false;
+  std::string line;
+  while(std::getline(file, line)) {
+    if(line.empty() || line[0] == '#') continue;
+    std::istringstream stream(line);
+    std::string label;
+    int n;
+    stream >> label >> n;
+    if(stream.fail() || label.size() != 2 || label[0] != 'X') continue;
+    const int dir = label[1] - '1';
+    if(dir < 0 || dir >= DIMENSIONS) continue;
+
+    std::vector<double> values(n);
+    double sum = 0;
+    for(int i = 0 ; i < n ; i++) {
+      stream >> values[i];
+      sum += values[i];
+    }
+    if(stream.fail() || n != np_int[dir] || sum <= 0) {
+      std::stringstream msg;
+      msg << "Ignoring the X" << dir+1 << " cost profile of " << filename
+          << " which does not match the current grid.";
+      IDEFIX_WARNING(msg);
+      continue;
+    }
+    profile[dir] = values;
+    found = true;
+  }
+  if(found) idfx::cout << "Grid: using cost profile from " << filename << std::endl;
+  return(found);
+}
+
+// Distribute the compute time measured on this proc over the cells it owns
+void Grid::AccumulateCost(double computeTime) {
+  if(!haveWeightedDecomposition) return;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(cost[dir].size() != static_cast<size_t>(np_int[dir])) cost[dir].assign(np_int[dir], 0.0);
+    const int ib = procBeg[dir][xproc[dir]];
+    const int ie = procBeg[dir][xproc[dir]+1];
+    for(int i = ib ; i < ie ; i++) {
+      cost[dir][i] += computeTime/(ie-ib);
+    }
+  }
+}
+
+// Sum the cost profiles of all of the procs and write them, so that the next restart can
+// rebalance the domain decomposition
+void Grid::WriteCost(const std::string &filename) {
+  if(!haveWeightedDecomposition) return;
+  idfx::pushRegion("Grid::WriteCost");
+  std::array<std::vector<double>,3> total;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(cost[dir].size() != static_cast<size_t>(np_int[dir])) cost[dir].assign(np_int[dir], 0.0);
+    total[dir] = cost[dir];
+    #ifdef WITH_MPI
+      MPI_SAFE_CALL(MPI_Reduce(cost[dir].data(), total[dir].data(), np_int[dir], MPI_DOUBLE,
+                               MPI_SUM, 0, MPI_COMM_WORLD));
+    #endif
+  }
+  if(idfx::prank == 0) {
+    std::ofstream file(filename);
+    if(!file.is_open()) {
+      std::stringstream msg;
+      msg << "Cannot write the cost profile " << filename;
+      IDEFIX_WARNING(msg);
+    } else {
+      file << "# Idefix cost profile (compute time per cell along each direction)" << std::endl;
+      file << std::scientific << std::setprecision(6);
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        file << "X" << dir+1 << " " << np_int[dir];
+        for(const double &c : total[dir]) file << " " << c;
+        file << std::endl;
+      }
+    }
+  }
+  idfx::popRegion();
 }
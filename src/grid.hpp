@@ -9,6 +9,7 @@
 #define GRID_HPP_
 #include <vector>
 #include <memory>
+#include <string>
 #include "idefix.hpp"
 #include "input.hpp"
 
@@ -44,10 +45,19 @@ class Grid {
 
   GridCoarsening haveGridCoarsening{GridCoarsening::disabled}; ///< Is grid coarsening enabled?
   std::array<bool,3> coarseningDirection;  ///< whether a coarsening is used in each direction
+  real coarseningTargetGain{0};            ///< target dt gain of automatic coarsening
+  real coarseningTargetSize{0};            ///< target cell size of automatic coarsening
 
   // MPI data
   std::array<int,3> nproc;           ///</< Total number of procs in each direction
   std::array<int,3> xproc;           ///</< Coordinates of current proc in the array of procs
+  std::array<std::vector<int>,3> procBeg; ///< Offset of the first active cell of each proc
+                                          ///< (procBeg[dir][nproc[dir]] = np_int[dir])
+  bool haveWeightedDecomposition{false};  ///< Are subdomain widths following a cost profile?
+  bool haveNodePlacement{false};          ///< Are procs grouped by node in the cartesian comm?
+  std::array<int,3> nodeBlock{1, 1, 1};   ///< Number of subdomains held by each node
+  bool haveDatatypeHalos{false};          ///< Are halos exchanged in place with MPI datatypes?
+  bool haveSharedHalos{false};            ///< Are on-node halos read from shared memory?
 
   #ifdef WITH_MPI
   MPI_Comm CartComm;                ///< Cartesian communicator for the planned domain decomposition
@@ -63,12 +73,23 @@ class Grid {
 
   void SliceMe(SubGrid *);       ///< Slice this grid according to the subgrid (internal function)
 
+  void AccumulateCost(double);   ///< Add the compute time of this proc to the cost profile
+  void WriteCost(const std::string &);  ///< Write the cost profile (collective call)
+
   Grid() = default;
 
  private:
-  // Check if number is a power of 2
-  bool isPow2(int);
   void makeDomainDecomposition();
+  bool isValidDecomposition(int, int);
+  int64_t HaloVolume(const std::array<int,3> &);
+  #ifdef WITH_MPI
+  int makeNodePlacement();
+  #endif
+  void makeProcBoundaries(const std::array<std::vector<double>,3> &);
+  bool ReadCost(const std::string &, std::array<std::vector<double>,3> &);
+
+  std::array<std::vector<double>,3> cost;  ///< measured cost profile along each direction
+  std::array<int,3> minProcWidth;          ///< minimum subdomain width along each direction
 };
 
 /**
@@ -8,6 +8,7 @@
 #ifndef IDEFIX_HPP_
 #define IDEFIX_HPP_
 #include <fstream>
+#include <string>
 #include <iostream>
 #include <cstdio>
 #include <Kokkos_Core.hpp>
@@ -221,10 +222,22 @@ enum BoundaryType { internal, periodic, reflective, outflow, shearingbox, axis,
 enum BoundarySide { left, right};
 enum class SliceType {Cut, Average};
 
+// Precision of the ghost zones sent by MPI exchanges
+enum class HaloPrecision {Full,          ///< real values (default)
+                          Float,         ///< values rounded to float
+                          ScaledFloat};  ///< float values scaled by a power of two per message
+namespace idfx {
+// Halo precision named in an input file ("full", "float" or "scaledFloat"), the input block
+// being given for the error message
+HaloPrecision ParseHaloPrecision(const std::string &, const std::string &);
+} // namespace idfx
+
 // Type of grid coarsening
 enum GridCoarsening{disabled,
                     enabled,
-                    dynamic}; ///< enabled = static coarsening (static is a reserved c++ keyword)
+                    dynamic,
+                    automatic}; ///< enabled = static coarsening (static is a reserved c++ keyword)
+                                ///< automatic = static levels derived from the grid metrics
 
 // Commonly used classes and functions
 #include "global.hpp"
@@ -174,8 +174,47 @@ void Input::ParseCommandLine(int argc, char **argv) {
       enableLogs = false;
     } else if(std::string(argv[i]) == "-nolog") {
       enableLogs = false;
+    } else if(std::string(argv[i]) == "-perfreport") {
+      if((i+1)>= argc) {
+        IDEFIX_ERROR("-perfreport requires an additional file name");
+      }
+      this->perfReportFile = std::string(argv[++i]);
+      // The report includes the time spent in each region
+      if(!idfx::prof.perfEnabled) idfx::prof.EnablePerformanceProfiling(100);
     } else if(std::string(argv[i]) == "-profile") {
-      idfx::prof.EnablePerformanceProfiling();
+      // Optional number of cycles between two fenced cycles
+      int period = 100;
+      if((i+1) < argc && std::isdigit(argv[i+1][0]) != 0) {
+        period = std::stoi(std::string(argv[++i]));
+      }
+      idfx::prof.EnablePerformanceProfiling(period);
+    } else if(std::string(argv[i]) == "-kernelstats") {
+      // Optional peak memory bandwidth (GB/s) of the device
+      double peak = 0;
+      if((i+1) < argc && std::isdigit(argv[i+1][0]) != 0) {
+        peak = std::stod(std::string(argv[++i]));
+      }
+      idfx::prof.EnableKernelStats(peak);
+    } else if(std::string(argv[i]) == "-perfcounters") {
+      // Optional raw hardware event (processor-specific code, e.g. vector instructions)
+      uint64_t rawEvent = 0;
+      std::string rawName;
+      if((i+1) < argc && std::isdigit(argv[i+1][0]) != 0) {
+        rawName = std::string(argv[++i]);
+        rawEvent = std::stoull(rawName, nullptr, 0);
+      }
+      idfx::prof.EnableHardwareCounters(rawEvent, "raw event " + rawName);
+      // The counters are shown with the time spent in each region
+      if(!idfx::prof.perfEnabled) idfx::prof.EnablePerformanceProfiling(100);
+    } else if(std::string(argv[i]) == "-numareport") {
+      this->numaReport = true;
+    } else if(std::string(argv[i]) == "-autotune") {
+      // Optional tuning file, read at startup and updated at the end of the run
+      std::string tuningFile;
+      if((i+1) < argc && argv[i+1][0] != '-') {
+        tuningFile = std::string(argv[++i]);
+      }
+      idfx::loopTuner.Enable(tuningFile);
     } else if(std::string(argv[i]) == "-Werror") {
       idfx::warningsAreErrors = true;
     } else if(std::string(argv[i]) == "-version" || std::string(argv[i]) == "-v") {
@@ -232,7 +271,10 @@ void Input::ShowConfig() {
   idfx::cout << "-----------------------------------------------------------------------------"
              << std::endl;
 
-  #ifdef SINGLE_PRECISION
+  #if defined(MIXED_PRECISION)
+    idfx::cout << "Input: Compiled with MIXED PRECISION "
+               << "(single precision storage, double precision arithmetic)." << std::endl;
+  #elif defined(SINGLE_PRECISION)
     idfx::cout << "Input: Compiled with SINGLE PRECISION arithmetic." << std::endl;
   #else
     idfx::cout << "Input: Compiled with DOUBLE PRECISION arithmetic." << std::endl;
@@ -404,8 +446,24 @@ void Input::PrintOptions() {
   idfx::cout << "         Do not generate any output file." << std::endl;
   idfx::cout << " -nolog" << std::endl;
   idfx::cout << "         Do not write any log file." << std::endl;
-  idfx::cout << " -profile" << std::endl;
-  idfx::cout << "         Enable on-the-fly performance profiling." << std::endl;
+  idfx::cout << " -profile [n]" << std::endl;
+  idfx::cout << "         Enable on-the-fly performance profiling, with regions fenced every n ";
+  idfx::cout << "cycles (default 100, 0 to disable the fences)." << std::endl;
+  idfx::cout << " -kernelstats [bw]" << std::endl;
+  idfx::cout << "         Measure the time and memory bandwidth of each kernel (fenced), ";
+  idfx::cout << "compared to a peak bandwidth of bw GB/s when given." << std::endl;
+  idfx::cout << " -perfreport file" << std::endl;
+  idfx::cout << "         Write a JSON performance report in file at the end of the run ";
+  idfx::cout << "(implies -profile)." << std::endl;
+  idfx::cout << " -perfcounters [code]" << std::endl;
+  idfx::cout << "         Show the hardware counters of the regions (Linux only), with an ";
+  idfx::cout << "optional raw event code, e.g. 0x10c7 (implies -profile)." << std::endl;
+  idfx::cout << " -numareport" << std::endl;
+  idfx::cout << "         Show the share of the pages of the main arrays on each NUMA node ";
+  idfx::cout << "(Linux only)." << std::endl;
+  idfx::cout << " -autotune [file]" << std::endl;
+  idfx::cout << "         Choose the loop pattern of each kernel from timed launches ";
+  idfx::cout << "(Idefix_LOOP_PATTERN=Auto), with choices kept in file." << std::endl;
   idfx::cout << " -Werror" << std::endl;
   idfx::cout << "         Consider warnings as errors." << std::endl;
   idfx::cout << " -v/-version" << std::endl;
@@ -65,6 +65,10 @@ class Input {
 
   bool forceNoWrite{false};           //< explicitely disable all writes to disk
 
+  std::string perfReportFile;         //< JSON performance report written at the end (if any)
+
+  bool numaReport{false};             //< show the NUMA placement of the main arrays
+
  private:
   std::string inputFileName;
   IdefixInputContainer  inputParameters;
@@ -12,9 +12,12 @@
 #ifndef LOOP_HPP_
 #define LOOP_HPP_
 
+#include <array>
 #include <string>
+#include <typeinfo>
 #include "idefix.hpp"
 #include "global.hpp"
+#include "profiler.hpp"
 
 #define KOKKOS_VECTOR_LENGTH  8
 
@@ -30,6 +33,8 @@
 typedef Kokkos::TeamPolicy<>               team_policy;
 typedef Kokkos::TeamPolicy<>::member_type  member_type;
 
+#include "loopTuner.hpp"
+
 
 
 // Check if the user requested a specific loop unrolling strategy
@@ -81,6 +86,7 @@ template <typename Function>
 inline void idefix_for(const std::string & NAME,
                        const int & IB, const int & IE,
                        Function function) {
+  idfx::KernelProbe probe(NAME, IE-IB);
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
@@ -104,6 +110,7 @@ inline void idefix_for(const std::string & NAME,
                        const int & JB, const int & JE,
                        const int & IB, const int & IE,
                        Function function) {
+  idfx::KernelProbe probe(NAME, static_cast<double>(JE-JB)*(IE-IB));
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
@@ -155,18 +162,17 @@ inline void idefix_for(const std::string & NAME,
 }
 
 
-// 3D loop
-template <typename Function>
-inline void idefix_for(const std::string & NAME,
-                       const int & KB, const int & KE,
-                       const int & JB, const int & JE,
-                       const int & IB, const int & IE,
-                       Function function) {
-  #ifdef DEBUG
-  idfx::pushRegion("idefix_for("+NAME+")");
-  #endif
+// 3D loop with a given pattern
+template <LoopPattern pattern, typename Function>
+inline void idefix_for_3D(const std::string & NAME,
+                          const int & KB, const int & KE,
+                          const int & JB, const int & JE,
+                          const int & IB, const int & IE,
+                          Function function,
+                          const int vectorLength = KOKKOS_VECTOR_LENGTH,
+                          const std::array<int,3> &tile = {0, 0, 0}) {
   // Kokkos 1D Range
-  if constexpr(defaultLoop == LoopPattern::RANGE) {
+  if constexpr(pattern == LoopPattern::RANGE) {
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NI = IE - IB;
@@ -184,18 +190,18 @@ inline void idefix_for(const std::string & NAME,
     });
 
   // MDRange loops
-  } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
+  } else if constexpr(pattern == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({KB,JB,IB},{KE,JE,IE}), function);
+        ({KB,JB,IB},{KE,JE,IE},{tile[0],tile[1],tile[2]}), function);
 
   // TeamPolicy with single inner loops
-  } else if constexpr(defaultLoop == LoopPattern::TPX) {
+  } else if constexpr(pattern == LoopPattern::TPX) {
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NKNJ = NK * NJ;
     Kokkos::parallel_for(NAME,
-      team_policy (NKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy (NKNJ, Kokkos::AUTO,vectorLength),
       KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() / NJ + KB;
         const int j = team_member.league_rank() % NJ + JB;
@@ -206,10 +212,10 @@ inline void idefix_for(const std::string & NAME,
       });
 
   // TeamPolicy with nested TeamThreadRange and ThreadVectorRange
-  } else if constexpr(defaultLoop == LoopPattern::TPTTRTVR) {
+  } else if constexpr(pattern == LoopPattern::TPTTRTVR) {
     const int NK = KE - KB;
     Kokkos::parallel_for(NAME,
-      team_policy (NK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy (NK, Kokkos::AUTO,vectorLength),
       KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() + KB;
         Kokkos::parallel_for(
@@ -224,7 +230,7 @@ inline void idefix_for(const std::string & NAME,
       });
 
   // SIMD FOR loops
-  } else if constexpr(defaultLoop == LoopPattern::SIMDFOR) {
+  } else if constexpr(pattern == LoopPattern::SIMDFOR) {
     for (auto k = KB; k < KE; k++)
       for (auto j = JB; j < JE; j++)
 #pragma omp simd
@@ -233,6 +239,52 @@ inline void idefix_for(const std::string & NAME,
   } else {
     throw std::runtime_error("Unknown/undefined LoopPattern used.");
   }
+}
+
+// 3D loop
+template <typename Function>
+inline void idefix_for(const std::string & NAME,
+                       const int & KB, const int & KE,
+                       const int & JB, const int & JE,
+                       const int & IB, const int & IE,
+                       Function function) {
+  idfx::KernelProbe probe(NAME, static_cast<double>(KE-KB)*(JE-JB)*(IE-IB));
+  #ifdef DEBUG
+  idfx::pushRegion("idefix_for("+NAME+")");
+  #endif
+  #ifdef LOOP_PATTERN_AUTO
+    // Pattern chosen at runtime (see LoopTuner)
+    const idfx::LoopTuner::Launch launch = idfx::loopTuner.Begin(NAME, typeid(Function).name(),
+                                                                 KE-KB, JE-JB, IE-IB);
+    const idfx::LoopSettings &s = launch.settings;
+    switch(s.pattern) {
+      case LoopPattern::RANGE:
+        idefix_for_3D<LoopPattern::RANGE>(NAME, KB, KE, JB, JE, IB, IE, function);
+        break;
+      case LoopPattern::MDRANGE:
+        idefix_for_3D<LoopPattern::MDRANGE>(NAME, KB, KE, JB, JE, IB, IE, function,
+                                            s.vectorLength, s.tile);
+        break;
+      case LoopPattern::TPX:
+        idefix_for_3D<LoopPattern::TPX>(NAME, KB, KE, JB, JE, IB, IE, function, s.vectorLength);
+        break;
+      case LoopPattern::TPTTRTVR:
+        idefix_for_3D<LoopPattern::TPTTRTVR>(NAME, KB, KE, JB, JE, IB, IE, function,
+                                             s.vectorLength);
+        break;
+      case LoopPattern::SIMDFOR:
+        if constexpr(idfx::simdLoopAllowed) {
+          idefix_for_3D<LoopPattern::SIMDFOR>(NAME, KB, KE, JB, JE, IB, IE, function);
+          break;
+        }
+        [[fallthrough]];
+      default:
+        throw std::runtime_error("Unknown/undefined LoopPattern used.");
+    }
+    idfx::loopTuner.End(launch);
+  #else
+    idefix_for_3D<defaultLoop>(NAME, KB, KE, JB, JE, IB, IE, function);
+  #endif
   #ifdef DEBUG
   Kokkos::fence();
   idfx::popRegion();
@@ -247,6 +299,7 @@ inline void idefix_for(const std::string & NAME,
                        const int JB, const int JE,
                        const int IB, const int IE,
                        Function function) {
+  idfx::KernelProbe probe(NAME, static_cast<double>(KE-KB)*(JE-JB)*(IE-IB));
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
@@ -0,0 +1,191 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "idefix.hpp"
+#include "loopTuner.hpp"
+
+void idfx::LoopTuner::Enable(const std::string &file) {
+  #ifndef LOOP_PATTERN_AUTO
+    IDEFIX_WARNING("Loop tuning requires Idefix_LOOP_PATTERN=Auto, it is disabled.");
+    return;
+  #endif
+  if(enabled) return;
+  this->fileName = file;
+
+  // Candidate patterns, vector lengths and tiles
+  candidates.clear();
+  candidates.push_back({LoopPattern::RANGE});
+  candidates.push_back({LoopPattern::MDRANGE});
+  candidates.push_back({LoopPattern::MDRANGE, KOKKOS_VECTOR_LENGTH, {1, 4, 32}});
+  for(int vectorLength : {4, 8, 16, 32}) {
+    if(vectorLength > team_policy::vector_length_max()) continue;
+    candidates.push_back({LoopPattern::TPX, vectorLength});
+    candidates.push_back({LoopPattern::TPTTRTVR, vectorLength});
+  }
+  if constexpr(simdLoopAllowed) {
+    candidates.push_back({LoopPattern::SIMDFOR});
+  }
+
+  if(!fileName.empty()) Load();
+  enabled = true;
+  idfx::cout << "LoopTuner: tuning the loops of each kernel among " << candidates.size()
+             << " candidates." << std::endl;
+}
+
+idfx::LoopTuner::Launch idfx::LoopTuner::Begin(const std::string &kernelName,
+                                                const char *functor, int nk, int nj, int ni) {
+  Launch launch;
+  if(!enabled) {
+    launch.settings.pattern = idfx::defaultLoopPattern;
+    return(launch);
+  }
+  // The (mangled) functor type name tells apart the instantiations of a templated kernel, it is
+  // hashed to keep the tuning file readable
+  std::stringstream key;
+  key << kernelName << "[" << nk << "x" << nj << "x" << ni << "]#"
+      << std::hex << std::hash<std::string>{}(functor);
+  const std::string name = key.str();
+  int k;
+  auto it = kernelIndex.find(name);
+  if(it == kernelIndex.end()) {
+    k = kernels.size();
+    kernelIndex[name] = k;
+    kernelNames.push_back(name);
+    Kernel kernel;
+    kernel.minTime.assign(candidates.size(), std::numeric_limits<double>::max());
+    kernel.launches.assign(candidates.size(), 0);
+    kernels.push_back(kernel);
+  } else {
+    k = it->second;
+  }
+  Kernel &kernel = kernels[k];
+  if(kernel.best >= 0) {
+    launch.settings = kernel.settings;
+    return(launch);
+  }
+
+  // Try the candidates in turn, so that they see the same evolution of the flow
+  launch.kernel = k;
+  launch.candidate = kernel.next;
+  launch.settings = candidates[kernel.next];
+  Kokkos::fence();
+  launch.start = timer.seconds();
+  return(launch);
+}
+
+void idfx::LoopTuner::End(const Launch &launch) {
+  if(launch.kernel < 0) return;
+  Kokkos::fence();
+  const double time = timer.seconds() - launch.start;
+  Kernel &kernel = kernels[launch.kernel];
+  const int c = launch.candidate;
+  kernel.minTime[c] = std::min(kernel.minTime[c], time);
+  kernel.launches[c]++;
+  const int nCandidates = candidates.size();
+  kernel.next = (c + 1) % nCandidates;
+
+  if(kernel.launches[kernel.next] >= samples) {
+    // Every candidate has been timed: keep the fastest
+    int best = 0;
+    for(int n = 1 ; n < nCandidates ; n++) {
+      if(kernel.minTime[n] < kernel.minTime[best]) best = n;
+    }
+    kernel.best = best;
+    kernel.settings = candidates[best];
+  }
+}
+
+std::string idfx::LoopTuner::PatternName(LoopPattern pattern) {
+  switch(pattern) {
+    case LoopPattern::SIMDFOR:
+      return("SIMD");
+    case LoopPattern::RANGE:
+      return("Range");
+    case LoopPattern::MDRANGE:
+      return("MDRange");
+    case LoopPattern::TPX:
+      return("TeamPolicy");
+    case LoopPattern::TPTTRTVR:
+      return("TeamPolicyInnerVector");
+    default:
+      return("Undefined");
+  }
+}
+
+// Tuning file: one kernel per line, with its pattern, vector length and tile sizes
+void idfx::LoopTuner::Load() {
+  std::ifstream file(fileName);
+  if(!file.is_open()) {
+    idfx::cout << "LoopTuner: no tuning file " << fileName << ", all of the kernels are tuned."
+               << std::endl;
+    return;
+  }
+  std::map<std::string, LoopPattern> patterns;
+  for(auto p : {LoopPattern::SIMDFOR, LoopPattern::RANGE, LoopPattern::MDRANGE,
+                LoopPattern::TPX, LoopPattern::TPTTRTVR}) {
+    patterns[PatternName(p)] = p;
+  }
+  std::string line;
+  int nLoaded = 0;
+  while(std::getline(file, line)) {
+    std::stringstream words(line);
+    std::string name;
+    LoopSettings settings;
+    // Kernel names may contain spaces, the settings are the last 5 words
+    std::vector<std::string> w;
+    std::string word;
+    while(words >> word) w.push_back(word);
+    if(w.size() < 6 || w[0][0] == '#') continue;
+    const size_t n = w.size();
+    for(size_t i = 0 ; i < n-5 ; i++) name += ((i > 0) ? " " : "") + w[i];
+    if(patterns.count(w[n-5]) == 0) continue;
+    settings.pattern = patterns[w[n-5]];
+    settings.vectorLength = std::stoi(w[n-4]);
+    for(int d = 0 ; d < 3 ; d++) settings.tile[d] = std::stoi(w[n-3+d]);
+    if(settings.pattern == LoopPattern::SIMDFOR && !simdLoopAllowed) continue;
+
+    Kernel kernel;
+    kernel.best = 0;
+    kernel.settings = settings;
+    kernelIndex[name] = kernels.size();
+    kernelNames.push_back(name);
+    kernels.push_back(kernel);
+    nLoaded++;
+  }
+  idfx::cout << "LoopTuner: " << nLoaded << " kernel settings read from " << fileName << "."
+             << std::endl;
+}
+
+void idfx::LoopTuner::Save() {
+  if(!enabled) return;
+  std::map<std::string, int> count;
+  for(auto &kernel : kernels) {
+    if(kernel.best >= 0) count[PatternName(kernel.settings.pattern)]++;
+  }
+  idfx::cout << "LoopTuner: patterns chosen for the " << kernels.size() << " kernels:";
+  for(auto &it : count) idfx::cout << " " << it.first << " (" << it.second << ")";
+  idfx::cout << "." << std::endl;
+
+  if(fileName.empty() || idfx::prank != 0) return;
+  std::ofstream file(fileName);
+  file << "# kernel  pattern  vectorLength  tile(k j i)" << std::endl;
+  for(size_t k = 0 ; k < kernels.size() ; k++) {
+    if(kernels[k].best < 0) continue;
+    const LoopSettings &s = kernels[k].settings;
+    file << kernelNames[k] << " " << PatternName(s.pattern) << " " << s.vectorLength << " "
+         << s.tile[0] << " " << s.tile[1] << " " << s.tile[2] << std::endl;
+  }
+  idfx::cout << "LoopTuner: choices written in " << fileName << "." << std::endl;
+}
@@ -0,0 +1,85 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef LOOPTUNER_HPP_
+#define LOOPTUNER_HPP_
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace idfx {
+
+// Whether the SIMD loops (serial loops vectorised by the compiler) can run on the backend
+#if defined(KOKKOS_ENABLE_OPENMP) || defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) \
+    || defined(KOKKOS_ENABLE_SYCL)
+  constexpr bool simdLoopAllowed = false;
+#else
+  constexpr bool simdLoopAllowed = true;
+#endif
+
+// How a 3D idefix_for is launched
+struct LoopSettings {
+  LoopPattern pattern{LoopPattern::UNDEFINED};
+  int vectorLength{KOKKOS_VECTOR_LENGTH};   // Team policies only
+  std::array<int,3> tile{0, 0, 0};          // MDRange only (0: Kokkos default)
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Runtime choice of the loop pattern of each kernel (with Idefix_LOOP_PATTERN=Auto).
+/// When tuning is enabled (-autotune), the first launches of each 3D idefix_for kernel go through
+/// the candidate patterns and vector/tile sizes in turn, each launch being fenced and timed. Once
+/// every candidate has been timed a few times, the fastest one is used for the rest of the run.
+/// Kernels are identified by their name, the type of their functor and the extent of their
+/// iteration range, since the same name may be used by several loops (e.g. in each direction, or
+/// in each Phys instantiation of the fluid kernels).
+/// Since each launch is only executed once, tuning does not change the results. The choices can be
+/// stored in a tuning file, which is read at startup so that the kernels it lists are not tuned
+/// again. Without tuning, all of the kernels use idfx::defaultLoopPattern.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class LoopTuner {
+ public:
+  struct Launch {
+    LoopSettings settings;
+    int kernel{-1};                 // Kernel being tuned by this launch (-1 if none)
+    int candidate{-1};
+    double start{0};
+  };
+
+  void Enable(const std::string &);   // Enable tuning, with an optional tuning file
+  // Settings of the next launch of a kernel, given its name, functor type name and iteration
+  // range extent (k,j,i)
+  Launch Begin(const std::string &, const char *, int, int, int);
+  void End(const Launch &);
+  void Save();                        // Show the choices, and write them in the tuning file
+  static std::string PatternName(LoopPattern);
+
+  bool enabled{false};
+
+ private:
+  struct Kernel {
+    std::vector<double> minTime;      // Shortest launch with each candidate
+    std::vector<int> launches;        // # of timed launches with each candidate
+    int next{0};                      // Candidate of the next launch
+    int best{-1};                     // Chosen candidate (-1 while tuning)
+    LoopSettings settings;            // Chosen settings
+  };
+  void Load();
+
+  std::string fileName;
+  int samples{3};                     // # of timed launches with each candidate
+  std::vector<LoopSettings> candidates;
+  std::unordered_map<std::string, int> kernelIndex;   // Index of each name[nkxnjxni]#id key
+  std::vector<Kernel> kernels;
+  std::vector<std::string> kernelNames;
+  Kokkos::Timer timer;
+};
+
+}// namespace idfx
+
+#endif // LOOPTUNER_HPP_
@@ -29,6 +29,7 @@
 
 #include "idefix.hpp"
 #include "profiler.hpp"
+#include "numa.hpp"
 #include "input.hpp"
 #include "units.hpp"
 #include "grid.hpp"
@@ -177,6 +178,15 @@ int main( int argc, char* argv[] ) {
       output.CheckForWrites(data);
     }
 
+    // Pages placement, once the initial conditions are set
+    if(input.numaReport) {
+      idfx::ReportNumaPlacement(data.hydro->Vc);
+      idfx::ReportNumaPlacement(data.hydro->Uc);
+      idfx::ReportNumaPlacement(data.hydro->Vs);
+      idfx::ReportNumaPlacement(data.hydro->FluxRiemann);
+      idfx::ReportNumaPlacement(data.hydro->InvDt);
+    }
+
     ///////////////////////////////
     // Main Loop
     ///////////////////////////////
@@ -283,6 +293,24 @@ int main( int argc, char* argv[] ) {
               << "% of total run time." << std::endl;
     // Show profiler output
     idfx::prof.Show();
+    idfx::loopTuner.Save();
+    if(!input.perfReportFile.empty()) {
+      double mpiTime = idfx::mpiCallsTimer;
+      #ifdef WITH_MPI
+        MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &mpiTime, 1, MPI_DOUBLE, MPI_SUM,
+                                    MPI_COMM_WORLD));
+        mpiTime /= idfx::psize;
+      #endif
+      idfx::prof.WriteReport(input.perfReportFile,
+                             {{"cellUpdatesPerSecond", 1/perfs},
+                              {"wallTime", timer.seconds()},
+                              {"cycles", static_cast<double>(Tint.GetNCycles())},
+                              {"ranks", static_cast<double>(idfx::psize)},
+                              {"cells", static_cast<double>(grid.np_int[IDIR])*grid.np_int[JDIR]
+                                        *grid.np_int[KDIR]},
+                              {"mpiOverhead", mpiTime/timer.seconds()},
+                              {"outputOverhead", output.GetTimer()/timer.seconds()}});
+    }
   }
 
   if(returnCode<0) {
@@ -8,6 +8,7 @@
 
 #include "mpi.hpp"
 #include <signal.h>
+#include <algorithm>
 #include <string>
 #include <chrono>   // NOLINT [build/c++11]
 #include <thread>  // NOLINT [build/c++11]
@@ -59,6 +60,10 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
   this->mapVars = idfx::ConvertVectorToIdefixArray(inputMap);
   this->mapNVars = inputMap.size();
   this->haveVs = inputHaveVs;
+  #ifdef MPI_PERSISTENT
+    this->haveDatatypeHalos = grid->haveDatatypeHalos;
+    this->haveSharedHalos = grid->haveSharedHalos;
+  #endif
 
   // Compute indices of arrays we will be working with
   for(int dir = 0 ; dir < 3 ; dir++) {
@@ -94,6 +99,7 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
   BufferRecvX1[faceRight] = Buffer(bufferSizeX1);
   BufferSendX1[faceLeft ] = Buffer(bufferSizeX1);
   BufferSendX1[faceRight] = Buffer(bufferSizeX1);
+  InitHaloSegments(IDIR, bufferSizeX1);
 
   // Number of cells in X2 boundary condition (only required when problem >2D):
 #if DIMENSIONS >= 2
@@ -113,6 +119,7 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
   BufferRecvX2[faceRight] = Buffer(bufferSizeX2);
   BufferSendX2[faceLeft ] = Buffer(bufferSizeX2);
   BufferSendX2[faceRight] = Buffer(bufferSizeX2);
+  InitHaloSegments(JDIR, bufferSizeX2);
 
 #endif
 // Number of cells in X3 boundary condition (only required when problem is 3D):
@@ -132,8 +139,12 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
   BufferRecvX3[faceRight] = Buffer(bufferSizeX3);
   BufferSendX3[faceLeft ] = Buffer(bufferSizeX3);
   BufferSendX3[faceRight] = Buffer(bufferSizeX3);
+  InitHaloSegments(KDIR, bufferSizeX3);
 #endif // DIMENSIONS
 
+  // Move the send buffers to the shared memory window, before the requests use them
+  if(haveSharedHalos) InitSharedHalos();
+
 #ifdef MPI_PERSISTENT
   // Init persistent MPI communications
   int procSend, procRecv;
@@ -208,6 +219,503 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
   idfx::popRegion();
 }
 
+///
+/// Build the table of the halo segments exchanged in direction dir: the mapped cell-centered
+/// variables, then each face-centered field component, in the order of the messages.
+///
+void Mpi::InitHaloSegments(int dir, int bufferSize) {
+  std::vector<HaloSegment> segments;
+
+  // Region of the cell-centered halos: the active zone in the directions which are exchanged
+  // after this one, and the full arrays (with the ghost zones already exchanged) before
+  auto makeSegment = [&](int faceCentered, int var) {
+    HaloSegment seg;
+    seg.faceCentered = faceCentered;
+    seg.var = var;
+    seg.offset = 0;
+    for(int d = 0 ; d < 3 ; d++) {
+      if(d == dir) {
+        seg.n[d] = nghost[d];
+        seg.send[faceRight][d] = end[d]-nghost[d];
+        seg.send[faceLeft][d] = beg[d];
+        seg.recv[faceRight][d] = end[d];
+        seg.recv[faceLeft][d] = 0;
+      } else {
+        const int start = (d < dir) ? 0 : beg[d];
+        seg.n[d] = (d < dir) ? ntot[d] : nint[d];
+        for(int side = faceRight ; side <= faceLeft ; side++) {
+          seg.send[side][d] = start;
+          seg.recv[side][d] = start;
+        }
+      }
+    }
+    return(seg);
+  };
+
+  IdefixHostArray1D<int> mapHost = Kokkos::create_mirror_view(mapVars);
+  Kokkos::deep_copy(mapHost, mapVars);
+  for(int n = 0 ; n < mapNVars ; n++) {
+    segments.push_back(makeSegment(0, mapHost(n)));
+  }
+  if(haveVs) {
+    for(int component = 0 ; component < DIMENSIONS ; component++) {
+      HaloSegment seg = makeSegment(1, component);
+      if(component == dir) {
+        // The face shared with the neighbour is not exchanged
+        seg.send[faceLeft][dir] += 1;
+        seg.recv[faceRight][dir] += 1;
+      } else {
+        seg.n[component] += 1;
+      }
+      segments.push_back(seg);
+    }
+  }
+
+  // Offsets of the segments in the messages
+  int offset = 0;
+  for(auto &seg : segments) {
+    seg.offset = offset;
+    offset += seg.n[IDIR]*seg.n[JDIR]*seg.n[KDIR];
+  }
+  if(offset != bufferSize) {
+    IDEFIX_ERROR("Mpi: the halo segments do not match the size of the MPI buffers");
+  }
+  this->haloSegments[dir] = idfx::ConvertVectorToIdefixArray(segments);
+  this->haloSegmentsHost[dir] = segments;
+  this->nHaloSegments[dir] = segments.size();
+}
+
+///
+/// Pack the halos of both sides of direction dir in the send buffers, in a single kernel.
+/// Each element of the messages finds its segment, and then its cell in the arrays.
+///
+void Mpi::PackHalos(int dir, IdefixArray4D<real> &Vc, IdefixArray4D<real> &Vs) {
+  Buffer *buffer = (dir == IDIR) ? BufferSendX1 : ((dir == JDIR) ? BufferSendX2 : BufferSendX3);
+  IdefixArray1D<real> right = buffer[faceRight].GetArray();
+  IdefixArray1D<real> left = buffer[faceLeft].GetArray();
+  IdefixArray1D<HaloSegment> segments = this->haloSegments[dir];
+  const int nSegments = this->nHaloSegments[dir];
+  const int size = buffer[faceRight].Size();
+
+  idefix_for("MpiPackHalos", 0, 2*size,
+    KOKKOS_LAMBDA (int idx) {
+      // faceRight == 0, faceLeft == 1
+      const int side = (idx < size) ? 0 : 1;
+      const int m = idx - side*size;
+      int s = nSegments-1;
+      while(m < segments(s).offset) s--;
+      const HaloSegment &seg = segments(s);
+      int r = m - seg.offset;
+      const int i = seg.send[side][IDIR] + r % seg.n[IDIR];
+      r = r / seg.n[IDIR];
+      const int j = seg.send[side][JDIR] + r % seg.n[JDIR];
+      const int k = seg.send[side][KDIR] + r / seg.n[JDIR];
+      const real value = seg.faceCentered ? Vs(seg.var,k,j,i) : Vc(seg.var,k,j,i);
+      if(side == 0) {
+        right(m) = value;
+      } else {
+        left(m) = value;
+      }
+    });
+}
+
+///
+/// Unpack the messages received from both sides of direction dir in the ghost zones, in a
+/// single kernel. The buffers are those of the received messages, unless from is given.
+///
+void Mpi::UnpackHalos(int dir, IdefixArray4D<real> &Vc, IdefixArray4D<real> &Vs,
+                      Buffer *from) {
+  Buffer *buffer = (dir == IDIR) ? BufferRecvX1 : ((dir == JDIR) ? BufferRecvX2 : BufferRecvX3);
+  if(from != nullptr) buffer = from;
+  IdefixArray1D<real> right = buffer[faceRight].GetArray();
+  IdefixArray1D<real> left = buffer[faceLeft].GetArray();
+  IdefixArray1D<HaloSegment> segments = this->haloSegments[dir];
+  const int nSegments = this->nHaloSegments[dir];
+  const int size = buffer[faceRight].Size();
+
+  idefix_for("MpiUnpackHalos", 0, 2*size,
+    KOKKOS_LAMBDA (int idx) {
+      // faceRight == 0, faceLeft == 1
+      const int side = (idx < size) ? 0 : 1;
+      const int m = idx - side*size;
+      int s = nSegments-1;
+      while(m < segments(s).offset) s--;
+      const HaloSegment &seg = segments(s);
+      int r = m - seg.offset;
+      const int i = seg.recv[side][IDIR] + r % seg.n[IDIR];
+      r = r / seg.n[IDIR];
+      const int j = seg.recv[side][JDIR] + r % seg.n[JDIR];
+      const int k = seg.recv[side][KDIR] + r / seg.n[JDIR];
+      const real value = (side == 0) ? right(m) : left(m);
+      if(seg.faceCentered) {
+        Vs(seg.var,k,j,i) = value;
+      } else {
+        Vc(seg.var,k,j,i) = value;
+      }
+    });
+}
+
+///
+/// Derived datatype describing the halos sent to (send=true) or received from one side of
+/// direction dir. Since Vc and Vs are separate allocations, the displacements are the absolute
+/// addresses of the segments, and the datatype is used with MPI_BOTTOM. Each segment is a block
+/// of cells built from the strides of its array, so that any layout of the arrays can be used.
+///
+MPI_Datatype Mpi::MakeHaloDatatype(int dir, int side, bool send,
+                                   IdefixArray4D<real> &Vc, IdefixArray4D<real> &Vs) {
+  const std::vector<HaloSegment> &segments = haloSegmentsHost[dir];
+  const int nSegments = segments.size();
+  std::vector<int> blockLengths(nSegments, 1);
+  std::vector<MPI_Aint> displacements(nSegments);
+  std::vector<MPI_Datatype> blocks(nSegments);
+
+  for(int s = 0 ; s < nSegments ; s++) {
+    const HaloSegment &seg = segments[s];
+    IdefixArray4D<real> &arr = seg.faceCentered ? Vs : Vc;
+    const int *start = send ? seg.send[side] : seg.recv[side];
+
+    // Rows along i, planes along j, and the block along k (i first, as in the packed messages)
+    MPI_Datatype row, plane;
+    MPI_SAFE_CALL(MPI_Type_create_hvector(seg.n[IDIR], 1, arr.stride(3)*sizeof(real),
+                                          realMPI, &row));
+    MPI_SAFE_CALL(MPI_Type_create_hvector(seg.n[JDIR], 1, arr.stride(2)*sizeof(real),
+                                          row, &plane));
+    MPI_SAFE_CALL(MPI_Type_create_hvector(seg.n[KDIR], 1, arr.stride(1)*sizeof(real),
+                                          plane, &blocks[s]));
+    MPI_SAFE_CALL(MPI_Type_free(&row));
+    MPI_SAFE_CALL(MPI_Type_free(&plane));
+
+    real *first = arr.data() + seg.var*arr.stride(0) + start[KDIR]*arr.stride(1)
+                             + start[JDIR]*arr.stride(2) + start[IDIR]*arr.stride(3);
+    MPI_SAFE_CALL(MPI_Get_address(first, &displacements[s]));
+  }
+
+  MPI_Datatype type;
+  MPI_SAFE_CALL(MPI_Type_create_struct(nSegments, blockLengths.data(), displacements.data(),
+                                       blocks.data(), &type));
+  MPI_SAFE_CALL(MPI_Type_commit(&type));
+  for(auto &block : blocks) {
+    MPI_SAFE_CALL(MPI_Type_free(&block));
+  }
+  return(type);
+}
+
+void Mpi::FreeDatatypeExchange(DatatypeExchange &exchange) {
+  for(int i=0 ; i< 2; i++) {
+    MPI_Request_free( &exchange.sendRequest[i]);
+    MPI_Request_free( &exchange.recvRequest[i]);
+    MPI_Type_free( &exchange.sendType[i]);
+    MPI_Type_free( &exchange.recvType[i]);
+  }
+}
+
+///
+/// Datatypes and persistent requests exchanging the halos of (Vc, Vs) in direction dir, created
+/// on the first exchange of these arrays. Some arrays are only wrapped for one exchange (e.g.
+/// by DiffusionOperator::SetBoundaries), so only the most recently used ones are kept.
+///
+Mpi::DatatypeExchange& Mpi::GetDatatypeExchange(int dir, IdefixArray4D<real> &Vc,
+                                                IdefixArray4D<real> &Vs) {
+  std::vector<DatatypeExchange> &exchanges = datatypeExchanges[dir];
+  for(size_t n = 0 ; n < exchanges.size() ; n++) {
+    if(exchanges[n].vcData == Vc.data() && exchanges[n].vsData == Vs.data()
+        && exchanges[n].nvar == static_cast<int>(Vc.extent(0))) {
+      // Move it to the back of the list (most recently used)
+      std::rotate(exchanges.begin()+n, exchanges.begin()+n+1, exchanges.end());
+      return(exchanges.back());
+    }
+  }
+  idfx::pushRegion("Mpi::GetDatatypeExchange");
+  if(exchanges.size() >= maxDatatypeExchanges) {
+    // Drop the least recently used
+    FreeDatatypeExchange(exchanges.front());
+    exchanges.erase(exchanges.begin());
+  }
+  DatatypeExchange exchange;
+  exchange.vcData = Vc.data();
+  exchange.vsData = Vs.data();
+  exchange.nvar = Vc.extent(0);
+  for(int side = faceRight ; side <= faceLeft ; side++) {
+    exchange.sendType[side] = MakeHaloDatatype(dir, side, true, Vc, Vs);
+    exchange.recvType[side] = MakeHaloDatatype(dir, side, false, Vc, Vs);
+  }
+
+  // Same neighbours as the packed exchanges, with their own tags
+  const int tag = thisInstance*1000+300+10*dir;
+  int procSend, procRecv;
+  MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,dir,1,&procRecv,&procSend ));
+  MPI_SAFE_CALL(MPI_Send_init(MPI_BOTTOM, 1, exchange.sendType[faceRight], procSend, tag,
+                              mygrid->CartComm, &exchange.sendRequest[faceRight]));
+  MPI_SAFE_CALL(MPI_Recv_init(MPI_BOTTOM, 1, exchange.recvType[faceLeft], procRecv, tag,
+                              mygrid->CartComm, &exchange.recvRequest[faceLeft]));
+
+  MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,dir,-1,&procRecv,&procSend ));
+  MPI_SAFE_CALL(MPI_Send_init(MPI_BOTTOM, 1, exchange.sendType[faceLeft], procSend, tag+1,
+                              mygrid->CartComm, &exchange.sendRequest[faceLeft]));
+  MPI_SAFE_CALL(MPI_Recv_init(MPI_BOTTOM, 1, exchange.recvType[faceRight], procRecv, tag+1,
+                              mygrid->CartComm, &exchange.recvRequest[faceRight]));
+
+  exchanges.push_back(exchange);
+  idfx::popRegion();
+  return(exchanges.back());
+}
+
+///
+/// Exchange the halos of direction dir in place, without packing. The regions sent (active
+/// zone) and received (ghost zones) do not overlap, so both can proceed at the same time.
+///
+void Mpi::ExchangeDatatypes(int dir, IdefixArray4D<real> &Vc, IdefixArray4D<real> &Vs) {
+  DatatypeExchange &exchange = GetDatatypeExchange(dir, Vc, Vs);
+  const int bufferSize[3] = {bufferSizeX1, bufferSizeX2, bufferSizeX3};
+  MPI_Status sendStatus[2];
+  MPI_Status recvStatus[2];
+
+  // The arrays should be up to date before MPI reads them
+  Kokkos::fence();
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+  MPI_SAFE_CALL(MPI_Startall(2, exchange.recvRequest));
+  MPI_SAFE_CALL(MPI_Startall(2, exchange.sendRequest));
+  MPI_Waitall(2, exchange.recvRequest, recvStatus);
+  MPI_Waitall(2, exchange.sendRequest, sendStatus);
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  myTimer += MPI_Wtime();
+  bytesSentOrReceived += 4*bufferSize[dir]*sizeof(real);
+}
+
+///
+/// Allocate the send buffers in a shared memory window of the ranks on this node, and find the
+/// send buffers of the neighbours on the same node, which are then unpacked in place.
+///
+void Mpi::InitSharedHalos() {
+  idfx::pushRegion("Mpi::InitSharedHalos");
+  MPI_SAFE_CALL(MPI_Comm_split_type(mygrid->CartComm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                                    &nodeComm));
+  const int bufferSize[3] = {bufferSizeX1, bufferSizeX2, bufferSizeX3};
+  Buffer *sendBuffer[3] = {BufferSendX1, BufferSendX2, BufferSendX3};
+
+  // Window layout: right then left send buffers of each direction
+  MPI_Aint offset[3][2];
+  MPI_Aint windowSize = 0;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    for(int side = faceRight ; side <= faceLeft ; side++) {
+      offset[dir][side] = windowSize;
+      windowSize += bufferSize[dir];
+    }
+  }
+  real *base;
+  MPI_SAFE_CALL(MPI_Win_allocate_shared(windowSize*sizeof(real), sizeof(real), MPI_INFO_NULL,
+                                        nodeComm, &base, &sharedWindow));
+  // Passive target epoch, for MPI_Win_sync
+  MPI_SAFE_CALL(MPI_Win_lock_all(MPI_MODE_NOCHECK, sharedWindow));
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    for(int side = faceRight ; side <= faceLeft ; side++) {
+      sendBuffer[dir][side] = Buffer(base + offset[dir][side], bufferSize[dir]);
+    }
+  }
+
+  // Neighbours on this node
+  MPI_Group cartGroup, nodeGroup;
+  MPI_SAFE_CALL(MPI_Comm_group(mygrid->CartComm, &cartGroup));
+  MPI_SAFE_CALL(MPI_Comm_group(nodeComm, &nodeGroup));
+  int nShared = 0;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    int proc[2];
+    MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm, dir, 1, &proc[faceLeft], &proc[faceRight]));
+    for(int side = faceRight ; side <= faceLeft ; side++) {
+      if(proc[side] == MPI_PROC_NULL) continue;
+      int nodeRank;
+      MPI_SAFE_CALL(MPI_Group_translate_ranks(cartGroup, 1, &proc[side], nodeGroup, &nodeRank));
+      if(nodeRank == MPI_UNDEFINED) continue;
+      MPI_Aint size;
+      int dispUnit;
+      real *peer;
+      MPI_SAFE_CALL(MPI_Win_shared_query(sharedWindow, nodeRank, &size, &dispUnit, &peer));
+      // Our right neighbour sends us its left buffer, and conversely
+      const int peerSide = (side == faceRight) ? faceLeft : faceRight;
+      peerBuffer[dir][side] = Buffer(peer + offset[dir][peerSide], bufferSize[dir]);
+      sharedSide[dir][side] = true;
+      nShared++;
+    }
+  }
+  MPI_SAFE_CALL(MPI_Group_free(&cartGroup));
+  MPI_SAFE_CALL(MPI_Group_free(&nodeGroup));
+
+  // Handshakes with the neighbours on this node (empty messages): our buffer is ready to be
+  // read, and the neighbour is done reading our buffer.
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    const int tag = thisInstance*1000+600+10*dir;
+    int procSend, procRecv;
+    MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,dir,1,&procRecv,&procSend ));
+    MPI_SAFE_CALL(MPI_Send_init(nullptr, 0, MPI_BYTE, procSend, tag, mygrid->CartComm,
+                                &readySendRequest[dir][faceRight]));
+    MPI_SAFE_CALL(MPI_Recv_init(nullptr, 0, MPI_BYTE, procRecv, tag, mygrid->CartComm,
+                                &readyRecvRequest[dir][faceLeft]));
+    MPI_SAFE_CALL(MPI_Send_init(nullptr, 0, MPI_BYTE, procSend, tag+2, mygrid->CartComm,
+                                &doneSendRequest[dir][faceRight]));
+    MPI_SAFE_CALL(MPI_Recv_init(nullptr, 0, MPI_BYTE, procRecv, tag+2, mygrid->CartComm,
+                                &doneRecvRequest[dir][faceLeft]));
+
+    MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,dir,-1,&procRecv,&procSend ));
+    MPI_SAFE_CALL(MPI_Send_init(nullptr, 0, MPI_BYTE, procSend, tag+1, mygrid->CartComm,
+                                &readySendRequest[dir][faceLeft]));
+    MPI_SAFE_CALL(MPI_Recv_init(nullptr, 0, MPI_BYTE, procRecv, tag+1, mygrid->CartComm,
+                                &readyRecvRequest[dir][faceRight]));
+    MPI_SAFE_CALL(MPI_Send_init(nullptr, 0, MPI_BYTE, procSend, tag+3, mygrid->CartComm,
+                                &doneSendRequest[dir][faceLeft]));
+    MPI_SAFE_CALL(MPI_Recv_init(nullptr, 0, MPI_BYTE, procRecv, tag+3, mygrid->CartComm,
+                                &doneRecvRequest[dir][faceRight]));
+  }
+  if(thisInstance == 1) {
+    idfx::cout << "Mpi(" << thisInstance << "): " << nShared << " of the neighbours of rank "
+               << idfx::prank << " are read from shared memory." << std::endl;
+  }
+  idfx::popRegion();
+}
+
+///
+/// Exchange the halos of direction dir, reading the send buffers of the neighbours on the same
+/// node in place. Our send buffer on one side is only overwritten once the neighbour on this
+/// side is done reading it, and only read once it has been packed. The other sides use the
+/// persistent messages.
+///
+void Mpi::ExchangeShared(int dir, IdefixArray4D<real> &Vc, IdefixArray4D<real> &Vs) {
+  const int bufferSize[3] = {bufferSizeX1, bufferSizeX2, bufferSizeX3};
+  Buffer *recvBuffer[3] = {BufferRecvX1, BufferRecvX2, BufferRecvX3};
+  MPI_Request *sendRequest[3] = {sendRequestX1, sendRequestX2, sendRequestX3};
+  MPI_Request *recvRequest[3] = {recvRequestX1, recvRequestX2, recvRequestX3};
+  const bool *shared = sharedSide[dir];
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+  for(int side = faceRight ; side <= faceLeft ; side++) {
+    MPI_SAFE_CALL(MPI_Start(shared[side] ? &readyRecvRequest[dir][side]
+                                         : &recvRequest[dir][side]));
+  }
+  WaitSharedReads(dir);
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  myTimer += MPI_Wtime();
+
+  PackHalos(dir, Vc, Vs);
+  Kokkos::fence();
+
+  myTimer -= MPI_Wtime();
+  tStart = MPI_Wtime();
+  MPI_SAFE_CALL(MPI_Win_sync(sharedWindow));
+  for(int side = faceRight ; side <= faceLeft ; side++) {
+    MPI_SAFE_CALL(MPI_Start(shared[side] ? &readySendRequest[dir][side]
+                                         : &sendRequest[dir][side]));
+  }
+  for(int side = faceRight ; side <= faceLeft ; side++) {
+    MPI_Wait(shared[side] ? &readyRecvRequest[dir][side] : &recvRequest[dir][side],
+             MPI_STATUS_IGNORE);
+  }
+  MPI_SAFE_CALL(MPI_Win_sync(sharedWindow));
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  myTimer += MPI_Wtime();
+
+  Buffer from[2];
+  for(int side = faceRight ; side <= faceLeft ; side++) {
+    from[side] = shared[side] ? peerBuffer[dir][side] : recvBuffer[dir][side];
+    if(!shared[side]) bytesSentOrReceived += 2*bufferSize[dir]*sizeof(real);
+  }
+  UnpackHalos(dir, Vc, Vs, from);
+  Kokkos::fence();
+
+  // Tell the neighbours that we are done reading their buffers
+  myTimer -= MPI_Wtime();
+  tStart = MPI_Wtime();
+  for(int side = faceRight ; side <= faceLeft ; side++) {
+    if(shared[side]) {
+      MPI_SAFE_CALL(MPI_Start(&doneSendRequest[dir][side]));
+      MPI_SAFE_CALL(MPI_Start(&doneRecvRequest[dir][side]));
+    }
+    MPI_Wait(shared[side] ? &readySendRequest[dir][side] : &sendRequest[dir][side],
+             MPI_STATUS_IGNORE);
+  }
+  sharedStarted[dir] = true;
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  myTimer += MPI_Wtime();
+}
+
+///
+/// Wait until the neighbours on this node are done reading our send buffers of direction dir,
+/// before they are overwritten.
+///
+void Mpi::WaitSharedReads(int dir) {
+  if(!sharedStarted[dir]) return;
+  for(int side = faceRight ; side <= faceLeft ; side++) {
+    if(sharedSide[dir][side]) {
+      MPI_Wait(&doneRecvRequest[dir][side], MPI_STATUS_IGNORE);
+      MPI_Wait(&doneSendRequest[dir][side], MPI_STATUS_IGNORE);
+    }
+  }
+  sharedStarted[dir] = false;
+}
+
+///
+/// Select the precision of the halo messages sent by this instance. Reduced precision
+/// halos halve the exchanged volume in double precision, and should only be used
+/// where the rounding of the ghost zones is tolerable (iterative solvers, column densities,
+/// first stages of sub-cycled parabolic schemes).
+///
+void Mpi::SetHaloPrecision(HaloPrecision precision) {
+  // Nothing to gain when real values are already floats
+  if(sizeof(real) <= sizeof(float)) precision = HaloPrecision::Full;
+  #ifndef MPI_PERSISTENT
+    if(precision != HaloPrecision::Full) {
+      IDEFIX_WARNING("Reduced precision halos require MPI persistent communications, ignoring.");
+      precision = HaloPrecision::Full;
+    }
+  #endif
+  if(precision != HaloPrecision::Full && !haveCompactRequests) {
+    InitCompactRequests();
+  }
+  this->haloPrecision = precision;
+}
+
+void Mpi::InitCompactRequests() {
+  idfx::pushRegion("Mpi::InitCompactRequests");
+  Buffer *sendBuffer[3] = {BufferSendX1, BufferSendX2, BufferSendX3};
+  Buffer *recvBuffer[3] = {BufferRecvX1, BufferRecvX2, BufferRecvX3};
+  MPI_Request *sendRequest[3] = {sendCompactRequestX1, sendCompactRequestX2,
+                                 sendCompactRequestX3};
+  MPI_Request *recvRequest[3] = {recvCompactRequestX1, recvCompactRequestX2,
+                                 recvCompactRequestX3};
+
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    for(int side = faceRight ; side <= faceLeft ; side++) {
+      sendBuffer[dir][side].AllocateCompact();
+      recvBuffer[dir][side].AllocateCompact();
+    }
+    const int size = sendBuffer[dir][faceRight].CompactSize();
+    // Tags are offset from the full precision ones
+    const int tag = thisInstance*1000+500+10*dir;
+    int procSend, procRecv;
+
+    // Send to the right
+    MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,dir,1,&procRecv,&procSend ));
+    MPI_SAFE_CALL(MPI_Send_init(sendBuffer[dir][faceRight].compactData(), size, MPI_FLOAT,
+                  procSend, tag, mygrid->CartComm, &sendRequest[dir][faceRight]));
+    MPI_SAFE_CALL(MPI_Recv_init(recvBuffer[dir][faceLeft].compactData(), size, MPI_FLOAT,
+                  procRecv, tag, mygrid->CartComm, &recvRequest[dir][faceLeft]));
+
+    // Send to the left
+    MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,dir,-1,&procRecv,&procSend ));
+    MPI_SAFE_CALL(MPI_Send_init(sendBuffer[dir][faceLeft].compactData(), size, MPI_FLOAT,
+                  procSend, tag+1, mygrid->CartComm, &sendRequest[dir][faceLeft]));
+    MPI_SAFE_CALL(MPI_Recv_init(recvBuffer[dir][faceRight].compactData(), size, MPI_FLOAT,
+                  procRecv, tag+1, mygrid->CartComm, &recvRequest[dir][faceRight]));
+  }
+  haveCompactRequests = true;
+  idfx::popRegion();
+}
+
+int64_t Mpi::MessageBytes(int bufferSize) {
+  if(haloPrecision == HaloPrecision::Full) return(bufferSize*sizeof(real));
+  return((bufferSize+1)*sizeof(float));
+}
+
 // Destructor (clean up persistent communication channels)
 Mpi::~Mpi() {
   idfx::pushRegion("Mpi::~Mpi");
@@ -231,6 +739,39 @@ Mpi::~Mpi() {
       #endif
       }
     #endif
+    if(haveSharedHalos) {
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        WaitSharedReads(dir);
+        for(int i=0 ; i< 2; i++) {
+          MPI_Request_free( &readySendRequest[dir][i]);
+          MPI_Request_free( &readyRecvRequest[dir][i]);
+          MPI_Request_free( &doneSendRequest[dir][i]);
+          MPI_Request_free( &doneRecvRequest[dir][i]);
+        }
+      }
+      MPI_Win_unlock_all(sharedWindow);
+      MPI_Win_free(&sharedWindow);
+      MPI_Comm_free(&nodeComm);
+    }
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      for(auto &exchange : datatypeExchanges[dir]) {
+        FreeDatatypeExchange(exchange);
+      }
+    }
+    if(haveCompactRequests) {
+      for(int i=0 ; i< 2; i++) {
+        MPI_Request_free( &sendCompactRequestX1[i]);
+        MPI_Request_free( &recvCompactRequestX1[i]);
+      #if DIMENSIONS >= 2
+        MPI_Request_free( &sendCompactRequestX2[i]);
+        MPI_Request_free( &recvCompactRequestX2[i]);
+      #endif
+      #if DIMENSIONS == 3
+        MPI_Request_free( &sendCompactRequestX3[i]);
+        MPI_Request_free( &recvCompactRequestX3[i]);
+      #endif
+      }
+    }
     if(thisInstance==1) {
       idfx::cout << "Mpi(" << thisInstance << "): measured throughput is "
                 << bytesSentOrReceived/myTimer/1024.0/1024.0 << " MB/s" << std::endl;
@@ -239,6 +780,11 @@ Mpi::~Mpi() {
       idfx::cout << "        X2: " << bufferSizeX2*sizeof(real)/1024.0/1024.0 << " MB" << std::endl;
       idfx::cout << "        X3: " << bufferSizeX3*sizeof(real)/1024.0/1024.0 << " MB" << std::endl;
     }
+    if(bytesSaved > 0) {
+      idfx::cout << "Mpi(" << thisInstance << "): reduced precision halos saved "
+                 << bytesSaved/1024.0/1024.0 << " MB of "
+                 << (bytesSentOrReceived+bytesSaved)/1024.0/1024.0 << " MB" << std::endl;
+    }
     isInitialized = false;
   }
   idfx::popRegion();
@@ -247,11 +793,26 @@ Mpi::~Mpi() {
 void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   idfx::pushRegion("Mpi::ExchangeX1");
 
+  if(haveDatatypeHalos && haloPrecision == HaloPrecision::Full) {
+    ExchangeDatatypes(IDIR, Vc, Vs);
+    idfx::popRegion();
+    return;
+  }
+  if(haveSharedHalos) {
+    if(haloPrecision == HaloPrecision::Full) {
+      ExchangeShared(IDIR, Vc, Vs);
+      idfx::popRegion();
+      return;
+    }
+    // Reduced precision halos are sent as messages, from the same send buffers
+    WaitSharedReads(IDIR);
+  }
+
   // Load  the buffers with data
-  int ibeg,iend,jbeg,jend,kbeg,kend,offset,nx;
   Buffer BufferLeft = BufferSendX1[faceLeft];
   Buffer BufferRight = BufferSendX1[faceRight];
-  IdefixArray1D<int> map = this->mapVars;
+  const bool compact = (haloPrecision != HaloPrecision::Full);
+  const bool scaled = (haloPrecision == HaloPrecision::ScaledFloat);
 
   // If MPI Persistent, start receiving even before the buffers are filled
   myTimer -= MPI_Wtime();
@@ -260,67 +821,20 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   MPI_Status sendStatus[2];
   MPI_Status recvStatus[2];
 
-  MPI_SAFE_CALL(MPI_Startall(2, recvRequestX1));
+  MPI_Request *sendReq = compact ? sendCompactRequestX1 : sendRequestX1;
+  MPI_Request *recvReq = compact ? recvCompactRequestX1 : recvRequestX1;
+
+  MPI_SAFE_CALL(MPI_Startall(2, recvReq));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
   myTimer += MPI_Wtime();
 
-  // Coordinates of the ghost region which needs to be transfered
-  ibeg   = 0;
-  iend   = nghost[IDIR];
-  nx     = nghost[IDIR];  // Number of points in x
-  offset = end[IDIR];     // Distance between beginning of left and right ghosts
-  jbeg   = beg[JDIR];
-  jend   = end[JDIR];
-
-  kbeg   = beg[KDIR];
-  kend   = end[KDIR];
-
-
-  BufferLeft.ResetPointer();
-  BufferRight.ResetPointer();
-
-  BufferLeft.Pack(Vc, map, std::make_pair(ibeg+nx, iend+nx),
-                           std::make_pair(jbeg   , jend),
-                           std::make_pair(kbeg   , kend));
-
-  BufferRight.Pack(Vc, map, std::make_pair(ibeg+offset-nx, iend+offset-nx),
-                            std::make_pair(jbeg   , jend),
-                            std::make_pair(kbeg   , kend));
-
-  // Load face-centered field in the buffer
-  if(haveVs) {
-    BufferLeft.Pack(Vs, BX1s,std::make_pair(ibeg+nx+1, iend+nx+1),
-                             std::make_pair(jbeg   , jend),
-                             std::make_pair(kbeg   , kend));
-
-    BufferRight.Pack(Vs, BX1s, std::make_pair(ibeg+offset-nx, iend+offset-nx),
-                               std::make_pair(jbeg   , jend),
-                               std::make_pair(kbeg   , kend));
-
-    #if DIMENSIONS >= 2
-
-    BufferLeft.Pack(Vs, BX2s,std::make_pair(ibeg+nx, iend+nx),
-                             std::make_pair(jbeg   , jend+1),
-                             std::make_pair(kbeg   , kend));
+  PackHalos(IDIR, Vc, Vs);
 
-    BufferRight.Pack(Vs, BX2s, std::make_pair(ibeg+offset-nx, iend+offset-nx),
-                               std::make_pair(jbeg   , jend+1),
-                               std::make_pair(kbeg   , kend));
-
-    #endif
-
-    #if DIMENSIONS == 3
-
-    BufferLeft.Pack(Vs, BX3s,std::make_pair(ibeg+nx, iend+nx),
-                             std::make_pair(jbeg   , jend),
-                             std::make_pair(kbeg   , kend+1));
-
-    BufferRight.Pack(Vs, BX3s, std::make_pair(ibeg+offset-nx, iend+offset-nx),
-                               std::make_pair(jbeg   , jend),
-                               std::make_pair(kbeg   , kend+1));
-
-    #endif
+  // Convert to reduced precision messages
+  if(compact) {
+    BufferLeft.Compress(scaled);
+    BufferRight.Compress(scaled);
   }
 
   // Wait for completion before sending out everything
@@ -328,9 +842,9 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   myTimer -= MPI_Wtime();
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_SAFE_CALL(MPI_Startall(2, sendRequestX1));
+  MPI_SAFE_CALL(MPI_Startall(2, sendReq));
   // Wait for buffers to be received
-  MPI_Waitall(2,recvRequestX1,recvStatus);
+  MPI_Waitall(2, recvReq, recvStatus);
 
 #else
   int procSend, procRecv;
@@ -388,48 +902,13 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   BufferLeft=BufferRecvX1[faceLeft];
   BufferRight=BufferRecvX1[faceRight];
 
-  BufferLeft.ResetPointer();
-  BufferRight.ResetPointer();
-
-  BufferLeft.Unpack(Vc, map,std::make_pair(ibeg, iend),
-                            std::make_pair(jbeg   , jend),
-                            std::make_pair(kbeg   , kend));
-
-  BufferRight.Unpack(Vc, map,std::make_pair(ibeg+offset, iend+offset),
-                             std::make_pair(jbeg   , jend),
-                             std::make_pair(kbeg   , kend));
-  // We fill the ghost zones
-
-  if(haveVs) {
-    BufferLeft.Unpack(Vs, BX1s, std::make_pair(ibeg, iend),
-                                std::make_pair(jbeg   , jend),
-                                std::make_pair(kbeg   , kend));
-
-    BufferRight.Unpack(Vs, BX1s, std::make_pair(ibeg+offset+1, iend+offset+1),
-                                std::make_pair(jbeg   , jend),
-                                std::make_pair(kbeg   , kend));
-
-    #if DIMENSIONS >= 2
-    BufferLeft.Unpack(Vs, BX2s, std::make_pair(ibeg, iend),
-                                std::make_pair(jbeg   , jend+1),
-                                std::make_pair(kbeg   , kend));
-
-    BufferRight.Unpack(Vs, BX2s, std::make_pair(ibeg+offset, iend+offset),
-                                std::make_pair(jbeg   , jend+1),
-                                std::make_pair(kbeg   , kend));
-    #endif
-
-    #if DIMENSIONS == 3
-    BufferLeft.Unpack(Vs, BX3s, std::make_pair(ibeg, iend),
-                                std::make_pair(jbeg   , jend),
-                                std::make_pair(kbeg   , kend+1));
-
-    BufferRight.Unpack(Vs, BX3s, std::make_pair(ibeg+offset, iend+offset),
-                                std::make_pair(jbeg   , jend),
-                                std::make_pair(kbeg   , kend+1));
-    #endif
+  if(compact) {
+    BufferLeft.Expand(scaled);
+    BufferRight.Expand(scaled);
   }
 
+  UnpackHalos(IDIR, Vc, Vs);
+
 myTimer -= MPI_Wtime();
 #ifdef MPI_NON_BLOCKING
   // Wait for the sends if they have not yet completed
@@ -437,10 +916,11 @@ myTimer -= MPI_Wtime();
 #endif
 
 #ifdef MPI_PERSISTENT
-  MPI_Waitall(2, sendRequestX1, sendStatus);
+  MPI_Waitall(2, sendReq, sendStatus);
 #endif
   myTimer += MPI_Wtime();
-  bytesSentOrReceived += 4*bufferSizeX1*sizeof(real);
+  bytesSentOrReceived += 4*MessageBytes(bufferSizeX1);
+  bytesSaved += 4*(bufferSizeX1*sizeof(real) - MessageBytes(bufferSizeX1));
 
   idfx::popRegion();
 }
@@ -449,11 +929,26 @@ myTimer -= MPI_Wtime();
 void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   idfx::pushRegion("Mpi::ExchangeX2");
 
+  if(haveDatatypeHalos && haloPrecision == HaloPrecision::Full) {
+    ExchangeDatatypes(JDIR, Vc, Vs);
+    idfx::popRegion();
+    return;
+  }
+  if(haveSharedHalos) {
+    if(haloPrecision == HaloPrecision::Full) {
+      ExchangeShared(JDIR, Vc, Vs);
+      idfx::popRegion();
+      return;
+    }
+    // Reduced precision halos are sent as messages, from the same send buffers
+    WaitSharedReads(JDIR);
+  }
+
   // Load  the buffers with data
-  int ibeg,iend,jbeg,jend,kbeg,kend,offset,ny;
   Buffer BufferLeft=BufferSendX2[faceLeft];
   Buffer BufferRight=BufferSendX2[faceRight];
-  IdefixArray1D<int> map = this->mapVars;
+  const bool compact = (haloPrecision != HaloPrecision::Full);
+  const bool scaled = (haloPrecision == HaloPrecision::ScaledFloat);
 
 // If MPI Persistent, start receiving even before the buffers are filled
   myTimer -= MPI_Wtime();
@@ -462,63 +957,20 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   MPI_Status sendStatus[2];
   MPI_Status recvStatus[2];
 
-  MPI_SAFE_CALL(MPI_Startall(2, recvRequestX2));
+  MPI_Request *sendReq = compact ? sendCompactRequestX2 : sendRequestX2;
+  MPI_Request *recvReq = compact ? recvCompactRequestX2 : recvRequestX2;
+
+  MPI_SAFE_CALL(MPI_Startall(2, recvReq));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
   myTimer += MPI_Wtime();
 
-  // Coordinates of the ghost region which needs to be transfered
-  ibeg   = 0;
-  iend   = ntot[IDIR];
-
-  jbeg   = 0;
-  jend   = nghost[JDIR];
-  offset = end[JDIR];     // Distance between beginning of left and right ghosts
-  ny     = nghost[JDIR];
-
-  kbeg   = beg[KDIR];
-  kend   = end[KDIR];
-
-  BufferLeft.ResetPointer();
-  BufferRight.ResetPointer();
-
-  BufferLeft.Pack(Vc, map, std::make_pair(ibeg    , iend),
-                           std::make_pair(jbeg+ny , jend+ny),
-                           std::make_pair(kbeg    , kend));
-
-  BufferRight.Pack(Vc, map, std::make_pair(ibeg           , iend),
-                            std::make_pair(jbeg+offset-ny , jend+offset-ny),
-                            std::make_pair(kbeg           , kend));
-
-  // Load face-centered field in the buffer
-  if(haveVs) {
-    BufferLeft.Pack(Vs, BX1s,std::make_pair(ibeg , iend+1),
-                          std::make_pair(jbeg+ny , jend+ny),
-                          std::make_pair(kbeg    , kend));
-
-    BufferRight.Pack(Vs, BX1s, std::make_pair(ibeg        , iend+1),
-                            std::make_pair(jbeg+offset-ny , jend+offset-ny),
-                            std::make_pair(kbeg           , kend));
-    #if DIMENSIONS >= 2
-    BufferLeft.Pack(Vs, BX2s,std::make_pair(ibeg , iend),
-                             std::make_pair(jbeg+ny+1 , jend+ny+1),
-                             std::make_pair(kbeg    , kend));
-
-    BufferRight.Pack(Vs, BX2s, std::make_pair(ibeg        , iend),
-                            std::make_pair(jbeg+offset-ny , jend+offset-ny),
-                            std::make_pair(kbeg           , kend));
-    #endif
-    #if DIMENSIONS == 3
-
-    BufferLeft.Pack(Vs, BX3s,std::make_pair(ibeg , iend),
-                          std::make_pair(jbeg+ny , jend+ny),
-                          std::make_pair(kbeg    , kend+1));
+  PackHalos(JDIR, Vc, Vs);
 
-    BufferRight.Pack(Vs, BX3s, std::make_pair(ibeg        , iend),
-                            std::make_pair(jbeg+offset-ny , jend+offset-ny),
-                            std::make_pair(kbeg           , kend+1));
-
-    #endif
+  // Convert to reduced precision messages
+  if(compact) {
+    BufferLeft.Compress(scaled);
+    BufferRight.Compress(scaled);
   }
 
   // Send to the right
@@ -527,8 +979,8 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   myTimer -= MPI_Wtime();
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_SAFE_CALL(MPI_Startall(2, sendRequestX2));
-  MPI_Waitall(2,recvRequestX2,recvStatus);
+  MPI_SAFE_CALL(MPI_Startall(2, sendReq));
+  MPI_Waitall(2, recvReq, recvStatus);
 
 #else
   int procSend, procRecv;
@@ -586,47 +1038,13 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   BufferLeft=BufferRecvX2[faceLeft];
   BufferRight=BufferRecvX2[faceRight];
 
-  BufferLeft.ResetPointer();
-  BufferRight.ResetPointer();
-
-  // We fill the ghost zones
-  BufferLeft.Unpack(Vc, map,std::make_pair(ibeg, iend),
-                            std::make_pair(jbeg   , jend),
-                            std::make_pair(kbeg   , kend));
-
-  BufferRight.Unpack(Vc, map,std::make_pair(ibeg        , iend),
-                             std::make_pair(jbeg+offset , jend+offset),
-                             std::make_pair(kbeg        , kend));
-  // We fill the ghost zones
-
-  if(haveVs) {
-    BufferLeft.Unpack(Vs, BX1s, std::make_pair(ibeg, iend+1),
-                                std::make_pair(jbeg   , jend),
-                                std::make_pair(kbeg   , kend));
-
-    BufferRight.Unpack(Vs, BX1s, std::make_pair(ibeg, iend+1),
-                                std::make_pair(jbeg+offset   , jend+offset),
-                                std::make_pair(kbeg   , kend));
-    #if DIMENSIONS >= 2
-    BufferLeft.Unpack(Vs, BX2s, std::make_pair(ibeg, iend),
-                                std::make_pair(jbeg   , jend),
-                                std::make_pair(kbeg   , kend));
-
-    BufferRight.Unpack(Vs, BX2s, std::make_pair(ibeg, iend),
-                                std::make_pair(jbeg+offset+1, jend+offset+1),
-                                std::make_pair(kbeg   , kend));
-    #endif
-    #if DIMENSIONS == 3
-    BufferLeft.Unpack(Vs, BX3s, std::make_pair(ibeg, iend),
-                                std::make_pair(jbeg, jend),
-                                std::make_pair(kbeg, kend+1));
-
-    BufferRight.Unpack(Vs, BX3s,std::make_pair(ibeg      , iend),
-                                std::make_pair(jbeg+offset, jend+offset),
-                                std::make_pair(kbeg       , kend+1));
-    #endif
+  if(compact) {
+    BufferLeft.Expand(scaled);
+    BufferRight.Expand(scaled);
   }
 
+  UnpackHalos(JDIR, Vc, Vs);
+
   myTimer -= MPI_Wtime();
 #ifdef MPI_NON_BLOCKING
   // Wait for the sends if they have not yet completed
@@ -634,10 +1052,11 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
 
 #ifdef MPI_PERSISTENT
-  MPI_Waitall(2, sendRequestX2, sendStatus);
+  MPI_Waitall(2, sendReq, sendStatus);
 #endif
   myTimer += MPI_Wtime();
-  bytesSentOrReceived += 4*bufferSizeX2*sizeof(real);
+  bytesSentOrReceived += 4*MessageBytes(bufferSizeX2);
+  bytesSaved += 4*(bufferSizeX2*sizeof(real) - MessageBytes(bufferSizeX2));
 
   idfx::popRegion();
 }
@@ -646,12 +1065,27 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   idfx::pushRegion("Mpi::ExchangeX3");
 
+  if(haveDatatypeHalos && haloPrecision == HaloPrecision::Full) {
+    ExchangeDatatypes(KDIR, Vc, Vs);
+    idfx::popRegion();
+    return;
+  }
+  if(haveSharedHalos) {
+    if(haloPrecision == HaloPrecision::Full) {
+      ExchangeShared(KDIR, Vc, Vs);
+      idfx::popRegion();
+      return;
+    }
+    // Reduced precision halos are sent as messages, from the same send buffers
+    WaitSharedReads(KDIR);
+  }
+
 
   // Load  the buffers with data
-  int ibeg,iend,jbeg,jend,kbeg,kend,offset,nz;
   Buffer BufferLeft=BufferSendX3[faceLeft];
   Buffer BufferRight=BufferSendX3[faceRight];
-  IdefixArray1D<int> map = this->mapVars;
+  const bool compact = (haloPrecision != HaloPrecision::Full);
+  const bool scaled = (haloPrecision == HaloPrecision::ScaledFloat);
 
   // If MPI Persistent, start receiving even before the buffers are filled
   myTimer -= MPI_Wtime();
@@ -661,64 +1095,19 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   MPI_Status sendStatus[2];
   MPI_Status recvStatus[2];
 
-  MPI_SAFE_CALL(MPI_Startall(2, recvRequestX3));
+  MPI_Request *sendReq = compact ? sendCompactRequestX3 : sendRequestX3;
+  MPI_Request *recvReq = compact ? recvCompactRequestX3 : recvRequestX3;
+
+  MPI_SAFE_CALL(MPI_Startall(2, recvReq));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
   myTimer += MPI_Wtime();
-  // Coordinates of the ghost region which needs to be transfered
-  ibeg   = 0;
-  iend   = ntot[IDIR];
-
-  jbeg   = 0;
-  jend   = ntot[JDIR];
-
-  kbeg   = 0;
-  kend   = nghost[KDIR];
-  offset = end[KDIR];     // Distance between beginning of left and right ghosts
-  nz     = nghost[KDIR];
-
-  BufferLeft.ResetPointer();
-  BufferRight.ResetPointer();
-
-  BufferLeft.Pack(Vc, map, std::make_pair(ibeg   , iend),
-                           std::make_pair(jbeg   , jend),
-                           std::make_pair(kbeg+nz, kend+nz));
-
-  BufferRight.Pack(Vc, map, std::make_pair(ibeg            , iend),
-                            std::make_pair(jbeg            , jend),
-                            std::make_pair(kbeg + offset-nz, kend+ offset-nz));
+  PackHalos(KDIR, Vc, Vs);
 
-  // Load face-centered field in the buffer
-  if(haveVs) {
-    BufferLeft.Pack(Vs, BX1s,std::make_pair(ibeg , iend+1),
-                             std::make_pair(jbeg    , jend),
-                             std::make_pair(kbeg+nz , kend+nz));
-
-    BufferRight.Pack(Vs, BX1s, std::make_pair(ibeg            , iend+1),
-                               std::make_pair(jbeg            , jend),
-                               std::make_pair(kbeg + offset-nz, kend+ offset-nz));
-
-    #if DIMENSIONS >= 2
-
-    BufferLeft.Pack(Vs, BX2s,std::make_pair(ibeg    , iend),
-                             std::make_pair(jbeg    , jend+1),
-                             std::make_pair(kbeg+nz , kend+nz));
-
-    BufferRight.Pack(Vs, BX2s, std::make_pair(ibeg            , iend),
-                               std::make_pair(jbeg            , jend+1),
-                               std::make_pair(kbeg + offset-nz, kend+ offset-nz));
-
-    #endif
-
-    #if DIMENSIONS == 3
-    BufferLeft.Pack(Vs, BX3s,std::make_pair(ibeg    , iend),
-                             std::make_pair(jbeg    , jend),
-                             std::make_pair(kbeg+nz+1 , kend+nz+1));
-
-    BufferRight.Pack(Vs, BX3s, std::make_pair(ibeg            , iend),
-                               std::make_pair(jbeg            , jend),
-                               std::make_pair(kbeg + offset-nz, kend+ offset-nz));
-    #endif
+  // Convert to reduced precision messages
+  if(compact) {
+    BufferLeft.Compress(scaled);
+    BufferRight.Compress(scaled);
   }
 
   // Send to the right
@@ -727,8 +1116,8 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   myTimer -= MPI_Wtime();
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_SAFE_CALL(MPI_Startall(2, sendRequestX3));
-  MPI_Waitall(2,recvRequestX3,recvStatus);
+  MPI_SAFE_CALL(MPI_Startall(2, sendReq));
+  MPI_Waitall(2, recvReq, recvStatus);
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 
 #else
@@ -786,50 +1175,13 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   BufferLeft=BufferRecvX3[faceLeft];
   BufferRight=BufferRecvX3[faceRight];
 
-  BufferLeft.ResetPointer();
-  BufferRight.ResetPointer();
-
-
-  // We fill the ghost zones
-  BufferLeft.Unpack(Vc, map,std::make_pair(ibeg, iend),
-                            std::make_pair(jbeg   , jend),
-                            std::make_pair(kbeg   , kend));
-
-  BufferRight.Unpack(Vc, map,std::make_pair(ibeg        , iend),
-                             std::make_pair(jbeg        , jend),
-                             std::make_pair(kbeg+offset , kend+offset));
-  // We fill the ghost zones
-
-  if(haveVs) {
-    BufferLeft.Unpack(Vs, BX1s, std::make_pair(ibeg, iend+1),
-                                std::make_pair(jbeg   , jend),
-                                std::make_pair(kbeg   , kend));
-
-    BufferRight.Unpack(Vs, BX1s, std::make_pair(ibeg, iend+1),
-                                std::make_pair(jbeg          , jend),
-                                std::make_pair(kbeg+offset   , kend+offset));
-
-    #if DIMENSIONS >=2
-    BufferLeft.Unpack(Vs, BX2s, std::make_pair(ibeg, iend),
-                                std::make_pair(jbeg, jend+1),
-                                std::make_pair(kbeg, kend));
-
-    BufferRight.Unpack(Vs, BX2s,std::make_pair(ibeg       , iend),
-                                std::make_pair(jbeg       , jend+1),
-                                std::make_pair(kbeg+offset, kend+offset));
-    #endif
-
-    #if DIMENSIONS == 3
-    BufferLeft.Unpack(Vs, BX3s, std::make_pair(ibeg, iend),
-                                std::make_pair(jbeg, jend),
-                                std::make_pair(kbeg, kend));
-
-    BufferRight.Unpack(Vs, BX3s,std::make_pair(ibeg       , iend),
-                                std::make_pair(jbeg       , jend),
-                                std::make_pair(kbeg+offset+1, kend+offset+1));
-    #endif
+  if(compact) {
+    BufferLeft.Expand(scaled);
+    BufferRight.Expand(scaled);
   }
 
+  UnpackHalos(KDIR, Vc, Vs);
+
   myTimer -= MPI_Wtime();
 #ifdef MPI_NON_BLOCKING
   // Wait for the sends if they have not yet completed
@@ -837,10 +1189,11 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
 
 #ifdef MPI_PERSISTENT
-  MPI_Waitall(2, sendRequestX3, sendStatus);
+  MPI_Waitall(2, sendReq, sendStatus);
 #endif
   myTimer += MPI_Wtime();
-  bytesSentOrReceived += 4*bufferSizeX3*sizeof(real);
+  bytesSentOrReceived += 4*MessageBytes(bufferSizeX3);
+  bytesSaved += 4*(bufferSizeX3*sizeof(real) - MessageBytes(bufferSizeX3));
 
   idfx::popRegion();
 }
@@ -9,6 +9,7 @@
 #define MPI_HPP_
 
 #include <signal.h>
+#include <cmath>
 #include <vector>
 #include <utility>
 #include "idefix.hpp"
@@ -16,10 +17,24 @@
 
 
 class DataBlock;
+
+// Part of the halos of a direction, stored contiguously in the messages (i first, then j and k).
+// The cell-centered variables and each face-centered field component are separate segments.
+struct HaloSegment {
+  int faceCentered;       // Whether the segment is read from the face-centered array
+  int var;                // Variable of the array
+  int offset;             // Start of the segment in the messages
+  int n[3];               // Number of cells in each direction
+  int send[2][3];         // First cell sent to the right and left neighbours
+  int recv[2][3];         // First cell of the ghost zones received on the right and left
+};
+
 class Buffer {
  public:
   Buffer() = default;
-  explicit Buffer(size_t size): pointer{0}, array{IdefixArray1D<real>("BufferArray",size)} { };
+  explicit Buffer(size_t size): array{IdefixArray1D<real>("BufferArray",size)} { };
+  // Buffer in memory allocated elsewhere (e.g. an MPI shared memory window)
+  Buffer(real *memory, size_t size): array{IdefixArray1D<real>(memory,size)} { };
 
   void* data() {
     return(array.data());
@@ -29,156 +44,67 @@ class Buffer {
     return(array.size());
   }
 
-  void ResetPointer() {
-    this->pointer = 0;
+  IdefixArray1D<real> GetArray() {
+    return(array);
   }
 
-  void Pack(IdefixArray3D<real>& in,
-       std::pair<int,int> ib,
-       std::pair<int,int> jb,
-       std::pair<int,int> kb) {
-    const int ni = ib.second-ib.first;
-    const int ninj = (jb.second-jb.first)*ni;
-    const int ninjnk = (kb.second-kb.first)*ninj;
-    const int ibeg = ib.first;
-    const int jbeg = jb.first;
-    const int kbeg = kb.first;
-    const int offset = this->pointer;
-
-    auto arr = this->array;
-    idefix_for("LoadBuffer3D",kb.first,kb.second,jb.first,jb.second,ib.first,ib.second,
-      KOKKOS_LAMBDA (int k, int j, int i) {
-      arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + offset ) = in(k,j,i);
-    });
-
-    // Update pointer
-    this->pointer += ninjnk;
+  // Reduced precision copy of the buffer, used as the MPI message in compact exchanges
+  void* compactData() {
+    return(compact.data());
   }
 
-  void Pack(IdefixArray4D<real>& in,
-       const int var,
-       std::pair<int,int> ib,
-       std::pair<int,int> jb,
-       std::pair<int,int> kb) {
-    const int ni = ib.second-ib.first;
-    const int ninj = (jb.second-jb.first)*ni;
-    const int ninjnk = (kb.second-kb.first)*ninj;
-    const int ibeg = ib.first;
-    const int jbeg = jb.first;
-    const int kbeg = kb.first;
-    const int offset = this->pointer;
-
-    auto arr = this->array;
-    idefix_for("LoadBuffer4D",kb.first,kb.second,jb.first,jb.second,ib.first,ib.second,
-      KOKKOS_LAMBDA (int k, int j, int i) {
-      arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + offset ) = in(var, k,j,i);
-    });
-
-    // Update pointer
-    this->pointer += ninjnk;
+  int CompactSize() {
+    return(compact.size());
   }
 
-  void Pack(IdefixArray4D<real>& in,
-       IdefixArray1D<int>& map,
-       std::pair<int,int> ib,
-       std::pair<int,int> jb,
-       std::pair<int,int> kb) {
-    const int ni = ib.second-ib.first;
-    const int ninj = (jb.second-jb.first)*ni;
-    const int ninjnk = (kb.second-kb.first)*ninj;
-    const int ibeg = ib.first;
-    const int jbeg = jb.first;
-    const int kbeg = kb.first;
-    const int offset = this->pointer;
-    auto arr = this->array;
-
-    idefix_for("LoadBuffer4D",0,map.size(),
-                             kb.first,kb.second,
-                             jb.first,jb.second,
-                             ib.first,ib.second,
-      KOKKOS_LAMBDA (int n, int k, int j, int i) {
-      arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + n*ninjnk + offset ) = in(map(n), k,j,i);
-    });
-
-    // Update pointer
-    this->pointer += ninjnk*map.size();
+  void AllocateCompact() {
+    // One extra element carries the scaling exponent of the message
+    if(compact.size() == 0) compact = IdefixArray1D<float>("BufferCompact",array.size()+1);
   }
 
-  void Unpack(IdefixArray3D<real>& out,
-       std::pair<int,int> ib,
-       std::pair<int,int> jb,
-       std::pair<int,int> kb) {
-    const int ni = ib.second-ib.first;
-    const int ninj = (jb.second-jb.first)*ni;
-    const int ninjnk = (kb.second-kb.first)*ninj;
-    const int ibeg = ib.first;
-    const int jbeg = jb.first;
-    const int kbeg = kb.first;
-    const int offset = this->pointer;
+  // Round the packed values to float, optionally scaled by 2^-e where 2^e bounds the message
+  void Compress(const bool scaled) {
+    const int n = array.size();
     auto arr = this->array;
-
-    idefix_for("LoadBuffer3D",kb.first,kb.second,jb.first,jb.second,ib.first,ib.second,
-      KOKKOS_LAMBDA (int k, int j, int i) {
-        out(k,j,i) = arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + offset );
-    });
-
-    // Update pointer
-    this->pointer += ninjnk;
-  }
-
-  void Unpack(IdefixArray4D<real>& out,
-       const int var,
-       std::pair<int,int> ib,
-       std::pair<int,int> jb,
-       std::pair<int,int> kb) {
-    const int ni = ib.second-ib.first;
-    const int ninj = (jb.second-jb.first)*ni;
-    const int ninjnk = (kb.second-kb.first)*ninj;
-    const int ibeg = ib.first;
-    const int jbeg = jb.first;
-    const int kbeg = kb.first;
-    const int offset = this->pointer;
-
-    auto arr = this->array;
-    idefix_for("LoadBuffer3D",kb.first,kb.second,jb.first,jb.second,ib.first,ib.second,
-      KOKKOS_LAMBDA (int k, int j, int i) {
-        out(var,k,j,i) = arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + offset );
+    auto cmp = this->compact;
+    int expo = 0;
+    if(scaled) {
+      real maxAbs = 0;
+      idefix_reduce("BufferMaxAbs", 0, n,
+        KOKKOS_LAMBDA (int i, real &localMax) {
+          localMax = FMAX(FABS(arr(i)), localMax);
+        },
+        Kokkos::Max<real>(maxAbs));
+      if(maxAbs > 0) expo = std::ilogb(maxAbs);
+    }
+    const real scale = std::ldexp(1.0, -expo);
+    idefix_for("CompressBuffer", 0, n,
+      KOKKOS_LAMBDA (int i) {
+        cmp(i) = static_cast<float>(scale*arr(i));
     });
-
-    // Update pointer
-    this->pointer += ninjnk;
+    Kokkos::deep_copy(Kokkos::subview(cmp, n), static_cast<float>(expo));
   }
 
-  void Unpack(IdefixArray4D<real>& out,
-       IdefixArray1D<int>& map,
-       std::pair<int,int> ib,
-       std::pair<int,int> jb,
-       std::pair<int,int> kb) {
-    const int ni = ib.second-ib.first;
-    const int ninj = (jb.second-jb.first)*ni;
-    const int ninjnk = (kb.second-kb.first)*ninj;
-    const int ibeg = ib.first;
-    const int jbeg = jb.first;
-    const int kbeg = kb.first;
-    const int offset = this->pointer;
-
+  // Convert a received compact message back to real values
+  void Expand(const bool scaled) {
+    const int n = array.size();
     auto arr = this->array;
-    idefix_for("LoadBuffer4D",0,map.size(),
-                              kb.first,kb.second,
-                              jb.first,jb.second,
-                              ib.first,ib.second,
-      KOKKOS_LAMBDA (int n, int k, int j, int i) {
-        out(map(n),k,j,i) = arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + n*ninjnk + offset );
+    auto cmp = this->compact;
+    real scale = 1.0;
+    if(scaled) {
+      float expo;
+      Kokkos::deep_copy(expo, Kokkos::subview(cmp, n));
+      scale = std::ldexp(1.0, static_cast<int>(expo));
+    }
+    idefix_for("ExpandBuffer", 0, n,
+      KOKKOS_LAMBDA (int i) {
+        arr(i) = scale*static_cast<real>(cmp(i));
     });
-
-    // Update pointer
-    this->pointer += ninjnk*map.size();
   }
 
-
  private:
-  size_t pointer;
   IdefixArray1D<real> array;
+  IdefixArray1D<float> compact;
 };
 
 class Mpi {
@@ -206,6 +132,9 @@ class Mpi {
   // Check that MPI processes are synced
   static bool CheckSync(real);
 
+  // Select the precision of the messages sent by the next exchanges
+  void SetHaloPrecision(HaloPrecision);
+
 
   // Destructor
   ~Mpi();
@@ -236,6 +165,52 @@ class Mpi {
   IdefixArray1D<int>  mapVars;
   int mapNVars{0};
 
+  // Halo segments of each direction, packed and unpacked by a single kernel per direction
+  IdefixArray1D<HaloSegment> haloSegments[3];
+  std::vector<HaloSegment> haloSegmentsHost[3];
+  int nHaloSegments[3]{0, 0, 0};
+  void InitHaloSegments(int, int);
+  void PackHalos(int, IdefixArray4D<real> &, IdefixArray4D<real> &);
+  void UnpackHalos(int, IdefixArray4D<real> &, IdefixArray4D<real> &, Buffer * = nullptr);
+
+  // In place exchanges on host backends: the halos are described by MPI derived datatypes, and
+  // sent from and received in the arrays themselves by persistent requests. The datatypes depend
+  // on the addresses of the arrays, so they are built on the first exchange of each pair of arrays
+  // and the most recently used ones are kept.
+  struct DatatypeExchange {
+    void *vcData;
+    void *vsData;
+    int nvar;
+    MPI_Datatype sendType[2];
+    MPI_Datatype recvType[2];
+    MPI_Request sendRequest[2];
+    MPI_Request recvRequest[2];
+  };
+  bool haveDatatypeHalos{false};
+  std::vector<DatatypeExchange> datatypeExchanges[3];
+  static constexpr size_t maxDatatypeExchanges{8};   // per direction
+  DatatypeExchange& GetDatatypeExchange(int, IdefixArray4D<real> &, IdefixArray4D<real> &);
+  void FreeDatatypeExchange(DatatypeExchange &);
+  MPI_Datatype MakeHaloDatatype(int, int, bool, IdefixArray4D<real> &, IdefixArray4D<real> &);
+  void ExchangeDatatypes(int, IdefixArray4D<real> &, IdefixArray4D<real> &);
+
+  // Intra-node exchanges: the send buffers are allocated in an MPI-3 shared memory window, and
+  // the neighbours on the same node unpack them in place. Empty messages tell when a buffer is
+  // ready to be read, and when it has been read. The other neighbours still receive messages.
+  bool haveSharedHalos{false};
+  bool sharedSide[3][2]{{false, false}, {false, false}, {false, false}};
+  bool sharedStarted[3]{false, false, false};
+  Buffer peerBuffer[3][2];            // Send buffers of the neighbours on the same node
+  MPI_Comm nodeComm;
+  MPI_Win sharedWindow;
+  MPI_Request readySendRequest[3][2];
+  MPI_Request readyRecvRequest[3][2];
+  MPI_Request doneSendRequest[3][2];
+  MPI_Request doneRecvRequest[3][2];
+  void InitSharedHalos();
+  void WaitSharedReads(int);
+  void ExchangeShared(int, IdefixArray4D<real> &, IdefixArray4D<real> &);
+
   int nint[3];            //< number of internal elements of the arrays we treat
   int nghost[3];          //< number of ghost zone of the arrays we treat
   int ntot[3];            //< total number of cells of the arrays we treat
@@ -256,11 +231,24 @@ class Mpi {
   MPI_Request recvRequestX2[2];
   MPI_Request recvRequestX3[2];
 
+  // Reduced precision halos
+  HaloPrecision haloPrecision{HaloPrecision::Full};
+  bool haveCompactRequests{false};
+  MPI_Request sendCompactRequestX1[2];
+  MPI_Request sendCompactRequestX2[2];
+  MPI_Request sendCompactRequestX3[2];
+  MPI_Request recvCompactRequestX1[2];
+  MPI_Request recvCompactRequestX2[2];
+  MPI_Request recvCompactRequestX3[2];
+  void InitCompactRequests();
+  int64_t MessageBytes(int);   // Bytes effectively sent for a message of a given buffer size
+
   Grid *mygrid;
 
   // MPI throughput timer specific to this object
   double myTimer{0};
   int64_t bytesSentOrReceived{0};
+  int64_t bytesSaved{0};      // Bytes not sent thanks to reduced precision halos
 
   // Error handler used by CheckConfig
   static void SigErrorHandler(int, siginfo_t* , void* );
@@ -0,0 +1,56 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "idefix.hpp"
+#include "numa.hpp"
+
+void idfx::ReportNumaPlacement(const std::string &name, const void *data, size_t bytes) {
+  if(bytes == 0) return;
+  #if defined(__linux__) && defined(SYS_move_pages)
+    const uintptr_t pageSize = sysconf(_SC_PAGESIZE);
+    const uintptr_t first = reinterpret_cast<uintptr_t>(data) & ~(pageSize-1);
+    const uintptr_t last = reinterpret_cast<uintptr_t>(data) + bytes;
+    const size_t nPages = (last - first + pageSize - 1) / pageSize;
+    std::vector<void *> pages(nPages);
+    for(size_t p = 0 ; p < nPages ; p++) {
+      pages[p] = reinterpret_cast<void *>(first + p*pageSize);
+    }
+    // Without target nodes, move_pages only returns the node of each page
+    std::vector<int> status(nPages);
+    if(syscall(SYS_move_pages, 0, nPages, pages.data(), nullptr, status.data(), 0) != 0) {
+      IDEFIX_WARNING("Could not get the NUMA placement of " + name);
+      return;
+    }
+    // Pages which were never touched have a negative status
+    std::map<int, size_t> count;
+    for(int node : status) count[node < 0 ? -1 : node]++;
+
+    std::stringstream msg;
+    msg << "Numa: " << name << " (" << nPages << " pages):";
+    for(auto &it : count) {
+      if(it.first < 0) {
+        msg << " not touched ";
+      } else {
+        msg << " node " << it.first << " ";
+      }
+      msg << 100.0*it.second/nPages << "%";
+    }
+    idfx::cout << msg.str() << std::endl;
+  #else
+    IDEFIX_WARNING("The NUMA placement of the arrays can only be reported on Linux");
+  #endif
+}
@@ -0,0 +1,64 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef NUMA_HPP_
+#define NUMA_HPP_
+
+#include <string>
+#include "idefix.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// NUMA-aware allocation of the large device arrays. On multi-socket hosts (OpenMP), a page is
+/// placed on the NUMA node of the thread which first writes it. Kokkos zeroes new arrays with a
+/// flat loop over their memory, which does not split the cells among the threads like the 3D
+/// idefix_for loops of the compute kernels. These arrays are therefore allocated without
+/// initialisation, and zeroed by a 3D idefix_for loop over (k,j,i), each thread writing all of
+/// the variables of the cells it computes later on.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+namespace idfx {
+
+template<typename T>
+IdefixArray4D<T> FirstTouchArray4D(const std::string &name, const Layout4D &layout) {
+  IdefixArray4D<T> array(Kokkos::view_alloc(Kokkos::WithoutInitializing, name), layout);
+  const int nv = array.extent(0);
+  idefix_for("FirstTouch4D",
+             0, static_cast<int>(array.extent(1)),
+             0, static_cast<int>(array.extent(2)),
+             0, static_cast<int>(array.extent(3)),
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      for(int n = 0 ; n < nv ; n++) {
+        array(n,k,j,i) = T();
+      }
+    });
+  return(array);
+}
+
+template<typename T>
+IdefixArray3D<T> FirstTouchArray3D(const std::string &name, int nk, int nj, int ni) {
+  IdefixArray3D<T> array(Kokkos::view_alloc(Kokkos::WithoutInitializing, name), nk, nj, ni);
+  idefix_for("FirstTouch3D", 0, nk, 0, nj, 0, ni,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      array(k,j,i) = T();
+    });
+  return(array);
+}
+
+// Show the share of the pages of a memory range on each NUMA node (Linux only)
+void ReportNumaPlacement(const std::string &, const void *, size_t);
+
+template<typename ArrayType>
+void ReportNumaPlacement(const ArrayType &array) {
+  if constexpr(Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                          typename ArrayType::memory_space>::accessible) {
+    ReportNumaPlacement(array.label(), array.data(),
+                        array.span()*sizeof(typename ArrayType::value_type));
+  }
+}
+
+} // namespace idfx
+
+#endif // NUMA_HPP_
@@ -976,6 +976,8 @@ int Dump::Write(Output& output) {
   fclose(fileHdl);
 #endif
 
+  // Keep the measured cost profile along with the dump for rebalancing on restart
+  data->mygrid->WriteCost((outputDirectory/"idefix.cost").string());
 
   idfx::cout << "done in " << timer.seconds() << " s." << std::endl;
   idfx::popRegion();
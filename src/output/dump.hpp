@@ -92,10 +92,11 @@ class DumpField {
         Kokkos::deep_copy(arr3D,d3Darray);
         return(arr3D);
       } else if(arrayType==Device4D) {
-        IdefixArray3D<real> arrDev3D = Kokkos::subview(
-                                       d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        IdefixHostArray3D<real> arr3D = Kokkos::create_mirror(arrDev3D);
-        Kokkos::deep_copy(arr3D,arrDev3D);
+        // The subview is strided when the variables are innermost
+        auto arrDev3D = Kokkos::subview(d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+        IdefixHostArray3D<real> arr3D("DumpField", arrDev3D.extent(0), arrDev3D.extent(1),
+                                                   arrDev3D.extent(2));
+        idfx::DeepCopy(arr3D,arrDev3D);
         return(arr3D);
       } else {
         IDEFIX_ERROR("unknown field");
@@ -120,9 +121,8 @@ class DumpField {
       } else if(arrayType==Device3D) {
         Kokkos::deep_copy(d3Darray,in);
       } else if(arrayType==Device4D) {
-        IdefixArray3D<real> arrDev3D = Kokkos::subview(
-                                       d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        Kokkos::deep_copy(arrDev3D,in);
+        auto arrDev3D = Kokkos::subview(d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+        idfx::DeepCopy(arrDev3D,in);
       }
     }
     // Nothing to sync otherwise
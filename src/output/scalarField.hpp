@@ -37,10 +37,11 @@ class ScalarField {
       Kokkos::deep_copy(arr3D,d3Darray);
       return(arr3D);
     } else if(type==Device4D) {
-      IdefixArray3D<real> arrDev3D = Kokkos::subview(
-                                      d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-      IdefixHostArray3D<real> arr3D = Kokkos::create_mirror(arrDev3D);
-      Kokkos::deep_copy(arr3D,arrDev3D);
+      // The subview is strided when the variables are innermost
+      auto arrDev3D = Kokkos::subview(d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+      IdefixHostArray3D<real> arr3D("ScalarField", arrDev3D.extent(0), arrDev3D.extent(1),
+                                                   arrDev3D.extent(2));
+      idfx::DeepCopy(arr3D,arrDev3D);
       return(arr3D);
     } else {
       IDEFIX_ERROR("unknown field");
@@ -0,0 +1,116 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "idefix.hpp"
+#include "perfCounters.hpp"
+
+#ifdef __linux__
+namespace {
+// Counter of one thread of this process, whichever thread calls it
+int OpenCounter(uint32_t type, uint64_t config, pid_t tid) {
+  struct perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;   // Allowed to unprivileged users (perf_event_paranoid <= 2)
+  attr.exclude_hv = 1;
+  return(static_cast<int>(syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0)));
+}
+
+// Thread ids of the host execution space threads (e.g. the OpenMP threads, which Kokkos has
+// already created). Each thread of the pool runs one iteration of an even static partition.
+std::vector<pid_t> HostThreadIds() {
+  const int nThreads = Kokkos::DefaultHostExecutionSpace().concurrency();
+  std::vector<pid_t> tids(nThreads, -1);
+  pid_t *tidPtr = tids.data();
+  Kokkos::parallel_for("PerfCountersThreads",
+    Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, nThreads),
+    [=](int t) {
+      tidPtr[t] = static_cast<pid_t>(syscall(SYS_gettid));
+    });
+  Kokkos::fence();
+  // Keep each thread once, in case one thread ran several iterations
+  std::sort(tids.begin(), tids.end());
+  tids.erase(std::unique(tids.begin(), tids.end()), tids.end());
+  return(tids);
+}
+}// namespace
+#endif
+
+idfx::PerfCounters::~PerfCounters() {
+  #ifdef __linux__
+    for(auto &counter : fd) {
+      for(int it : counter) close(it);
+    }
+  #endif
+}
+
+bool idfx::PerfCounters::Open(uint64_t rawEvent, const std::string &rawName) {
+  #ifdef __linux__
+    // The counters only count the thread they are attached to, so that each thread of the host
+    // execution space gets its own counters, which are summed when they are read
+    for(pid_t tid : HostThreadIds()) {
+      const int fdCycles = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, tid);
+      const int fdInstructions = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, tid);
+      const int fdCacheMisses = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, tid);
+      if(fdCycles < 0 || fdInstructions < 0 || fdCacheMisses < 0) {
+        IDEFIX_WARNING("Cannot open the hardware counters (" + std::string(std::strerror(errno))
+                       + "). Check /proc/sys/kernel/perf_event_paranoid (should be <= 2).");
+        for(int it : {fdCycles, fdInstructions, fdCacheMisses}) {
+          if(it >= 0) close(it);
+        }
+        return(false);
+      }
+      fd[cycles].push_back(fdCycles);
+      fd[instructions].push_back(fdInstructions);
+      fd[cacheMisses].push_back(fdCacheMisses);
+      if(rawEvent > 0) {
+        const int fdRaw = OpenCounter(PERF_TYPE_RAW, rawEvent, tid);
+        if(fdRaw < 0) {
+          IDEFIX_WARNING("Cannot open the raw hardware counter " + rawName + " ("
+                         + std::string(std::strerror(errno)) + "), it is ignored.");
+          rawEvent = 0;
+          for(int it : fd[raw]) close(it);
+          fd[raw].clear();
+        } else {
+          fd[raw].push_back(fdRaw);
+        }
+      }
+    }
+    this->rawName = rawName;
+    isOpen = true;
+    return(true);
+  #else
+    IDEFIX_WARNING("Hardware counters are only available on Linux.");
+    return(false);
+  #endif
+}
+
+void idfx::PerfCounters::Read(Values &values) const {
+  for(int n = 0 ; n < nCounters ; n++) {
+    values[n] = 0;
+    #ifdef __linux__
+      for(int it : fd[n]) {
+        uint64_t value;
+        if(read(it, &value, sizeof(uint64_t)) == sizeof(uint64_t)) values[n] += value;
+      }
+    #endif
+  }
+}
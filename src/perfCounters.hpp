@@ -0,0 +1,43 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef PERFCOUNTERS_HPP_
+#define PERFCOUNTERS_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace idfx {
+
+// Hardware counters of the threads of the host execution space (summed over the threads), read
+// through the Linux perf_event_open system call. The counters are the CPU cycles, the
+// instructions, the last level cache misses and an optional raw event of the processor (for
+// instance the vector instructions retired, whose code depends on the processor).
+class PerfCounters {
+ public:
+  static constexpr int nCounters{4};
+  enum {cycles, instructions, cacheMisses, raw};
+  using Values = std::array<uint64_t, nCounters>;
+
+  ~PerfCounters();
+  bool Open(uint64_t rawEvent, const std::string &rawName);   // rawEvent=0: no raw counter
+  void Read(Values &) const;
+  bool IsOpen() const { return(isOpen); }
+  bool HaveRaw() const { return(!fd[raw].empty()); }
+
+  std::string rawName;
+
+ private:
+  bool isOpen{false};
+  std::array<std::vector<int>, nCounters> fd;   // One file descriptor per thread
+};
+
+}// namespace idfx
+
+#endif // PERFCOUNTERS_HPP_
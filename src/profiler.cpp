@@ -6,8 +6,11 @@
 // ***********************************************************************************
 
 #include <algorithm>
+#include <cinttypes>
+#include <cstdio>
 #include <iomanip>
 #include <mutex>    // NOLINT [build/c++11]
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -93,58 +96,353 @@ void idfx::Profiler::Show() {
     idfx::cout << " memory space: " << usedMemory << " " << units[count] << std::endl;
   }
 
+  if(KernelProbe::enabled) ShowKernels();
+
   if(perfEnabled) {
     // Show performance results
-    rootRegion.Stop();
+    rootRegion.Stop(false);
+
+    // Gather the time spent in each region by all of the ranks. The region trees may differ
+    // from one rank to another, so the regions are matched by their path.
+    std::stringstream local;
+    rootRegion.Collect(local);
+    std::string localStr = local.str();
+    std::string allStr;
+    #ifdef WITH_MPI
+      int size = localStr.size();
+      std::vector<int> sizes(idfx::psize), offsets(idfx::psize);
+      MPI_SAFE_CALL(MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, MPI_COMM_WORLD));
+      int totalSize = 0;
+      for(int p = 0 ; p < idfx::psize ; p++) {
+        offsets[p] = totalSize;
+        totalSize += sizes[p];
+      }
+      std::vector<char> all(idfx::prank == 0 ? totalSize : 0);
+      MPI_SAFE_CALL(MPI_Gatherv(localStr.data(), size, MPI_CHAR, all.data(), sizes.data(),
+                                offsets.data(), MPI_CHAR, 0, MPI_COMM_WORLD));
+      allStr = std::string(all.begin(), all.end());
+    #else
+      allStr = localStr;
+    #endif
+
+    // min, max and average (over the ranks going through it) time of each region, and sum of
+    // its hardware counters
+    std::map<std::string, RegionStats> stats;
+    std::map<std::string, int> nRanks;
+    std::stringstream allStream(allStr);
+    std::string line;
+    while(std::getline(allStream, line)) {
+      std::stringstream fields(line);
+      std::string path, field;
+      std::getline(fields, path, '\t');
+      std::getline(fields, field, '\t');
+      const double time = std::stod(field);
+      std::array<double,PerfCounters::nCounters> counters;
+      for(auto &it : counters) {
+        std::getline(fields, field, '\t');
+        it = std::stod(field);
+      }
+      if(nRanks.count(path) == 0) {
+        stats[path] = {{time, time, time}, counters};
+        nRanks[path] = 1;
+      } else {
+        auto &st = stats[path];
+        st.time[0] = std::min(st.time[0], time);
+        st.time[1] = std::max(st.time[1], time);
+        st.time[2] += time;
+        for(int n = 0 ; n < PerfCounters::nCounters ; n++) st.counters[n] += counters[n];
+        nRanks[path]++;
+      }
+    }
+    for(auto &it : stats) {
+      it.second.time[2] /= nRanks[it.first];
+    }
+    regionStats = stats;
+    const bool showCounters = hwCounters.IsOpen();
+
     idfx::cout << "Profiler: performance results: " << std::endl;
-    idfx::cout << "-------------------------------------------------------------------------------";
+    if(samplePeriod > 0) {
+      idfx::cout << "Profiler: regions are fenced every " << samplePeriod << " cycles. "
+                 << "Otherwise, the asynchronous kernels are timed by the region that waits for "
+                 << "them." << std::endl;
+    }
+    idfx::cout << "---------------------------------------------------------------------------"
+               << "---------------------------------------";
     idfx::cout << std::endl;
-    idfx::cout << "<total time>  <% of total time>  <% of self time>  <number of calls>  <name>";
+    idfx::cout << "<total time>  <% of total time>  <% of self time>  <number of calls>  "
+               << "<time per call (fenced)>  <min/avg/max time over ranks>  ";
+    if(showCounters) {
+      idfx::cout << "<instructions per cycle>  <cache misses per 1000 instructions>  ";
+      if(hwCounters.HaveRaw()) idfx::cout << "<" << hwCounters.rawName << " per instruction>  ";
+    }
+    idfx::cout << "<name>";
     idfx::cout << std::endl;
-    idfx::cout << "-------------------------------------------------------------------------------";
+    idfx::cout << "---------------------------------------------------------------------------"
+               << "---------------------------------------";
     idfx::cout << std::endl;
-    rootRegion.Show(rootRegion.GetTimer());
-    idfx::cout << "-------------------------------------------------------------------------------";
+    rootRegion.Show(rootRegion.GetTimer(), stats, showCounters);
+    idfx::cout << "---------------------------------------------------------------------------"
+               << "---------------------------------------";
     idfx::cout << std::endl;
+    if(showCounters) {
+      idfx::cout << "Profiler: hardware counters of the fenced calls, summed over the ranks "
+                 << "(host threads only)." << std::endl;
+    }
     idfx::cout << "Profiler: end of performance profiling report." << std::endl;
+
+    WriteTrace();
   }
 }
 
-void idfx::Profiler::EnablePerformanceProfiling() {
+// Enable the profiling of the regions. Regions are fenced every period cycles (never if 0)
+void idfx::Profiler::EnablePerformanceProfiling(int period) {
+  samplePeriod = period;
+  if(perfEnabled) return;
   currentRegion = &rootRegion;
-  rootRegion.Start();
+  clock.reset();
+  rootRegion.Start(false);
   perfEnabled = true;
 }
 
+void idfx::Profiler::EnableKernelStats(double bandwidth) {
+  KernelProbe::enabled = true;
+  peakBandwidth = bandwidth;
+}
+
+// Show the kernels sorted by time, with their achieved cell updates and memory bandwidth
+void idfx::Profiler::ShowKernels() {
+  std::vector<std::pair<std::string, KernelStats>> sorted(kernels.begin(), kernels.end());
+  std::sort(sorted.begin(), sorted.end(),
+            [](const auto &a, const auto &b) { return a.second.time > b.second.time; });
+
+  idfx::cout << "Profiler: kernel statistics (fenced kernels, traffic estimated from the "
+             << "declared bytes per cell):" << std::endl;
+  idfx::cout << "---------------------------------------------------------------------------"
+             << "---------------------------------------" << std::endl;
+  idfx::cout << "<time>  <launches>  <cells>  <cell updates/s>  <GB/s>";
+  if(peakBandwidth > 0) idfx::cout << "  <% of peak bandwidth>";
+  idfx::cout << "  <name>" << std::endl;
+  idfx::cout << "---------------------------------------------------------------------------"
+             << "---------------------------------------" << std::endl;
+  for(auto &it : sorted) {
+    const KernelStats &st = it.second;
+    idfx::cout << std::scientific << std::setprecision(2) << st.time << " sec  "
+               << st.launches << "  " << st.cells << "  "
+               << ((st.time > 0) ? st.cells/st.time : 0) << "  ";
+    if(st.timeDeclared > 0) {
+      const double bandwidth = st.bytes/st.timeDeclared/1e9;
+      idfx::cout << std::fixed << std::setprecision(1) << bandwidth << "  ";
+      if(peakBandwidth > 0) idfx::cout << 100*bandwidth/peakBandwidth << "%  ";
+    } else {
+      idfx::cout << "-  ";
+      if(peakBandwidth > 0) idfx::cout << "-  ";
+    }
+    idfx::cout << it.first << std::endl;
+  }
+  idfx::cout << "---------------------------------------------------------------------------"
+             << "---------------------------------------" << std::endl;
+}
+
+void idfx::KernelProbe::Start(const std::string &name, double cells) {
+  Kokkos::fence();
+  this->active = true;
+  this->name = &name;
+  this->cells = cells;
+  this->bytes = pendingBytes;
+  pendingBytes = -1;
+  this->startTime = prof.clock.seconds();
+}
+
+void idfx::KernelProbe::Stop() {
+  Kokkos::fence();
+  const double time = prof.clock.seconds() - startTime;
+  KernelStats &st = prof.kernels[*name];
+  st.launches++;
+  st.cells += cells;
+  st.time += time;
+  if(bytes >= 0) {
+    st.bytes += bytes*cells;
+    st.timeDeclared += time;
+  }
+}
+
+// Decide whether the regions of the coming cycle are fenced
+void idfx::Profiler::NewCycle(int64_t ncycles) {
+  sampling = perfEnabled && samplePeriod > 0 && (ncycles % samplePeriod == 0);
+}
+
+idfx::RegionId idfx::Profiler::Intern(const std::string &name) {
+  auto it = regionIds.find(name);
+  if(it != regionIds.end()) return(it->second);
+  const RegionId id = regionNames.size();
+  regionNames.push_back(name);
+  regionIds[name] = id;
+  return(id);
+}
+
+// Region names are mostly string literals, which have a fixed address: the id is then found
+// without building a string. The same name may have several addresses (one per translation unit)
+// which all map to the same id. The name is still compared, in case the address was reused.
+idfx::RegionId idfx::Profiler::Intern(const char *name) {
+  auto it = literalIds.find(name);
+  if(it != literalIds.end() && regionNames[it->second].compare(name) == 0) return(it->second);
+  const RegionId id = Intern(std::string(name));
+  literalIds[name] = id;
+  return(id);
+}
+
+// Open the hardware counters, which are then read on the sampled cycles
+void idfx::Profiler::EnableHardwareCounters(uint64_t rawEvent, const std::string &rawName) {
+  hwCounters.Open(rawEvent, rawName);
+}
+
+void idfx::Profiler::Push(RegionId id) {
+  if(sampling) Kokkos::fence();
+  currentRegion = currentRegion->GetChild(id, regionNames[id]);
+  if(sampling && trace.size() < maxTraceEvents) {
+    currentRegion->startTime = clock.seconds();
+  }
+  currentRegion->Start(sampling);
+  if(sampling && hwCounters.IsOpen()) hwCounters.Read(currentRegion->counterStart);
+}
+
+void idfx::Profiler::Pop() {
+  if(sampling) Kokkos::fence();
+  PerfCounters::Values counters;
+  if(sampling && hwCounters.IsOpen()) hwCounters.Read(counters);
+  if(currentRegion->Stop(sampling) && hwCounters.IsOpen()) {
+    for(int n = 0 ; n < PerfCounters::nCounters ; n++) {
+      currentRegion->counters[n] += counters[n] - currentRegion->counterStart[n];
+    }
+  }
+  if(sampling && trace.size() < maxTraceEvents) {
+    const double now = clock.seconds();
+    trace.push_back({currentRegion->id, currentRegion->startTime,
+                     now - currentRegion->startTime});
+  }
+  currentRegion = currentRegion->parent;
+}
+
+// Escape a string (e.g. a region name) for the JSON files: quotes, backslashes and control
+// characters
+static std::string JsonEscape(const std::string &in) {
+  std::string out;
+  for(char c : in) {
+    if(c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if(static_cast<unsigned char>(c) < 0x20) {
+      char code[8];
+      std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(c));
+      out += code;
+    } else {
+      out += c;
+    }
+  }
+  return(out);
+}
+
+// Write a machine-readable (JSON) report of the run: the given metrics, the memory high-water mark
+// of each memory space (maximum over the ranks) and the time spent in each region (min, avg and
+// max over the ranks), as shown by Show (which should be called first)
+void idfx::Profiler::WriteReport(const std::string &fileName,
+                                 const std::vector<std::pair<std::string, double>> &metrics) {
+  int64_t memoryMax[16];
+  for(int i = 0 ; i < 16 ; i++) memoryMax[i] = spaceMax[i];
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, memoryMax, 16, MPI_INT64_T, MPI_MAX,
+                                MPI_COMM_WORLD));
+  #endif
+  if(idfx::prank != 0) return;
+
+  FILE *fp = std::fopen(fileName.c_str(), "w");
+  if(fp == NULL) {
+    IDEFIX_WARNING("Cannot write the performance report " + fileName);
+    return;
+  }
+  std::fprintf(fp, "{\n  \"metrics\": {");
+  for(size_t n = 0 ; n < metrics.size() ; n++) {
+    std::fprintf(fp, "%s\n    \"%s\": %.17g", (n > 0) ? "," : "",
+                 JsonEscape(metrics[n].first).c_str(), metrics[n].second);
+  }
+  std::fprintf(fp, "\n  },\n  \"memoryHighWater\": {");
+  for(int i = 0 ; i < numSpaces ; i++) {
+    std::fprintf(fp, "%s\n    \"%s\": %" PRId64, (i > 0) ? "," : "", spaceName[i], memoryMax[i]);
+  }
+  std::fprintf(fp, "\n  },\n  \"regions\": {");
+  bool first = true;
+  for(auto &it : regionStats) {
+    std::fprintf(fp, "%s\n    \"%s\": {\"min\": %.17g, \"avg\": %.17g, \"max\": %.17g}",
+                 first ? "" : ",", JsonEscape(it.first).c_str(), it.second.time[0],
+                 it.second.time[2], it.second.time[1]);
+    first = false;
+  }
+  std::fprintf(fp, "\n  }\n}\n");
+  std::fclose(fp);
+  idfx::cout << "Profiler: performance report written in " << fileName << std::endl;
+}
+
+// Write the regions of the sampled cycles in the Chrome trace event format
+// (readable by chrome://tracing or https://ui.perfetto.dev), one file per rank
+void idfx::Profiler::WriteTrace() {
+  if(trace.empty()) return;
+  std::stringstream fileName;
+  fileName << "idefix-trace." << idfx::prank << ".json";
+  FILE *fp = std::fopen(fileName.str().c_str(), "w");
+  if(fp == NULL) {
+    IDEFIX_WARNING("Cannot write the profiler trace file " + fileName.str());
+    return;
+  }
+  std::fprintf(fp, "{\"traceEvents\":[\n");
+  for(size_t n = 0 ; n < trace.size() ; n++) {
+    // Chrome traces are in microseconds
+    std::fprintf(fp, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                     "\"pid\":%d,\"tid\":0}%s\n",
+                 JsonEscape(regionNames[trace[n].id]).c_str(), 1e6*trace[n].start,
+                 1e6*trace[n].duration,
+                 idfx::prank, (n+1 < trace.size()) ? "," : "");
+  }
+  std::fprintf(fp, "],\"displayTimeUnit\":\"ms\"}\n");
+  std::fclose(fp);
+  if(trace.size() >= maxTraceEvents) {
+    idfx::cout << "Profiler: trace truncated to its first " << maxTraceEvents << " events."
+               << std::endl;
+  }
+  idfx::cout << "Profiler: trace of the sampled cycles written in " << fileName.str()
+             << std::endl;
+}
+
 
 ///////////////////////////////////
 // Region functions definitions //
 ///////////////////////////////////
 
 
-idfx::Region::Region(Region *parent, std::string name, int level) {
+idfx::Region::Region(Region *parent, RegionId id, std::string name, int level) {
   this->parent = parent;
+  this->id = id;
   this->name = name;
+  this->path = parent->path + "/" + name;
   this->level = level;
 }
 
 idfx::Region::Region() {
   this->parent = nullptr;
   this->name = std::string("Main");
+  this->path = this->name;
   this->level = 0;
 }
 
 idfx::Region::~Region() {
-  if(!isLeaf) {
-    // Delete all the children manually, since these are pointers
-    for( auto &it : children) {
-      delete it.second;
-    }
+  // Delete all the children manually, since these are pointers
+  for( auto &it : children) {
+    delete it;
   }
 }
 
-void idfx::Region::Start() {
+void idfx::Region::Start(bool sampled) {
   this->nCalls++;
+  this->sampledCall = sampled;
   this->timer.reset();
 }
 
@@ -152,31 +450,52 @@ double idfx::Region::GetTimer() {
   return this->myTime;
 }
 
-void idfx::Region::Stop() {
-  this->myTime += this->timer.seconds();
+bool idfx::Region::Stop(bool sampled) {
+  const double time = this->timer.seconds();
+  this->myTime += time;
+  // Only the calls fenced at both ends are accurate
+  if(sampled && sampledCall) {
+    this->sampledTime += time;
+    this->sampledCalls++;
+    return(true);
+  }
+  return(false);
 }
 
-idfx::Region * idfx::Region::GetChild(std::string name) {
-  isLeaf=false;
-  if(this->children.find(name) == this->children.end()) {
-    // No children found
-    this->children[name] = new Region(this, name, this->level+1);
+// Regions have few children, which are faster to look for in a vector than in a map
+idfx::Region * idfx::Region::GetChild(RegionId id, const std::string &name) {
+  for(auto &it : children) {
+    if(it->id == id) return(it);
   }
-  return this->children[name];
+  isLeaf=false;
+  children.push_back(new Region(this, id, name, this->level+1));
+  return children.back();
 }
 
 bool idfx::Region::Compare(Region * r1, Region * r2) {
   return r1->GetTimer() > r2->GetTimer();
 }
 
-void idfx::Region::Show(double totTime) {
+// Append the path, the time and the hardware counters of this region and of its children
+// (one line each)
+void idfx::Region::Collect(std::stringstream &stream) {
+  stream << this->path << "\t" << std::scientific << std::setprecision(17) << this->myTime;
+  for(auto &it : counters) {
+    stream << "\t" << static_cast<double>(it);
+  }
+  stream << "\n";
+  for(auto &it : children) {
+    it->Collect(stream);
+  }
+}
+
+void idfx::Region::Show(double totTime, std::map<std::string, RegionStats> &stats,
+                        bool showCounters) {
   // Compute time of all the children
   double childTime = 0;
 
-  if(!isLeaf) {
-    for( auto &it : children) {
-          childTime += it.second->GetTimer();
-        }
+  for( auto &it : children) {
+    childTime += it->GetTimer();
   }
   for(int i = 0 ; i < (this->level) ; i++) {
     idfx::cout << "|   ";
@@ -186,18 +505,37 @@ void idfx::Region::Show(double totTime) {
              << std::fixed << std::setprecision(1)
              << this->myTime/totTime*100 << "%  "
              << (this->myTime-childTime)/this->myTime*100 << "%  "
-             << this->nCalls << "  "
-             << this->name << std::endl;
-  if(!isLeaf) {
-    // Sort the children
-    std::vector<Region*> sorted;
-    for( auto &it : this->children) {
-      sorted.push_back(it.second);
+             << this->nCalls << "  ";
+  idfx::cout << std::scientific << std::setprecision(2);
+  if(this->sampledCalls > 0) {
+    idfx::cout << this->sampledTime/this->sampledCalls << " sec  ";
+  } else {
+    idfx::cout << "-  ";
+  }
+  if(stats.count(this->path) > 0) {
+    const auto &st = stats[this->path];
+    idfx::cout << st.time[0] << "/" << st.time[2] << "/" << st.time[1] << " sec  ";
+    if(showCounters) {
+      const auto &c = st.counters;
+      idfx::cout << std::fixed << std::setprecision(2);
+      if(c[PerfCounters::cycles] > 0 && c[PerfCounters::instructions] > 0) {
+        idfx::cout << c[PerfCounters::instructions]/c[PerfCounters::cycles] << "  "
+                   << 1000*c[PerfCounters::cacheMisses]/c[PerfCounters::instructions] << "  ";
+        if(prof.hwCounters.HaveRaw()) {
+          idfx::cout << c[PerfCounters::raw]/c[PerfCounters::instructions] << "  ";
+        }
+      } else {
+        idfx::cout << "-  -  ";
+        if(prof.hwCounters.HaveRaw()) idfx::cout << "-  ";
+      }
     }
+  }
+  idfx::cout << this->name << std::endl;
 
-    std::sort(sorted.begin(), sorted.end(), this->Compare);
-    for( auto &it : sorted) {
-          it->Show(totTime);
-        }
+  // Sort the children
+  std::vector<Region*> sorted = this->children;
+  std::sort(sorted.begin(), sorted.end(), this->Compare);
+  for( auto &it : sorted) {
+    it->Show(totTime, stats, showCounters);
   }
 }
@@ -8,9 +8,16 @@
 #ifndef PROFILER_HPP_
 #define PROFILER_HPP_
 
+#include <array>
 #include <map>
 #include <mutex>  // NOLINT [build/c++11]
+#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "perfCounters.hpp"
 
 namespace idfx {
 
@@ -18,37 +25,113 @@ struct SpaceHandle {
   char name[64];
 };
 
+// Unique identifier of a region name (see Profiler::Intern)
+using RegionId = int;
+
+// Time (min, max and average over the ranks) and hardware counters (summed over the ranks) of a
+// region
+struct RegionStats {
+  std::array<double,3> time;
+  std::array<double,PerfCounters::nCounters> counters;
+};
+
 // Region is a helper class to Profiler
 // it used to generate a tree of the regions encountered while running
 // and produce a performance report.
 class Region {
  public:
-  Region(Region *parent, std::string name, int level);
+  Region(Region *parent, RegionId id, std::string name, int level);
   Region();
   ~Region();
-  void Start();
-  void Stop();
-  void Show(double );
-  Region* GetChild(std::string name);
+  void Start(bool);
+  bool Stop(bool);                  // Returns whether the call was fenced at both ends
+  void Show(double, std::map<std::string, RegionStats> &, bool);
+  void Collect(std::stringstream &);
+  Region* GetChild(RegionId id, const std::string &name);
   double GetTimer();
   static bool Compare(Region *, Region *);
   bool isLeaf{true};
+  RegionId id{-1};
   std::string name;
-  std::map<std::string, Region*> children;
+  std::string path;                 // names of the parent regions and of this one
+  std::vector<Region*> children;
   Region *parent;
   int level;
+  double startTime{0};              // Start of the current call (in Profiler::clock)
+  PerfCounters::Values counterStart{};  // Hardware counters at the start of the current call
+  PerfCounters::Values counters{};      // Hardware counters of the sampled calls
  private:
   Kokkos::Timer timer;
   double myTime{0};
   int64_t nCalls{0};
+  double sampledTime{0};            // Time spent in the calls made on sampled cycles
+  int64_t sampledCalls{0};
+  bool sampledCall{false};          // Whether the current call started on a sampled cycle
+};
+
+
+// Launches, cells and time of a kernel, and its memory traffic estimated from the traffic per
+// cell declared before its launches (see DeclareTraffic)
+struct KernelStats {
+  int64_t launches{0};
+  double cells{0};
+  double time{0};
+  double bytes{0};                  // Traffic of the launches with a declared traffic
+  double timeDeclared{0};           // Time of these launches
 };
 
+// Measure a kernel launched by idefix_for or idefix_reduce when the kernel statistics are
+// enabled (-kernelstats). The kernel is then fenced at both ends.
+class KernelProbe {
+ public:
+  KernelProbe(const std::string &name, double cells) {
+    if(enabled) Start(name, cells);
+  }
+  ~KernelProbe() {
+    if(active) Stop();
+  }
+  static inline bool enabled{false};
+  static inline double pendingBytes{-1};  // Traffic per cell of the next kernel (if declared)
+
+ private:
+  void Start(const std::string &, double);
+  void Stop();
+  bool active{false};
+  const std::string *name;
+  double cells;
+  double bytes;
+  double startTime;
+};
+
+// Declare the memory traffic per cell of the next kernel
+inline void DeclareTraffic(double bytesRead, double bytesWritten) {
+  if(KernelProbe::enabled) KernelProbe::pendingBytes = bytesRead + bytesWritten;
+}
+
+// Bytes of a cell of a 3D array, or of all of the variables of a cell of a 4D array
+template<typename View>
+double BytesPerCell(const View &view) {
+  double bytes = sizeof(typename View::value_type);
+  for(int r = 0 ; r+3 < static_cast<int>(View::rank) ; r++) bytes *= view.extent(r);
+  return(bytes);
+}
 
 class Profiler {
  public:
   void Init();
   void Show();
-  void EnablePerformanceProfiling();
+  void EnablePerformanceProfiling(int);
+  void NewCycle(int64_t);           // Start a new integration cycle
+  void EnableKernelStats(double);   // Measure the kernels, given the peak bandwidth (GB/s)
+  void EnableHardwareCounters(uint64_t, const std::string &);  // with an optional raw event
+  void WriteReport(const std::string &,      // JSON report of the run, with the given metrics
+                   const std::vector<std::pair<std::string, double>> &);
+
+  RegionId Intern(const std::string &);  // Unique id of a region name
+  RegionId Intern(const char *);         // Same, cached on the address of a string literal
+  void Push(RegionId);
+  void Pop();
+
   int numSpaces;
   int64_t spaceSize[16];
   int64_t spaceMax[16];
@@ -56,8 +139,33 @@ class Profiler {
   std::mutex m;
 
   bool perfEnabled{false};
+  int samplePeriod{100};            // # of cycles between two fenced (sampled) cycles
+  bool sampling{false};             // Whether regions are fenced in the current cycle
   Region rootRegion;
   Region *currentRegion;
+
+  std::map<std::string, KernelStats> kernels;
+  double peakBandwidth{0};          // Peak memory bandwidth (GB/s), if known
+  Kokkos::Timer clock;              // Time origin of the trace and of the kernel probes
+  PerfCounters hwCounters;          // Read at both ends of the regions of the sampled cycles
+
+ private:
+  void WriteTrace();                // Write the events of the sampled cycles (Chrome trace)
+  void ShowKernels();               // Show the kernel statistics
+
+  std::map<std::string, RegionStats> regionStats;  // Region statistics gathered by Show
+
+  std::vector<std::string> regionNames;
+  std::unordered_map<std::string, RegionId> regionIds;
+  std::unordered_map<const char *, RegionId> literalIds;
+
+  struct TraceEvent {
+    RegionId id;
+    double start;
+    double duration;
+  };
+  std::vector<TraceEvent> trace;
+  static constexpr size_t maxTraceEvents{1000000};
 };
 
 
@@ -24,8 +24,23 @@
   #endif
 #endif // SINGLE_PRECISION
 
+// Type used for local arithmetic and for accumulators (time, reductions, planet orbits).
+// It matches real, except in mixed precision where fields are stored in single
+// precision but computations are carried out in double precision.
+#if defined(SINGLE_PRECISION) && !defined(MIXED_PRECISION)
+  using realc = float;
+  #ifdef WITH_MPI
+    #define realcMPI      MPI_FLOAT
+  #endif
+#else
+  using realc = double;
+  #ifdef WITH_MPI
+    #define realcMPI     MPI_DOUBLE
+  #endif
+#endif
+
 // math function
-#ifdef SINGLE_PRECISION
+#if defined(SINGLE_PRECISION) && !defined(MIXED_PRECISION)
 
 #define FMAX(x,y) fmaxf(x,y)
 #define FMIN(x,y) fminf(x,y)
@@ -63,7 +78,6 @@
 #define THREE_F (3.0)
 #define FOUR_F  (4.0)
 
-
-#endif // SINGLE_PRECISION
+#endif // SINGLE_PRECISION && !MIXED_PRECISION
 
 #endif // REAL_TYPES_HPP_
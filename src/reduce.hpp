@@ -15,6 +15,7 @@
 #include <string>
 #include "idefix.hpp"
 #include "global.hpp"
+#include "profiler.hpp"
 
 
 // 1D default loop pattern
@@ -23,6 +24,7 @@ inline void idefix_reduce(const std::string & NAME,
                 const int & IB, const int & IE,
                 Function function,
                 Reducer redFunction) {
+    idfx::KernelProbe probe(NAME, IE-IB);
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
@@ -41,6 +43,7 @@ inline void idefix_reduce(const std::string & NAME,
                 const int & IB, const int & IE,
                 Function function,
                 Reducer redFunction) {
+    idfx::KernelProbe probe(NAME, static_cast<double>(JE-JB)*(IE-IB));
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
@@ -65,6 +68,7 @@ inline void idefix_reduce(const std::string & NAME,
                 const int & IB, const int & IE,
                 Function function,
                 Reducer redFunction) {
+    idfx::KernelProbe probe(NAME, static_cast<double>(KE-KB)*(JE-JB)*(IE-IB));
     // We only implement MDRange reductions here since the other implementations are too
     // complicated to be implemented for any reduction operator on any class
     #ifdef DEBUG
@@ -89,6 +93,7 @@ inline void idefix_reduce(const std::string & NAME,
                 const int & IB, const int & IE,
                 Function function,
                 Reducer redFunction) {
+    idfx::KernelProbe probe(NAME, static_cast<double>(KE-KB)*(JE-JB)*(IE-IB));
     // We only implement MDRange reductions here since the other implementations are too
     // complicated to be implemented for any reduction operator on any class
     #ifdef DEBUG
@@ -9,9 +9,11 @@
 #define RKL_RKL_HPP_
 
 #include <string>
+#include <sstream>
 #include <vector>
 
 #include "idefix.hpp"
+#include "numa.hpp"
 #include "input.hpp"
 #include "dataBlock.hpp"
 #include "viscosity.hpp"
@@ -77,6 +79,9 @@ class RKLegendre {
 
   bool checkNan{false};         // whether we should look for Nans when RKL is running
 
+  HaloPrecision haloPrecision{HaloPrecision::Full};  // precision of the MPI halos in first stages
+  int haloStages{0};            // # of first stages exchanging reduced precision halos
+
  private:
   template<int> void LoopDir(real);   // Dimensional loop
 };
@@ -109,6 +114,7 @@ template<typename Phys>
 void RKLegendre<Phys>::Copy(IdefixArray4D<real> &out, IdefixArray4D<real> &in) {
   IdefixArray1D<int> vars = this->varList;
 
+  idfx::DeclareTraffic(nvarRKL*sizeof(real), nvarRKL*sizeof(real));
   idefix_for("RKL_Copy",
              0, nvarRKL,
              0, data->np_tot[KDIR],
@@ -138,6 +144,13 @@ RKLegendre<Phys>::RKLegendre(Input &input, Fluid<Phys>* hydroin) {
 
   this->checkNan = input.GetOrSet<bool>("RKL","check_nan",0, this->checkNan);
 
+  // Reduced precision MPI halos for the first stages (opt-in)
+  if(input.CheckEntry("RKL","halo_precision") >= 0) {
+    haloPrecision = idfx::ParseHaloPrecision(input.Get<std::string>("RKL","halo_precision",0),
+                                             "RKL");
+    haloStages = input.Get<int>("RKL","halo_precision",1);
+  }
+
   // Make a list of variables
 
   std::vector<int> varListHost;
@@ -204,50 +217,50 @@ RKLegendre<Phys>::RKLegendre(Input &input, Fluid<Phys>* hydroin) {
 
   // Variable allocation
 
-  dU = IdefixArray4D<real>("RKL_dU", NVAR,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  dU0 = IdefixArray4D<real>("RKL_dU0", NVAR,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc0 = IdefixArray4D<real>("RKL_Uc0", NVAR,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc1 = IdefixArray4D<real>("RKL_Uc1", NVAR,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  dU = idfx::FirstTouchArray4D<real>("RKL_dU", idfx::ArrayLayout4D(NVAR,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+  dU0 = idfx::FirstTouchArray4D<real>("RKL_dU0", idfx::ArrayLayout4D(NVAR,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+  Uc0 = idfx::FirstTouchArray4D<real>("RKL_Uc0", idfx::ArrayLayout4D(NVAR,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
+  Uc1 = idfx::FirstTouchArray4D<real>("RKL_Uc1", idfx::ArrayLayout4D(NVAR,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]));
 
   if(haveVs) {
     #ifdef EVOLVE_VECTOR_POTENTIAL
-      dA = IdefixArray4D<real>("RKL_dA", AX3e+1,
+      dA = idfx::FirstTouchArray4D<real>("RKL_dA", idfx::ArrayLayout4D(AX3e+1,
                       data->np_tot[KDIR]+KOFFSET,
                       data->np_tot[JDIR]+JOFFSET,
-                      data->np_tot[IDIR]+IOFFSET);
-      dA0 = IdefixArray4D<real>("RKL_dA0", AX3e+1,
+                      data->np_tot[IDIR]+IOFFSET));
+      dA0 = idfx::FirstTouchArray4D<real>("RKL_dA0", idfx::ArrayLayout4D(AX3e+1,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      Ve0 = IdefixArray4D<real>("RKL_Ve0", AX3e+1,
+                        data->np_tot[IDIR]+IOFFSET));
+      Ve0 = idfx::FirstTouchArray4D<real>("RKL_Ve0", idfx::ArrayLayout4D(AX3e+1,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      Ve1 = IdefixArray4D<real>("RKL_Ve1", AX3e+1,
+                        data->np_tot[IDIR]+IOFFSET));
+      Ve1 = idfx::FirstTouchArray4D<real>("RKL_Ve1", idfx::ArrayLayout4D(AX3e+1,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
+                        data->np_tot[IDIR]+IOFFSET));
     #else
-      dB = IdefixArray4D<real>("RKL_dB", DIMENSIONS,
+      dB = idfx::FirstTouchArray4D<real>("RKL_dB", idfx::ArrayLayout4D(DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      dB0 = IdefixArray4D<real>("RKL_dB0", DIMENSIONS,
+                        data->np_tot[IDIR]+IOFFSET));
+      dB0 = idfx::FirstTouchArray4D<real>("RKL_dB0", idfx::ArrayLayout4D(DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      Vs0 = IdefixArray4D<real>("RKL_Vs0", DIMENSIONS,
+                        data->np_tot[IDIR]+IOFFSET));
+      Vs0 = idfx::FirstTouchArray4D<real>("RKL_Vs0", idfx::ArrayLayout4D(DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      Vs1 = IdefixArray4D<real>("RKL_Vs1", DIMENSIONS,
+                        data->np_tot[IDIR]+IOFFSET));
+      Vs1 = idfx::FirstTouchArray4D<real>("RKL_Vs1", idfx::ArrayLayout4D(DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
+                        data->np_tot[IDIR]+IOFFSET));
     #endif
   }
 
@@ -276,6 +289,10 @@ void RKLegendre<Phys>::ShowConfig() {
     idfx::cout << "RKLegendre: will check consistency of solution in the integrator (slow!)."
                << std::endl;
   }
+  if(haloPrecision != HaloPrecision::Full && haloStages > 0) {
+    idfx::cout << "RKLegendre: reduced precision MPI halos in the first " << haloStages
+               << " stages." << std::endl;
+  }
 }
 
 template<typename Phys>
@@ -303,7 +320,7 @@ void RKLegendre<Phys>::Cycle() {
   #endif
 
   IdefixArray1D<int> varList = this->varList;
-  real time = data->t;
+  realc time = data->t;
 
   real dt_hyp = data->dt;
 
@@ -386,6 +403,8 @@ void RKLegendre<Phys>::Cycle() {
   time = data->t + 0.25*dt_hyp*(stage*stage+stage-2)*w1;
 #endif
   if(haveVc) {
+    // Per cell: Uc and dU0 read, Uc1 and Uc written
+    idfx::DeclareTraffic(2*nvarRKL*sizeof(real), 2*nvarRKL*sizeof(real));
     idefix_for("RKL_Cycle_InitUc1",
               0, nvarRKL,
               data->beg[KDIR],data->end[KDIR],
@@ -400,6 +419,7 @@ void RKLegendre<Phys>::Cycle() {
   }
   if(haveVs) {
     #ifdef EVOLVE_VECTOR_POTENTIAL
+      idfx::DeclareTraffic(2*(AX3e+1)*sizeof(real), 2*(AX3e+1)*sizeof(real));
       idefix_for("RKL_Cycle_InitVe1",
               0, AX3e+1,
               data->beg[KDIR],data->end[KDIR]+KOFFSET,
@@ -411,6 +431,7 @@ void RKLegendre<Phys>::Cycle() {
       });
       hydro->emf->ComputeMagFieldFromA(Ve,Vs);
     #else
+      idfx::DeclareTraffic(2*DIMENSIONS*sizeof(real), 2*DIMENSIONS*sizeof(real));
       idefix_for("RKL_Cycle_InitVs1",
               0, DIMENSIONS,
               data->beg[KDIR],data->end[KDIR]+KOFFSET,
@@ -437,6 +458,13 @@ void RKLegendre<Phys>::Cycle() {
     }
   }
 
+  // Arrays read by the update kernels of the stages
+  #if RKL_ORDER == 1
+    constexpr int rklReadArrays = 3;
+  #elif RKL_ORDER == 2
+    constexpr int rklReadArrays = 5;
+  #endif
+
   real mu_j, nu_j, gamma_j;
   // subStages loop
   for(stage=2; stage <= rklstages ; stage++) {
@@ -465,6 +493,8 @@ void RKLegendre<Phys>::Cycle() {
     EvolveStage(time);
     if(haveVc) {
       // update Uc
+      // Per cell: Uc, Uc1 and dU read (and Uc0, dU0 at second order), Uc1 and Uc written
+      idfx::DeclareTraffic(rklReadArrays*nvarRKL*sizeof(real), 2*nvarRKL*sizeof(real));
       idefix_for("RKL_Cycle_UpdateUc",
               0, nvarRKL,
               data->beg[KDIR],data->end[KDIR],
@@ -486,6 +516,7 @@ void RKLegendre<Phys>::Cycle() {
     if(haveVs) {
       #ifdef EVOLVE_VECTOR_POTENTIAL
         // update Ve
+        idfx::DeclareTraffic(rklReadArrays*(AX3e+1)*sizeof(real), 2*(AX3e+1)*sizeof(real));
         idefix_for("RKL_Cycle_UpdateVe",
                 0, AX3e+1,
                 data->beg[KDIR],data->end[KDIR]+KOFFSET,
@@ -505,6 +536,7 @@ void RKLegendre<Phys>::Cycle() {
         hydro->emf->ComputeMagFieldFromA(Ve,Vs);
       #else
         // update Vs
+        idfx::DeclareTraffic(rklReadArrays*DIMENSIONS*sizeof(real), 2*DIMENSIONS*sizeof(real));
         idefix_for("RKL_Cycle_UpdateVs",
                 0, DIMENSIONS,
                 data->beg[KDIR],data->end[KDIR]+KOFFSET,
@@ -559,6 +591,7 @@ void RKLegendre<Phys>::ResetFlux() {
   idfx::pushRegion("RKLegendre::ResetFlux");
   IdefixArray4D<real> Flux = hydro->FluxRiemann;
   IdefixArray1D<int> vars = this->varList;
+  idfx::DeclareTraffic(0, nvarRKL*sizeof(real));
   idefix_for("RKL_ResetFlux",
              0,nvarRKL,
              0,data->np_tot[KDIR],
@@ -755,6 +788,7 @@ void RKLegendre<Phys>::CalcParabolicRHS(real t) {
   if(dir==KDIR) koffset=1;
 
 
+  idfx::DeclareTraffic(nvarRKL*sizeof(real) + idfx::BytesPerCell(A), nvarRKL*sizeof(real));
   idefix_for("CalcTotalFlux",
              0, this->nvarRKL,
              data->beg[KDIR],data->end[KDIR]+koffset,
@@ -802,6 +836,8 @@ void RKLegendre<Phys>::CalcParabolicRHS(real t) {
   );
 
 
+  // Per cell: Flux, dU and dV read, dU written
+  idfx::DeclareTraffic(2*nvarRKL*sizeof(real) + idfx::BytesPerCell(dV), nvarRKL*sizeof(real));
   idefix_for("CalcRightHandSide",
              0, this->nvarRKL,
              data->beg[KDIR],data->end[KDIR],
@@ -942,6 +978,10 @@ void RKLegendre<Phys>::SetBoundaries(real t) {
   // by the MPI instance of RKLegendre
   //if(hydro->boundary->haveInternalBoundary)
   //   hydro->boundary->internalBoundaryFunc(*data, t);
+  #ifdef WITH_MPI
+  // The first stages can tolerate rounded ghost zones, the last ones are exchanged in full
+  this->mpi.SetHaloPrecision(stage <= haloStages ? haloPrecision : HaloPrecision::Full);
+  #endif
   for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
       // MPI Exchange data when needed
       // We use the RKL instance MPI object to ensure that we only exchange the data
@@ -9,6 +9,7 @@
 
 #include <cstdio>
 #include <iomanip>
+#include <sstream>
 #include <string>
 #include <vector>
 #include "idefix.hpp"
@@ -18,6 +19,7 @@
 #include "stateContainer.hpp"
 #include "fluid.hpp"
 #include "planetarySystem.hpp"
+#include "profiler.hpp"
 
 
 TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
@@ -27,7 +29,20 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
   this->lastLog=timer.seconds();
   this->lastMpiLog=idfx::mpiCallsTimer + idfx::mpiCallsTimer;
 
-  nstages=input.Get<int>("TimeIntegrator","nstages",0);
+  if(input.CheckEntry("TimeIntegrator","integrator")>=0) {
+    integratorName = input.Get<std::string>("TimeIntegrator","integrator",0);
+  } else {
+    nstages=input.Get<int>("TimeIntegrator","nstages",0);
+    if(nstages==1) {
+      integratorName = "euler";
+    } else if(nstages==2) {
+      integratorName = "rk2";
+    } else if(nstages==3) {
+      integratorName = "rk3";
+    } else {
+      IDEFIX_ERROR("nstages can only be 1, 2 or 3. Use the integrator entry for other schemes");
+    }
+  }
 
   if(input.CheckEntry("TimeIntegrator","fixed_dt")>0) {
     this->haveFixedDt = true;
@@ -59,26 +74,63 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
   data.t=0.0;
   ncycles=0;
 
-  if(nstages==2) {
-    wc[0] = 0.5;
-    w0[0] = 0.5;
-  }
-  if(nstages==3) {
-    wc[0] = 0.25;
-    w0[0] = 0.75;
-    wc[1] = 2.0/3.0;
-    w0[1] = 1.0/3.0;
+  if(integratorName.compare("euler") == 0) {
+    stages.resize(1);
+  } else if(integratorName.compare("rk2") == 0) {
+    stages.resize(2);
+    stages[1].wc = 0.5;
+    stages[1].w0 = 0.5;
+  } else if(integratorName.compare("rk3") == 0) {
+    stages.resize(3);
+    stages[1].wc = 0.25;
+    stages[1].w0 = 0.75;
+    stages[2].wc = 2.0/3.0;
+    stages[2].w0 = 1.0/3.0;
+  } else if(integratorName.compare("ssprk43") == 0) {
+    // 4 stages, 3rd order SSP scheme (Kraaijevanger 1991), SSP coefficient 2
+    stages.resize(4);
+    for(auto &st : stages) st.fdt = 0.5;
+    stages[2].wc = 1.0/3.0;
+    stages[2].w0 = 2.0/3.0;
+  } else if(integratorName.compare("ssprk104") == 0) {
+    // 10 stages, 4th order low-storage SSP scheme (Ketcheson 2008), SSP coefficient 6
+    stages.resize(10);
+    for(auto &st : stages) st.fdt = 1.0/6.0;
+    stages[4].ws = 1.0/25.0;
+    stages[4].wu = 9.0/25.0;
+    stages[4].wc = -5.0;
+    stages[4].w0 = 15.0;
+    stages[9].wc = 3.0/5.0;
+    stages[9].w0 = 1.0;
+  } else {
+    std::stringstream msg;
+    msg << "Unknown time integrator " << integratorName
+        << ". Can only be euler, rk2, rk3, ssprk43 or ssprk104." << std::endl;
+    IDEFIX_ERROR(msg);
   }
+  nstages = stages.size();
 
   // Init the RKL scheme if it's needed
   if(data.hydro->haveRKLParabolicTerms) {
     haveRKL = true;
   }
 
+  // Implicit parabolic terms are split from the hyperbolic step as RKL is
+  if(data.hydro->haveImplicitParabolicTerms) {
+    haveImplicit = true;
+  }
+
+  // Hall sub-cycling is split from the hyperbolic step as well
+  if(data.hydro->hallStatus.isSubcycled) {
+    haveHallSubcycle = true;
+  }
+
   // If multi-stage, create a new state in the datablock called "begin"
+  current = &data.states["current"];
   if(nstages>1) {
     data.states["begin"] = StateContainer();
-    data.states["begin"].AllocateAs(data.states["current"]);
+    begin = &data.states["begin"];
+    begin->AllocateAs(*current);
   }
 
   idfx::popRegion();
@@ -125,6 +177,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
     if(haveRKL) {
       idfx::cout << " | " << std::setw(col_width) << "RKL stages";
     }
+    if(haveHallSubcycle) {
+      idfx::cout << " | " << std::setw(col_width) << "Hall subcycles";
+    }
     if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
       idfx::cout << " | " << std::setw(col_width) << "SG iterations";
       idfx::cout << " | " << std::setw(col_width) << "SG error";
@@ -135,7 +190,7 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
 
   #ifdef WITH_MPI
     double imbalance = 0;
-    if(ncycles>=cyclePeriod) imbalance = ComputeBalance();
+    if(ncycles>=cyclePeriod) imbalance = ComputeBalance(data);
   #endif
   idfx::cout << "TimeIntegrator: ";
   idfx::cout << std::scientific;
@@ -177,6 +232,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
   if(haveRKL) {
     idfx::cout << " | " << std::setw(col_width) << data.hydro->rkl->stage;
   }
+  if(haveHallSubcycle) {
+    idfx::cout << " | " << std::setw(col_width) << data.hydro->hallSubcycle->nsubcycles;
+  }
   if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
     if(ncycles>=cyclePeriod) {
       idfx::cout << " | " << std::setw(col_width) << data.gravity->selfGravity.nsteps;
@@ -193,7 +251,7 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
   idfx::cout << std::endl;
 }
 
-double TimeIntegrator::ComputeBalance() {
+double TimeIntegrator::ComputeBalance(DataBlock &data) {
   // Check MPI imbalance
     double imbalance = 0;
     #ifdef WITH_MPI
@@ -201,6 +259,8 @@ double TimeIntegrator::ComputeBalance() {
       std::vector<double> computeLogPerCore(idfx::psize);
       MPI_Gather(&computeLastLog, 1, MPI_DOUBLE, computeLogPerCore.data(), 1, MPI_DOUBLE, 0,
                   MPI_COMM_WORLD);
+      // Feed the cost profile used by weighted domain decompositions
+      data.mygrid->AccumulateCost(computeLastLog);
       computeLastLog = 0; // reset timer for all cores
       if(idfx::prank==0) {
         // Compute the average, the min and the max
@@ -248,6 +308,9 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   IdefixArray3D<real> InvDt = data.hydro->InvDt;
   real newdt;
 
+  // Fence the profiled regions of this cycle when it is sampled
+  idfx::prof.NewCycle(ncycles);
+
   idfx::pushRegion("TimeIntegrator::Cycle");
 
   if(ncycles%cyclePeriod==0) ShowLog(data);
@@ -259,8 +322,18 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     data.EvolveRKLStage();
   }
 
+  if(haveImplicit && (ncycles%2)==1) {    // Implicit parabolic step
+    data.EvolveImplicitStage();
+  }
+
+  if(haveHallSubcycle && (ncycles%2)==1) {    // Sub-cycled Hall step
+    data.EvolveHallStage();
+  }
+
   // save t at the begining of the cycle
-  const real t0 = data.t;
+  const realc t0 = data.t;
+  // time of the stored state of multi-stage integrators
+  realc tBegin = t0;
 
   // Reinit datablock for a new stage
   data.ResetStage();
@@ -280,26 +353,28 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     if(data.haveFargo) data.fargo->SubstractVelocity(data.t);
 
     // Convert current state into conservative variable and save it
-    data.PrimToCons();
-
-    // Store (deep copy) initial stage for multi-stage time integrators
+    // (the initial stage of multi-stage integrators is stored in the same pass)
     if(nstages>1 && stage==0) {
-      data.states["begin"].CopyFrom(data.states["current"]);
+      data.PrimToCons(*begin);
+    } else {
+      data.PrimToCons();
     }
     // If gravity is needed, update it
     if(data.haveGravity) {
       if(ncycles % data.gravity->skipGravity == 0) data.gravity->ComputeGravity(ncycles);
     }
+    // Update the active regions of the dust species every now and then
+    if(data.dustMask && stage==0) data.dustMask->Update(ncycles);
 
     Kokkos::fence();
     computeLastLog -= timer.seconds();
     // Update Uc & Vs
-    data.EvolveStage();
+    data.EvolveStage(stages[stage].fdt*data.dt);
     Kokkos::fence();
     computeLastLog += timer.seconds();
 
     // evolve dt accordingly
-    data.t += data.dt;
+    data.t += stages[stage].fdt*data.dt;
 
     // Look for Nans every now and then (this actually cost a lot of time on GPUs
     // because streams are divergent)
@@ -322,15 +397,23 @@ void TimeIntegrator::Cycle(DataBlock &data) {
       }
     }
 
-    // Is this not the first stage?
-    if(stage>0) {
-      // do the partial evolution required by the multi-step
-      real wcs=wc[stage-1];
-      real w0s=w0[stage-1];
-      data.states["current"].AddAndStore(wcs, w0s, data.states["begin"]);
+    const Stage &st = stages[stage];
+    // Update the stored state of low-storage schemes
+    if(st.wu != ZERO_F) {
+      begin->AddAndStore(st.ws, st.wu, *current);
+      tBegin = st.ws*tBegin + st.wu*data.t;
+    }
+
+    // do the partial evolution required by the multi-step. When possible, it is fused
+    // with the conversion to primitive variables (fargo and coarsening need it before)
+    const bool haveCombination = (st.w0 != ZERO_F);
+    const bool fuseCombination = haveCombination && !data.haveGridCoarsening
+                                 && !(data.haveFargo && stage==nstages-1);
+    if(haveCombination) {
+      if(!fuseCombination) current->AddAndStore(st.wc, st.w0, *begin);
 
       // update t
-      data.t = wcs*data.t + w0s*t0;
+      data.t = st.wc*data.t + st.w0*tBegin;
     }
     // Shift solution according to fargo if this is our last stage
     if(data.haveFargo && stage==nstages-1) {
@@ -343,7 +426,11 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     }
 
     // Back to using Vc
-    data.ConsToPrim();
+    if(fuseCombination) {
+      data.ConsToPrim(st.wc, st.w0, *begin);
+    } else {
+      data.ConsToPrim();
+    }
 
     // Add back fargo velocity so that boundary conditions are applied on the total V
     if(data.haveFargo) data.fargo->AddVelocity(data.t);
@@ -363,6 +450,14 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     data.EvolveRKLStage();
   }
 
+  if(haveImplicit && (ncycles%2)==0) {    // Implicit parabolic step
+    data.EvolveImplicitStage();
+  }
+
+  if(haveHallSubcycle && (ncycles%2)==0) {    // Sub-cycled Hall step
+    data.EvolveHallStage();
+  }
+
   // Update planet position
   if(data.haveplanetarySystem) {
     data.planetarySystem->EvolveSystem(data, data.dt);
@@ -385,6 +480,12 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     newdt *= std::fmin(ONE_F, data.hydro->rkl->rmax_par/(tt));
   }
 
+  if(haveHallSubcycle) {
+    // limit the number of Hall sub-steps
+    real tt = newdt/data.hydro->hallSubcycle->dt;
+    newdt *= std::fmin(ONE_F, data.hydro->hallSubcycle->rmax/(tt));
+  }
+
   // Next time step
   if(!haveFixedDt) {
     if(newdt>cflMaxVar*data.dt) {
@@ -446,12 +547,18 @@ bool TimeIntegrator::CheckForMaxRuntime() {
 }
 
 void TimeIntegrator::ShowConfig() {
-  if(nstages==1) {
+  if(integratorName.compare("euler") == 0) {
     idfx::cout << "TimeIntegrator: using 1st Order (EULER) integrator." << std::endl;
-  } else if(nstages==2) {
+  } else if(integratorName.compare("rk2") == 0) {
     idfx::cout << "TimeIntegrator: using 2nd Order (RK2) integrator." << std::endl;
-  } else if(nstages==3) {
+  } else if(integratorName.compare("rk3") == 0) {
     idfx::cout << "TimeIntegrator: using 3rd Order (RK3) integrator." << std::endl;
+  } else if(integratorName.compare("ssprk43") == 0) {
+    idfx::cout << "TimeIntegrator: using 3rd Order, 4 stages SSP (SSPRK43) integrator."
+               << std::endl;
+  } else if(integratorName.compare("ssprk104") == 0) {
+    idfx::cout << "TimeIntegrator: using 4th Order, 10 stages low-storage SSP (SSPRK104) "
+               << "integrator." << std::endl;
   } else {
     IDEFIX_ERROR("Unknown time integrator");
   }
@@ -8,6 +8,8 @@
 #ifndef TIMEINTEGRATOR_HPP_
 #define TIMEINTEGRATOR_HPP_
 
+#include <string>
+#include <vector>
 #include "idefix.hpp"
 #include "dataBlock.hpp"
 #include "rkl.hpp"
@@ -33,15 +35,37 @@ class TimeIntegrator {
   bool isSilent{false};   // Whether the integration should proceed silently
 
  private:
-  double ComputeBalance(); // Compute the compute balance between MPI processes
+  double ComputeBalance(DataBlock &); // Compute the compute balance between MPI processes
 
   // Whether we have RKL
   bool haveRKL{false};
 
+  // Whether we have implicit parabolic terms
+  bool haveImplicit{false};
+
+  // Whether we have a sub-cycled Hall effect
+  bool haveHallSubcycle{false};
+
+  // Coefficients of a stage, written in Shu-Osher form with two registers
+  // (current state U and stored state U0):
+  //   U  <- U + dt*fdt*L(U)
+  //   U0 <- ws*U0 + wu*U          (only when wu != 0)
+  //   U  <- wc*U + w0*U0          (only when w0 != 0)
+  struct Stage {
+    real fdt{1};
+    real ws{1};
+    real wu{0};
+    real wc{1};
+    real w0{0};
+  };
+
   int nstages;
-  // Weights of time integrator
-  real w0[2];
-  real wc[2];
+  std::string integratorName;
+  std::vector<Stage> stages;    // Coefficients of each stage
+
+  // Direct handles on the states used by the integrator
+  StateContainer *current{nullptr};
+  StateContainer *begin{nullptr};
 
   int checkNanPeriodicity{1};
 
@@ -62,6 +62,12 @@ Column::Column(int dir, int sign, DataBlock *data)
   idfx::popRegion();
 }
 
+void Column::SetHaloPrecision(HaloPrecision precision) {
+  #ifdef WITH_MPI
+    this->mpi.SetHaloPrecision(precision);
+  #endif
+}
+
 void Column::ComputeColumn(IdefixArray4D<real> in, const int var) {
   idfx::pushRegion("Column::ComputeColumn");
   const int nk = np_int[KDIR];
@@ -209,9 +215,9 @@ void Column::ComputeColumn(IdefixArray4D<real> in, const int var) {
     // density in the ghost zones are coherent
     #ifdef WITH_MPI
       // Create a 4D array that contains our column data
-      IdefixArray4D<real> arr4D(column.data(), 1, this->np_tot[KDIR],
-                                                        this->np_tot[JDIR],
-                                                        this->np_tot[IDIR]);
+      IdefixArray4D<real> arr4D(column.data(), idfx::ArrayLayout4D(1, this->np_tot[KDIR],
+                                                                   this->np_tot[JDIR],
+                                                                   this->np_tot[IDIR], false));
 
       for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
         // MPI Exchange data when needed
@@ -235,6 +241,7 @@ void Column::ComputeColumn(IdefixArray4D<real> in, const int var) {
 
 void Column::ComputeColumn(IdefixArray3D<real> in) {
   // 4D alias
-  IdefixArray4D<real> arr4D(in.data(), 1, in.extent(0), in.extent(1), in.extent(2));
+  IdefixArray4D<real> arr4D(in.data(), idfx::ArrayLayout4D(1, in.extent(0), in.extent(1),
+                                                             in.extent(2), false));
   return this->ComputeColumn(arr4D,0);
 }
@@ -41,6 +41,13 @@ class Column {
   ///////////////////////////////////////////////////////////////////////////////////
   void ComputeColumn(IdefixArray3D<real> in);
 
+  ///////////////////////////////////////////////////////////////////////////////////
+  /// @brief Set the precision of the ghost zones exchanged between MPI processes
+  /// @param precision: HaloPrecision::Float or ScaledFloat halve the MPI volume in
+  ///                   double precision, at the cost of rounding the ghost zones
+  ///////////////////////////////////////////////////////////////////////////////////
+  void SetHaloPrecision(HaloPrecision precision);
+
   ///////////////////////////////////////////////////////////////////////////////////
   /// @brief Get a reference to the computed column density array
   ///////////////////////////////////////////////////////////////////////////////////
@@ -28,7 +28,7 @@ class IterativeSolver {
   void TestErrorL1();  // Test the convergence status of the current iteration with L1 norm
   void TestErrorL2();  // Test the convergence status of the current iteration with L2 norm
   void TestErrorLINF();  // Test the convergence status of the current iteration with LINF norm
-  real ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray3D<real> mat2);
+  realc ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray3D<real> mat2);
 
  protected:
   T & linearOperator;
@@ -97,7 +97,7 @@ void IterativeSolver<T>::TestErrorL1() {
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &normL1Vector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &normL1Vector.v, 2, realcMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   // Squared error
@@ -155,7 +155,7 @@ void IterativeSolver<T>::TestErrorL2() {
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &normL2Vector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &normL2Vector.v, 2, realcMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   // Squared error
@@ -196,32 +196,32 @@ void IterativeSolver<T>::TestErrorLINF() {
   kbeg = this->beg[KDIR];
   kend = this->end[KDIR];
 
-  real maxRes2, rho2;
+  realc maxRes2, rho2;
 
   // Searching for the maximum residual over the grid
   idefix_reduce("MaxRes2",
                 kbeg, kend,
                 jbeg, jend,
                 ibeg, iend,
-                KOKKOS_LAMBDA (int k, int j, int i, real &localMax) {
+                KOKKOS_LAMBDA (int k, int j, int i, realc &localMax) {
                   localMax = std::fmax(res(k,j,i) * res(k,j,i), localMax);
                 },
-                Kokkos::Max<real>(maxRes2));
+                Kokkos::Max<realc>(maxRes2));
 
   // Sum of squared rhs over the grid
   idefix_reduce("SumDensity2",
                 kbeg, kend,
                 jbeg, jend,
                 ibeg, iend,
-                KOKKOS_LAMBDA (int k, int j, int i, real &localSum) {
+                KOKKOS_LAMBDA (int k, int j, int i, realc &localSum) {
                   localSum += rhs(k,j,i) * rhs(k,j,i);
                 },
-                Kokkos::Sum<real>(rho2));
+                Kokkos::Sum<realc>(rho2));
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &maxRes2, 1, realMPI, MPI_MAX, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, &rho2, 1, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &maxRes2, 1, realcMPI, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &rho2, 1, realcMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   // Squared error
@@ -275,7 +275,7 @@ void IterativeSolver<T>::SetRes() {
 }
 
 template <class T>
-real IterativeSolver<T>::ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray3D<real> mat2) {
+realc IterativeSolver<T>::ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray3D<real> mat2) {
   idfx::pushRegion("IterativeSolver::ComputeDotProduct");
 
   int ibeg, iend, jbeg, jend, kbeg, kend;
@@ -286,20 +286,20 @@ real IterativeSolver<T>::ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray
   kbeg = this->beg[KDIR];
   kend = this->end[KDIR];
 
-  real sum;
+  realc sum;
 
   idefix_reduce("DotProduct",
                 kbeg, kend,
                 jbeg, jend,
                 ibeg, iend,
-                KOKKOS_LAMBDA (int k, int j, int i, real &localSum) {
+                KOKKOS_LAMBDA (int k, int j, int i, realc &localSum) {
                   localSum += mat1(k,j,i) * mat2(k,j,i);
                 },
-                Kokkos::Sum<real>(sum));
+                Kokkos::Sum<realc>(sum));
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, realcMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   idfx::popRegion();
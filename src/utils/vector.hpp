@@ -30,8 +30,8 @@ struct Vector {
     }
 };
 
-// Shortcut for what follows: a vector of 2 reals
-typedef Vector<real,2> MyVector;
+// Shortcut for what follows: a vector of 2 reals, accumulated in compute precision
+typedef Vector<realc,2> MyVector;
 
 // Define the reduction operator in Kokkos space
 namespace Kokkos {
@@ -3,6 +3,11 @@
 
 #define  FILENAME    "timevol.dat"
 
+// Optional species at the floor density, except in a slab advected at constant velocity
+// (without drag), used to test the active region masks of the dust
+int floorSpeciesGlob;
+real floorDensityGlob;
+
 void MyDrag(DataBlock *data, int n, real beta, IdefixArray3D<real> &gamma) {
   // Compute the drag coefficient gamma from the input beta
   auto VcGas = data->hydro->Vc;
@@ -50,6 +55,9 @@ void UserdefBoundaryDust(Fluid<DustPhysics> *dust, int dir, BoundarySide side, r
 // Arrays or variables which are used later on
 Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
 
+  floorSpeciesGlob = input.GetOrSet<int>("Setup","floorSpecies",0,-1);
+  floorDensityGlob = input.GetOrSet<real>("Setup","floorDensity",0,1e-10);
+
   data.hydro->EnrollUserDefBoundary(&UserdefBoundary);
   if(data.haveDust) {
     int nSpecies = data.dust.size();
@@ -80,8 +88,13 @@ void Setup::InitFlow(DataBlock &data) {
                 d.Vc(VX1,k,j,i) = (x < x0) ? 2.0 : 0.125;
 
                 for(int n = 0 ; n < data.dust.size(); n++) {
-                  d.dustVc[n](RHO,k,j,i) = (x < x0) ? 1.0 : 16.0;
-                  d.dustVc[n](VX1,k,j,i) = (x < x0) ? 2.0 : 0.125;
+                  if(n == floorSpeciesGlob) {
+                    d.dustVc[n](RHO,k,j,i) = (x > 5.0 && x < 15.0) ? 1.0 : floorDensityGlob;
+                    d.dustVc[n](VX1,k,j,i) = 0.05;
+                  } else {
+                    d.dustVc[n](RHO,k,j,i) = (x < x0) ? 1.0 : 16.0;
+                    d.dustVc[n](VX1,k,j,i) = (x < x0) ? 2.0 : 0.125;
+                  }
                 }
 
 
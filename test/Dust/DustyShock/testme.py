@@ -5,6 +5,7 @@
 @author: glesur
 """
 import os
+import shutil
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
@@ -15,15 +16,30 @@ name="dump.0001.dmp"
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-implicit.ini"]
+  # (input file, reference input file): the batched and masked runs should reproduce the
+  # runs they derive from, on their common fields
+  inifiles=[("idefix.ini","idefix.ini"),
+            ("idefix-implicit.ini","idefix-implicit.ini"),
+            ("idefix-batched.ini","idefix.ini"),                   # species-batched dust
+            ("idefix-batched-implicit.ini","idefix-implicit.ini"), # single-pass implicit drag
+            ("idefix-floor.ini","idefix.ini"),     # additional species at the floor density
+            ("idefix-mask.ini","idefix.ini")]      # active regions of the dust species
 
   # loop on all the ini files for this test
-  for ini in inifiles:
+  for ini,ref in inifiles:
     test.run(inputFile=ini)
-    if test.init:
+    if test.init and ini==ref:
       test.makeReference(filename=name)
     test.standardTest()
+    #force override the inputfile since the result should be identical
+    test.inifile=ref
     test.nonRegressionTest(filename=name,tolerance=1e-14)
+    if ini=="idefix-floor.ini":
+      shutil.copy(name,"dump.floor.dmp")
+
+  # the masked floor species should match its unmasked evolution, its inactive tiles
+  # staying at the floor density
+  test.compareDump("dump.floor.dmp",name,tolerance=1e-12)
 
 
 test=tst.idfxTest()
@@ -0,0 +1,5 @@
+#define     COMPONENTS      2
+#define     DIMENSIONS      2
+
+
+#define     GEOMETRY        CARTESIAN
@@ -0,0 +1,58 @@
+#include "idefix.hpp"
+#include "setup.hpp"
+
+
+static real advSpeed;
+
+// Coarsening in X1, increasing towards the middle of the box in X2
+void CoarsenFunction(DataBlock &data) {
+  IdefixArray2D<int> coarseningLevel = data.coarseningLevel[IDIR];
+  IdefixArray1D<real> y = data.x[JDIR];
+  idefix_for("set_coarsening", 0, coarseningLevel.extent(0), 0, coarseningLevel.extent(1),
+      KOKKOS_LAMBDA(int k,int j) {
+        coarseningLevel(k,j) = 1 + static_cast<int>(6*(0.5-fabs(y(j))));
+        });
+}
+
+
+// Initialisation routine. Can be used to allocate
+// Arrays or variables which are used later on
+Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
+  advSpeed = input.Get<real>("Setup","advectionSpeed",0);
+  if(data.haveGridCoarsening) {
+    data.EnrollGridCoarseningLevels(&CoarsenFunction);
+  }
+}
+
+// This routine initialize the flow
+// Note that data is on the device.
+// One can therefore define locally
+// a datahost and sync it, if needed
+void Setup::InitFlow(DataBlock &data) {
+    // Create a host copy
+    DataBlockHost d(data);
+
+    for(int k = 0; k < d.np_tot[KDIR] ; k++) {
+      for(int j = 0; j < d.np_tot[JDIR] ; j++) {
+        for(int i = 0; i < d.np_tot[IDIR] ; i++) {
+          real x=d.x[IDIR](i);
+          real y=d.x[JDIR](j);
+
+          // Density slab advected in X1, with a pressure bump which launches sound waves
+          d.Vc(RHO,k,j,i) = fabs(x) < 0.2 ? 2.0 : 1.0;
+          d.Vc(VX1,k,j,i) = advSpeed;
+          d.Vc(VX2,k,j,i) = 0.0;
+          d.Vc(PRS,k,j,i) = 1.0 + 0.1*exp(-(x*x+y*y)/0.01);
+
+          for(int n = 0 ; n < data.dust.size(); n++) {
+            d.dustVc[n](RHO,k,j,i) = d.Vc(RHO,k,j,i);
+            d.dustVc[n](VX1,k,j,i) = advSpeed;
+            d.dustVc[n](VX2,k,j,i) = 0.0;
+          }
+        }
+      }
+    }
+
+    // Send it all, if needed
+    d.SyncToDevice();
+}
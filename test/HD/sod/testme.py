@@ -21,11 +21,29 @@ def testMe(test):
 
   # loop on all the ini files for this test
   for ini in inifiles:
+    mytol=0
     test.run(inputFile=ini)
     if test.init:
       test.makeReference(filename=name)
     test.standardTest()
-    test.nonRegressionTest(filename=name)
+    # mixed precision is compared to the double precision reference
+    if test.mixed:
+      mytol=1e-5
+    # the branch-free fluxes are the same, up to the contraction of the operations
+    if test.branchless:
+      mytol=max(mytol,1e-14)
+    test.nonRegressionTest(filename=name,tolerance=mytol)
+
+  # SSP integrator with twice the CFL, only checked against the analytical solution
+  test.run(inputFile="idefix-ssprk43.ini")
+  test.standardTest()
+
+  # 10 stages low-storage SSP integrator with 6 times the CFL
+  test.run(inputFile="idefix-ssprk104.ini")
+  if test.init:
+    test.makeReference(filename=name)
+  test.standardTest()
+  test.nonRegressionTest(filename=name,tolerance=mytol)
 
 
 test=tst.idfxTest()
@@ -40,11 +58,23 @@ else:
   for rec in range(2,5):
     test.vectPot=False
     test.single=False
+    test.mixed=False
     test.reconstruction=rec
     test.mpi=False
     testMe(test)
 
+  # branch-free flux selection in the HLL-type solvers, against the same references
+  test.reconstruction=2
+  test.branchless=True
+  testMe(test)
+  test.branchless=False
+
   # test in single precision
   test.reconstruction=2
   test.single=True
   testMe(test)
+
+  # test in mixed precision (single storage, double arithmetic)
+  test.single=False
+  test.mixed=True
+  testMe(test)
@@ -22,6 +22,10 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename="dump.0001.dmp")
 
+  # implicit integration is only checked against the analytical decay rate
+  test.run(inputFile="idefix-implicit.ini")
+  test.standardTest()
+
 
 test=tst.idfxTest()
 
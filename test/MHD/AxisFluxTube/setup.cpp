@@ -107,6 +107,28 @@ void CoarsenFunction(DataBlock &data) {
       });
 }
 
+// The smallest cells are the azimuthal cells along the axis at r=1, so the coarsening target
+// gain coarsens the X3 direction along the axis at small radii, but not near the equator
+void CheckAutoCoarsening(DataBlock &data) {
+  IdefixArray2D<int>::HostMirror level = Kokkos::create_mirror_view(data.coarseningLevel[KDIR]);
+  Kokkos::deep_copy(level, data.coarseningLevel[KDIR]);
+  IdefixArray1D<real>::HostMirror r = Kokkos::create_mirror_view(data.x[IDIR]);
+  Kokkos::deep_copy(r, data.x[IDIR]);
+  IdefixArray1D<real>::HostMirror th = Kokkos::create_mirror_view(data.x[JDIR]);
+  Kokkos::deep_copy(th, data.x[JDIR]);
+
+  for(int j = data.beg[JDIR] ; j < data.end[JDIR] ; j++) {
+    for(int i = data.beg[IDIR] ; i < data.end[IDIR] ; i++) {
+      if(sin(th(j)) < 0.1 && r(i) < 2.0 && level(j,i) < 2) {
+        IDEFIX_ERROR("Automatic grid coarsening did not coarsen the axis");
+      }
+      if(sin(th(j)) > 0.5 && level(j,i) != 1) {
+        IDEFIX_ERROR("Automatic grid coarsening coarsened the equatorial region");
+      }
+    }
+  }
+}
+
 // Initialisation routine. Can be used to allocate
 // Arrays or variables which are used later on
 Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
@@ -117,7 +139,10 @@ Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
   Ztorus = input.Get<real>("Setup","Ztorus",0);
   Rin = input.Get<real>("Setup","Rin",0);
 
-  if(data.haveGridCoarsening) {
+  if(data.haveGridCoarsening == GridCoarsening::automatic) {
+    // Levels have been derived from the grid metrics, check them
+    CheckAutoCoarsening(data);
+  } else if(data.haveGridCoarsening) {
     data.EnrollGridCoarseningLevels(&CoarsenFunction);
   }
 }
@@ -26,6 +26,14 @@ def testMe(test):
       test.makeReference(filename=name)
     test.nonRegressionTest(filename=name,tolerance=tolerance)
 
+  # Coarsening levels derived from the grid metrics, checked against the geometry by the setup
+  test.run(inputFile="idefix-autocoarsening.ini")
+  with open('./idefix.0.log','r') as file:
+    log = file.read()
+  assert "automatic grid coarsening with maximum level" in log, "Automatic coarsening not enabled"
+  assert "will be ignored" not in log, "A coarsening function was enrolled in automatic mode"
+  test.standardTest()
+
 
 test=tst.idfxTest()
 
@@ -25,6 +25,10 @@ def testMe(test):
       test.makeReference(filename=name)
     test.nonRegressionTest(filename=name,tolerance=tolerance)
 
+  # Sub-cycled Hall: only check the whistler frequency
+  test.run(inputFile="idefix-subcycle.ini")
+  test.standardTest()
+
 
 test=tst.idfxTest()
 
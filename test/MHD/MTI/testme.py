@@ -41,3 +41,18 @@ else:
   test.reconstruction=2
   test.mpi=False
   testMe(test)
+
+  # Automatic domain decomposition of a box that is only periodic in X1: a periodic
+  # direction has as many interfaces as procs, so cutting X2 exchanges fewer ghost cells
+  test.mpi=True
+  test.configure()
+  test.compile()
+  test.run(inputFile="idefix.ini", np=2)
+  test.checkDecomposition([1,2])
+  test.nonRegressionTest(filename="dump.0001.dmp")
+
+  # Reduced precision MPI halos in the first RKL stages, against the full precision reference
+  for ini in ["idefix-rkl-float.ini","idefix-rkl-scaledfloat.ini"]:
+    test.run(inputFile=ini, np=2)
+    test.inifile="idefix-rkl.ini"
+    test.nonRegressionTest(filename="dump.0001.dmp",tolerance=1e-6)
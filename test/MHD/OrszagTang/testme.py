@@ -27,7 +27,7 @@ def testMe(test):
     if test.init and not test.mpi:
       test.makeReference(filename="dump.0001.dmp")
 
-    if(test.single):
+    if(test.single or test.mixed):
       mytol=1e-5
 
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
@@ -47,6 +47,7 @@ else:
     test.noplot = True
     test.vectPot = False
     test.single=False
+    test.mixed=False
     test.reconstruction=rec
     test.mpi=False
     testMe(test)
@@ -59,8 +60,36 @@ else:
   test.single=True
   testMe(test)
 
+  # mixed precision validation, against the double precision references
+  # (PPM included, since its EMF reconstruction has its own mixed precision path)
+  test.single=False
+  test.mixed=True
+  for rec in [2,4]:
+    test.reconstruction=rec
+    testMe(test)
+  test.reconstruction=2
+
+  # branch-free flux selection in the HLL-type solvers, against the same references
+  test.single=False
+  test.mixed=False
+  test.mpi=False
+  test.vectPot=False
+  test.branchless=True
+  testMe(test)
+  test.branchless=False
+
+  # loop patterns chosen at runtime by the autotuner, which should not change the results
+  test.single=False
+  test.mixed=False
+  test.mpi=False
+  test.vectPot=False
+  test.autotune=True
+  testMe(test)
+  test.autotune=False
+
   # Vector potential validation
   test.single=False
+  test.mixed=False
   test.mpi=False
   test.vectPot=True
   testMe(test)
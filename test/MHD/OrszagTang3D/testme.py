@@ -33,6 +33,28 @@ def testMe(test):
   test.inifile="idefix.ini"
   test.nonRegressionTest(filename="dump.0002.dmp",tolerance=tol)
 
+  if test.mpi:
+    # MPI variants, which should reproduce the reference
+    inifiles=["idefix-weighted.ini"]  # subdomains sized by a cost profile
+    if not (test.cuda or test.hip):
+      inifiles.append("idefix-datatype.ini")  # in place exchanges with derived datatypes
+      inifiles.append("idefix-shared.ini")    # on-node halos read from shared memory
+    for ini in inifiles:
+      test.run(ini)
+      if ini == "idefix-weighted.ini" and test.dec==["2","2","2"]:
+        # the cost profile varies along X1 and X2 only
+        test.checkWeightedDecomposition([0,1])
+      test.inifile="idefix.ini"
+      test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
+    # Node-aware placement, with nodes of 4 ranks emulated on a single host. With 16x32x16
+    # subdomains, each node should hold full X1 and X3 rows, so that only X2 exchanges leave it
+    if test.dec==["2","2","2"]:
+      test.run("idefix-node.ini", env={"IDEFIX_RANKS_PER_NODE": "4"})
+      test.checkPlacement([2,1,2])
+      test.inifile="idefix.ini"
+      test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
 
 test=tst.idfxTest()
 
@@ -54,6 +76,11 @@ else:
   test.mpi=True
   testMe(test)
 
+  # test with the variables innermost in the 4D arrays (layout of the MPI halos)
+  test.variablesInnermost=True
+  testMe(test)
+  test.variablesInnermost=False
+
 
   # test with vector potential
   test.mpi=False
@@ -140,6 +140,16 @@ Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
   columnX2Right = new Column(JDIR, -1, &data);
   columnX3Left = new Column(KDIR, 1, &data);
   columnX3Right = new Column(KDIR, -1, &data);
+
+  // Optional reduced precision of the MPI halos of the columns
+  if(input.CheckEntry("Setup","haloPrecision") >= 0) {
+    HaloPrecision precision = idfx::ParseHaloPrecision(
+                                input.Get<std::string>("Setup","haloPrecision",0), "Setup");
+    for(Column *column : {columnX1Left, columnX1Right, columnX2Left, columnX2Right,
+                          columnX3Left, columnX3Right}) {
+      column->SetHaloPrecision(precision);
+    }
+  }
   // Initialise the output file
 }
 
@@ -21,3 +21,11 @@ test.configure()
 test.compile()
 # this test succeeds if it runs successfully
 test.run()
+# with reduced precision MPI halos
+test.run(inputFile="idefix-halofloat.ini")
+
+# the column is exchanged through a 4D alias, which keeps the default layout
+test.variablesInnermost = True
+test.configure()
+test.compile()
+test.run()